@@ -0,0 +1,445 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <vector>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    #include <malloc.h>
+    #define MEMARENA_HAS_MALLINFO2
+#endif
+
+#include <Memarena/Memarena.hpp>
+
+using namespace Memarena;
+using namespace Memarena::SizeLiterals;
+
+/**
+ * Simulates hours of server churn in compressed time, one tick per simulated second. Every tick a number of requests arrive, every
+ * request allocates objects of mixed sizes, most of which die with the request while the rest live for a heavy-tailed number of ticks,
+ * like cache entries and sessions. Every 15 simulated minutes a spike multiplies the requests for half a minute.
+ *
+ * The workload is the same for every allocator, and at the end of every simulated hour the benchmark samples the live bytes, the memory
+ * the allocator holds and the allocation rate of that hour. The counters compare the last hour to the first one:
+ *   footprint_drift   the memory held at the end of the last hour over the memory held at the end of the first hour
+ *   fragmentation     the share of the memory held at the end that isn't live
+ *   throughput_drift  the allocations per second of the last hour over the ones of the first hour
+ *
+ * The footprint of the Mallocator is the memory malloc holds beyond the bytes the rest of the process had in use when the backend was
+ * created, measured with mallinfo2. Without mallinfo2, or if it doesn't exceed that baseline, the footprint counters are left out. The
+ * argument is the number of simulated hours.
+ */
+
+namespace
+{
+
+constexpr Size ticksPerHour      = 3600;
+constexpr Size requestsPerTick   = 20;
+constexpr Size objectsPerRequest = 8;
+constexpr Size spikePeriod       = 900;
+constexpr Size spikeLength       = 30;
+constexpr Size spikeFactor       = 5;
+constexpr Size maxLifetime       = 3600; // Caps the heavy tail, so an object outlives at most an hour
+
+constexpr double longLivedFraction = 0.1;
+constexpr double paretoScale       = 10.0; // Ticks
+constexpr double paretoShape       = 1.1;  // Heavy tailed, the variance is infinite below 2
+
+constexpr std::array<Size, 8>   sizeClasses = {16, 32, 64, 128, 256, 512, 1024, 4096};
+constexpr std::array<double, 8> sizeWeights = {20, 25, 20, 15, 10, 5, 4, 1};
+
+struct LiveObject
+{
+    void*  ptr;
+    UInt32 sizeClass;
+    UInt32 arena; // Only used by the arena per request
+};
+
+struct Workload
+{
+    std::mt19937_64                        randomEngine{42};
+    std::discrete_distribution<UInt32>     sizeDistribution{sizeWeights.begin(), sizeWeights.end()};
+    std::uniform_real_distribution<double> uniformDistribution{0.0, 1.0};
+
+    [[nodiscard]] UInt32 DrawSizeClass() { return sizeDistribution(randomEngine); }
+
+    // 0 for an object that dies with its request
+    [[nodiscard]] Size DrawLifetime()
+    {
+        if (uniformDistribution(randomEngine) >= longLivedFraction)
+        {
+            return 0;
+        }
+
+        const double uniform = 1.0 - uniformDistribution(randomEngine);
+        return std::min(static_cast<Size>(paretoScale / std::pow(uniform, 1.0 / paretoShape)), maxLifetime);
+    }
+
+    [[nodiscard]] static Size GetRequestCount(const Size tick)
+    {
+        return tick % spikePeriod < spikeLength ? requestsPerTick * spikeFactor : requestsPerTick;
+    }
+};
+
+#ifdef MEMARENA_HAS_MALLINFO2
+// The bytes malloc holds for the whole process, which is what the Mallocator and the std::pmr upstream draw from
+Size GetMallocFootprint()
+{
+    const struct mallinfo2 info = mallinfo2();
+    return info.arena + info.hblkhd;
+}
+
+// The bytes of the process that are in use. The free heap left by the earlier benchmarks isn't included, since it is reused and
+// `malloc_trim` doesn't shrink the arena, so a baseline that included it would hide the growth of the Mallocator
+Size GetMallocInUseSize()
+{
+    malloc_trim(0);
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+#endif
+
+class MallocatorBackend
+{
+  public:
+    static constexpr MallocatorSettings settings = {.policy = MallocatorPolicy::Release | MallocatorPolicy::Headerless};
+
+#ifdef MEMARENA_HAS_MALLINFO2
+    MallocatorBackend() : m_InitialInUseSize(GetMallocInUseSize()) {}
+#endif
+
+    [[nodiscard]] void* Allocate(const UInt32 sizeClass, UInt32& /*arena*/) { return m_Mallocator.Allocate(sizeClasses[sizeClass]); }
+    void                Deallocate(LiveObject& object) { m_Mallocator.Deallocate(object.ptr, sizeClasses[object.sizeClass]); }
+    void                EndRequest() {}
+    void                EndHour() {}
+
+    // Other allocations of the process are included, they are few and don't change between the hours
+    [[nodiscard]] std::optional<Size> GetFootprint() const
+    {
+#ifdef MEMARENA_HAS_MALLINFO2
+        const Size footprint = GetMallocFootprint();
+        if (footprint > m_InitialInUseSize)
+        {
+            return footprint - m_InitialInUseSize;
+        }
+#endif
+        return std::nullopt;
+    }
+
+  private:
+    Mallocator<settings> m_Mallocator;
+#ifdef MEMARENA_HAS_MALLINFO2
+    Size m_InitialInUseSize;
+#endif
+};
+
+// Counts the bytes the pool resource holds from its upstream
+class CountingResource : public std::pmr::memory_resource
+{
+  public:
+    [[nodiscard]] Size GetSize() const { return m_Size; }
+
+  private:
+    void* do_allocate(const Size bytes, const Size alignment) override
+    {
+        m_Size += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, const Size bytes, const Size alignment) override
+    {
+        m_Size -= bytes;
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    Size m_Size = 0;
+};
+
+class PmrPoolBackend
+{
+  public:
+    [[nodiscard]] void* Allocate(const UInt32 sizeClass, UInt32& /*arena*/) { return m_PoolResource.allocate(sizeClasses[sizeClass]); }
+    void                Deallocate(LiveObject& object) { m_PoolResource.deallocate(object.ptr, sizeClasses[object.sizeClass]); }
+    void                EndRequest() {}
+    void                EndHour() {}
+
+    [[nodiscard]] Size GetFootprint() const { return m_UpstreamResource.GetSize(); }
+
+  private:
+    CountingResource                       m_UpstreamResource;
+    std::pmr::unsynchronized_pool_resource m_PoolResource{&m_UpstreamResource};
+};
+
+// A growable pool per size class. With block local free lists, empty blocks are returned at the end of every simulated hour
+template <bool ReleasesEmptyBlocks>
+class PoolAllocatorBackend
+{
+  public:
+    static constexpr PoolAllocatorSettings settings = {
+        .policy = PoolAllocatorPolicy::Release | PoolAllocatorPolicy::Growable | PoolAllocatorPolicy::SizeTracking |
+                  (ReleasesEmptyBlocks ? PoolAllocatorPolicy::BlockLocalFreeLists : PoolAllocatorPolicy::Empty)};
+
+    PoolAllocatorBackend()
+    {
+        for (const Size objectSize : sizeClasses)
+        {
+            m_Pools.push_back(std::make_unique<PoolAllocator<settings>>(objectSize, std::max<Size>(64_KiB / objectSize, 16)));
+        }
+    }
+
+    [[nodiscard]] void* Allocate(const UInt32 sizeClass, UInt32& /*arena*/) { return m_Pools[sizeClass]->Allocate(); }
+    void                Deallocate(LiveObject& object) { m_Pools[object.sizeClass]->Deallocate(object.ptr); }
+    void                EndRequest() {}
+
+    void EndHour()
+    {
+        if constexpr (ReleasesEmptyBlocks)
+        {
+            for (const auto& pool : m_Pools)
+            {
+                pool->ReleaseEmptyBlocks();
+            }
+        }
+    }
+
+    [[nodiscard]] Size GetFootprint() const
+    {
+        Size footprint = 0;
+        for (const auto& pool : m_Pools)
+        {
+            footprint += pool->GetTotalSize();
+        }
+        return footprint;
+    }
+
+  private:
+    std::vector<std::unique_ptr<PoolAllocator<settings>>> m_Pools;
+};
+
+// A growable LinearAllocator per request. An arena can only be destroyed once its last object died, so the long-lived objects keep
+// the whole arena of their request alive
+class LinearAllocatorPerRequestBackend
+{
+  public:
+    static constexpr LinearAllocatorSettings settings = {
+        .policy = LinearAllocatorPolicy::Release | LinearAllocatorPolicy::Growable | LinearAllocatorPolicy::SizeTracking};
+
+    [[nodiscard]] void* Allocate(const UInt32 sizeClass, UInt32& arena)
+    {
+        if (m_CurrentArena == NoArena)
+        {
+            m_CurrentArena = AcquireArenaSlot();
+        }
+
+        Arena& currentArena = m_Arenas[m_CurrentArena];
+        currentArena.liveCount++;
+        arena = m_CurrentArena;
+        return currentArena.allocator->Allocate(sizeClasses[sizeClass]);
+    }
+
+    void Deallocate(LiveObject& object)
+    {
+        Arena& arena = m_Arenas[object.arena];
+        if (--arena.liveCount == 0 && object.arena != m_CurrentArena)
+        {
+            DestroyArena(object.arena);
+        }
+    }
+
+    void EndRequest()
+    {
+        if (m_CurrentArena != NoArena && m_Arenas[m_CurrentArena].liveCount == 0)
+        {
+            DestroyArena(m_CurrentArena);
+        }
+        m_CurrentArena = NoArena;
+    }
+
+    void EndHour() {}
+
+    [[nodiscard]] Size GetFootprint() const
+    {
+        Size footprint = 0;
+        for (const Arena& arena : m_Arenas)
+        {
+            footprint += arena.allocator != nullptr ? arena.allocator->GetTotalSize() : 0;
+        }
+        return footprint;
+    }
+
+  private:
+    static constexpr UInt32 NoArena = std::numeric_limits<UInt32>::max();
+
+    struct Arena
+    {
+        std::unique_ptr<LinearAllocator<settings>> allocator;
+        Size                                       liveCount = 0;
+    };
+
+    UInt32 AcquireArenaSlot()
+    {
+        UInt32 slot = 0;
+        if (m_FreeSlots.empty())
+        {
+            slot = static_cast<UInt32>(m_Arenas.size());
+            m_Arenas.emplace_back();
+        }
+        else
+        {
+            slot = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+
+        m_Arenas[slot].allocator = std::make_unique<LinearAllocator<settings>>(4_KiB, "Request");
+        return slot;
+    }
+
+    void DestroyArena(const UInt32 slot)
+    {
+        m_Arenas[slot].allocator.reset();
+        m_FreeSlots.push_back(slot);
+    }
+
+    std::vector<Arena>  m_Arenas;
+    std::vector<UInt32> m_FreeSlots;
+    UInt32              m_CurrentArena = NoArena;
+};
+
+struct HourSample
+{
+    Size                liveSize;
+    std::optional<Size> footprint; // The other backends count the memory they hold themselves, so only the Mallocator can lack it
+    double              allocationsPerSecond;
+};
+
+template <typename Backend>
+std::vector<HourSample> Simulate(Backend& backend, const Size hours)
+{
+    using Clock = std::chrono::steady_clock;
+
+    Workload                             workload;
+    std::vector<std::vector<LiveObject>> expiries(maxLifetime + 1); // A timing wheel indexed by the tick an object dies
+    std::vector<LiveObject>              requestObjects;
+    std::vector<HourSample>              samples;
+
+    Size liveSize        = 0;
+    Size allocationCount = 0;
+
+    Clock::time_point hourStart = Clock::now();
+    for (Size tick = 0; tick < hours * ticksPerHour; tick++)
+    {
+        std::vector<LiveObject>& expiredObjects = expiries[tick % expiries.size()];
+        for (LiveObject& object : expiredObjects)
+        {
+            liveSize -= sizeClasses[object.sizeClass];
+            backend.Deallocate(object);
+        }
+        expiredObjects.clear();
+
+        for (Size request = 0; request < Workload::GetRequestCount(tick); request++)
+        {
+            for (Size i = 0; i < objectsPerRequest; i++)
+            {
+                LiveObject object{.ptr = nullptr, .sizeClass = workload.DrawSizeClass(), .arena = 0};
+                object.ptr = backend.Allocate(object.sizeClass, object.arena);
+
+                // Touch the object like the code that uses it would
+                std::memset(object.ptr, static_cast<int>(i), std::min<Size>(sizeClasses[object.sizeClass], 64));
+                liveSize += sizeClasses[object.sizeClass];
+                allocationCount++;
+
+                const Size lifetime = workload.DrawLifetime();
+                if (lifetime == 0)
+                {
+                    requestObjects.push_back(object);
+                }
+                else
+                {
+                    expiries[(tick + lifetime) % expiries.size()].push_back(object);
+                }
+            }
+
+            for (LiveObject& object : requestObjects)
+            {
+                liveSize -= sizeClasses[object.sizeClass];
+                backend.Deallocate(object);
+            }
+            requestObjects.clear();
+            backend.EndRequest();
+        }
+
+        if ((tick + 1) % ticksPerHour == 0)
+        {
+            backend.EndHour();
+
+            const Clock::time_point now     = Clock::now();
+            const double            seconds = std::chrono::duration<double>(now - hourStart).count();
+            samples.push_back(HourSample{.liveSize             = liveSize,
+                                         .footprint            = backend.GetFootprint(),
+                                         .allocationsPerSecond = static_cast<double>(allocationCount) / seconds});
+
+            allocationCount = 0;
+            hourStart       = Clock::now();
+        }
+    }
+
+    // Free what is still alive, so the next backend starts from the same heap
+    for (std::vector<LiveObject>& objects : expiries)
+    {
+        for (LiveObject& object : objects)
+        {
+            backend.Deallocate(object);
+        }
+    }
+
+    return samples;
+}
+
+template <typename Backend>
+void Aging(benchmark::State& state)
+{
+    const Size hours = static_cast<Size>(state.range(0));
+
+    std::vector<HourSample> samples;
+    for (auto _ : state)
+    {
+        Backend backend;
+        samples = Simulate(backend, hours);
+    }
+
+    const HourSample& first = samples.front();
+    const HourSample& last  = samples.back();
+
+    state.counters["live_MiB"]         = static_cast<double>(last.liveSize) / 1_MiB;
+    state.counters["throughput_drift"] = last.allocationsPerSecond / first.allocationsPerSecond;
+    state.counters["allocs_per_s"]     = last.allocationsPerSecond;
+
+    // A footprint of 0 would read as a perfect result, so the counters are left out when it can't be measured
+    if (first.footprint.has_value() && last.footprint.has_value())
+    {
+        state.counters["footprint_MiB"]   = static_cast<double>(*last.footprint) / 1_MiB;
+        state.counters["footprint_drift"] = static_cast<double>(*last.footprint) / static_cast<double>(*first.footprint);
+        state.counters["fragmentation"]   = 1.0 - static_cast<double>(last.liveSize) / static_cast<double>(*last.footprint);
+    }
+    else
+    {
+        state.SetLabel("footprint unavailable");
+    }
+}
+} // namespace
+
+BENCHMARK_TEMPLATE(Aging, MallocatorBackend)->Arg(6)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Aging, PmrPoolBackend)->Arg(6)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Aging, PoolAllocatorBackend<false>)->Arg(6)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Aging, PoolAllocatorBackend<true>)->Arg(6)->Iterations(1)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(Aging, LinearAllocatorPerRequestBackend)->Arg(6)->Iterations(1)->Unit(benchmark::kMillisecond);
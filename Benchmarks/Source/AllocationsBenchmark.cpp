@@ -126,6 +126,58 @@ static void LinearAllocatorNewReleaseRawMultithreaded(benchmark::State& state)
 
 BENCHMARK(LinearAllocatorNewReleaseRawMultithreaded);
 
+constexpr Size bumpAllocationCount = 1024;
+constexpr Size bumpAllocationSize  = 24;
+
+constexpr LinearAllocatorSettings linearBumpUpSettings   = {.policy = LinearAllocatorPolicy::Release};
+constexpr LinearAllocatorSettings linearBumpDownSettings = {.policy = LinearAllocatorPolicy::Release | LinearAllocatorPolicy::BumpDown};
+
+// Allocates odd sizes at the alignment given by the range, so that every allocation needs padding
+template <LinearAllocatorSettings Settings>
+static void LinearAllocatorBump(benchmark::State& state)
+{
+    const Alignment           alignment = static_cast<Size>(state.range(0));
+    LinearAllocator<Settings> linearAllocator{bumpAllocationCount * (bumpAllocationSize + 8 + state.range(0))};
+
+    for (auto _ : state)
+    {
+        for (Size i = 0; i < bumpAllocationCount; i++)
+        {
+            benchmark::DoNotOptimize(linearAllocator.Allocate(bumpAllocationSize + (i & 7), alignment));
+        }
+        linearAllocator.Release();
+    }
+
+    state.SetItemsProcessed(static_cast<Int64>(state.iterations() * bumpAllocationCount));
+}
+
+BENCHMARK_TEMPLATE(LinearAllocatorBump, linearBumpUpSettings)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK_TEMPLATE(LinearAllocatorBump, linearBumpDownSettings)->RangeMultiplier(2)->Range(1, 64);
+
+constexpr StackAllocatorSettings stackBumpUpSettings   = {.policy = StackAllocatorPolicy::Release};
+constexpr StackAllocatorSettings stackBumpDownSettings = {.policy = StackAllocatorPolicy::Release | StackAllocatorPolicy::BumpDown};
+
+template <StackAllocatorSettings Settings>
+static void StackAllocatorBump(benchmark::State& state)
+{
+    const Alignment          alignment = static_cast<Size>(state.range(0));
+    StackAllocator<Settings> stackAllocator{bumpAllocationCount * (bumpAllocationSize + 16 + 2 * state.range(0))};
+
+    for (auto _ : state)
+    {
+        for (Size i = 0; i < bumpAllocationCount; i++)
+        {
+            benchmark::DoNotOptimize(stackAllocator.Allocate(bumpAllocationSize + (i & 7), alignment));
+        }
+        stackAllocator.Release();
+    }
+
+    state.SetItemsProcessed(static_cast<Int64>(state.iterations() * bumpAllocationCount));
+}
+
+BENCHMARK_TEMPLATE(StackAllocatorBump, stackBumpUpSettings)->RangeMultiplier(2)->Range(1, 64);
+BENCHMARK_TEMPLATE(StackAllocatorBump, stackBumpDownSettings)->RangeMultiplier(2)->Range(1, 64);
+
 static void MallocatorNewDelete(benchmark::State& state)
 {
     Mallocator mallocator{};
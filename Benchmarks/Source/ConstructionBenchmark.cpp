@@ -0,0 +1,266 @@
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+#include "MemoryTestObjects.hpp"
+
+using namespace Memarena;
+using namespace Memarena::SizeLiterals;
+
+/**
+ * Construct and destroy an allocator per iteration, the pattern of short-lived per-request arenas. Every allocator derived from
+ * `Allocator` allocates its `AllocatorData` and registers it with the MemoryTracker under a global mutex, and unregistering searches the
+ * list of registered allocators, so the cost also depends on how many allocators are alive. The composite allocators pay this once per
+ * allocator they own.
+ */
+
+constexpr StackAllocatorSettings  constructionStackSettings  = {.policy = StackAllocatorPolicy::Release};
+constexpr LinearAllocatorSettings constructionLinearSettings = {.policy = LinearAllocatorPolicy::Release};
+constexpr PoolAllocatorSettings   constructionPoolSettings   = {.policy = PoolAllocatorPolicy::Release};
+constexpr MallocatorSettings      constructionMallocSettings = {.policy = MallocatorPolicy::Release};
+constexpr IOBufferPoolSettings    constructionIOSettings     = {.policy = IOBufferPoolPolicy::Release};
+
+// Like the defaults of the composite allocators, their arenas grow
+constexpr PoolAllocatorSettings   constructionTypedSettings = {.policy = PoolAllocatorPolicy::Release | PoolAllocatorPolicy::Growable};
+constexpr LinearAllocatorSettings constructionChainSettings = {.policy = LinearAllocatorPolicy::Release | LinearAllocatorPolicy::Growable};
+
+using ConstructionFallbackAllocator = FallbackAllocator<StackAllocator<constructionStackSettings>, Mallocator<constructionMallocSettings>>;
+
+// Fits in the small string buffer of the common standard libraries, unlike the default names of most allocators
+static const std::string shortDebugName = "Request";
+static const std::string longDebugName  = "Server/RequestHandler/PerRequestArena";
+
+static void StackAllocatorConstruction(benchmark::State& state)
+{
+    const Size totalSize = state.range(0);
+    for (auto _ : state)
+    {
+        StackAllocator<constructionStackSettings> stackAllocator{totalSize, shortDebugName};
+        benchmark::DoNotOptimize(&stackAllocator);
+    }
+}
+BENCHMARK(StackAllocatorConstruction)->RangeMultiplier(16)->Range(1_KiB, 1_MiB);
+
+static void LinearAllocatorConstruction(benchmark::State& state)
+{
+    const Size blockSize = state.range(0);
+    for (auto _ : state)
+    {
+        LinearAllocator<constructionLinearSettings> linearAllocator{blockSize, shortDebugName};
+        benchmark::DoNotOptimize(&linearAllocator);
+    }
+}
+BENCHMARK(LinearAllocatorConstruction)->RangeMultiplier(16)->Range(1_KiB, 1_MiB);
+
+// The first block is linked into a free list chunk by chunk, so the cost grows with the objects per block
+static void PoolAllocatorConstruction(benchmark::State& state)
+{
+    const Size objectsPerBlock = state.range(0);
+    for (auto _ : state)
+    {
+        PoolAllocator<constructionPoolSettings> poolAllocator{sizeof(TestObject), objectsPerBlock, shortDebugName};
+        benchmark::DoNotOptimize(&poolAllocator);
+    }
+}
+BENCHMARK(PoolAllocatorConstruction)->RangeMultiplier(16)->Range(16, 64 << 10);
+
+static void MallocatorConstruction(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        Mallocator<constructionMallocSettings> mallocator{shortDebugName};
+        benchmark::DoNotOptimize(&mallocator);
+    }
+}
+BENCHMARK(MallocatorConstruction);
+
+// Copying a name that doesn't fit in the small string buffer adds an allocation
+static void LinearAllocatorConstructionLongName(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        LinearAllocator<constructionLinearSettings> linearAllocator{4_KiB, longDebugName};
+        benchmark::DoNotOptimize(&linearAllocator);
+    }
+}
+BENCHMARK(LinearAllocatorConstructionLongName);
+
+static void FrameAllocatorConstruction(benchmark::State& state)
+{
+    const Size frameSize = state.range(0);
+    for (auto _ : state)
+    {
+        FrameAllocator<2, constructionLinearSettings> frameAllocator{frameSize, shortDebugName};
+        benchmark::DoNotOptimize(&frameAllocator);
+    }
+}
+BENCHMARK(FrameAllocatorConstruction)->RangeMultiplier(16)->Range(1_KiB, 1_MiB);
+
+static void ObjectCacheConstruction(benchmark::State& state)
+{
+    const Size objectsPerBlock = state.range(0);
+    for (auto _ : state)
+    {
+        ObjectCache<TestObject, constructionPoolSettings> objectCache{objectsPerBlock, shortDebugName};
+        benchmark::DoNotOptimize(&objectCache);
+    }
+}
+BENCHMARK(ObjectCacheConstruction)->RangeMultiplier(16)->Range(16, 64 << 10);
+
+static void InternTableConstruction(benchmark::State& state)
+{
+    const Size blockSize = state.range(0);
+    for (auto _ : state)
+    {
+        InternTable<> internTable{blockSize, shortDebugName};
+        benchmark::DoNotOptimize(&internTable);
+    }
+}
+BENCHMARK(InternTableConstruction)->RangeMultiplier(16)->Range(1_KiB, 1_MiB);
+
+// The buffers are mapped and aligned to pages, so this is dominated by the system calls
+static void IOBufferPoolConstruction(benchmark::State& state)
+{
+    const Size bufferCount = state.range(0);
+    for (auto _ : state)
+    {
+        IOBufferPool<constructionIOSettings> ioBufferPool{4_KiB, bufferCount, shortDebugName};
+        benchmark::DoNotOptimize(&ioBufferPool);
+    }
+}
+BENCHMARK(IOBufferPoolConstruction)->RangeMultiplier(8)->Range(8, 512);
+
+// A registry doesn't allocate until a type is used, so the pool of the first type is created too
+static void TypedPoolsConstruction(benchmark::State& state)
+{
+    const Size objectsPerBlock = state.range(0);
+    for (auto _ : state)
+    {
+        TypedPools<constructionTypedSettings> typedPools{objectsPerBlock, shortDebugName};
+        benchmark::DoNotOptimize(&typedPools.GetPool<TestObject>());
+    }
+}
+BENCHMARK(TypedPoolsConstruction)->RangeMultiplier(16)->Range(16, 64 << 10);
+
+static void BufferChainConstruction(benchmark::State& state)
+{
+    const Size segmentSize = state.range(0);
+    for (auto _ : state)
+    {
+        BufferChain<constructionChainSettings> bufferChain{segmentSize, shortDebugName};
+        benchmark::DoNotOptimize(&bufferChain);
+    }
+}
+BENCHMARK(BufferChainConstruction)->RangeMultiplier(16)->Range(1_KiB, 1_MiB);
+
+// The primary and the fallback allocator are created with it, so three allocators are registered and unregistered
+static void FallbackAllocatorConstruction(benchmark::State& state)
+{
+    const Size primarySize = state.range(0);
+    for (auto _ : state)
+    {
+        ConstructionFallbackAllocator fallbackAllocator{
+            std::make_shared<StackAllocator<constructionStackSettings>>(primarySize, shortDebugName),
+            std::make_shared<Mallocator<constructionMallocSettings>>(shortDebugName), shortDebugName};
+        benchmark::DoNotOptimize(&fallbackAllocator);
+    }
+}
+BENCHMARK(FallbackAllocatorConstruction)->RangeMultiplier(16)->Range(1_KiB, 1_MiB);
+
+// A per-request arena that serves a few allocations before it is destroyed, for comparison with the construction alone
+static void LinearAllocatorRequestLifetime(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        LinearAllocator<constructionLinearSettings> linearAllocator{4_KiB, shortDebugName};
+        for (int i = 0; i < 16; i++)
+        {
+            benchmark::DoNotOptimize(linearAllocator.NewRaw<TestObject>(i, 1.5F, 'c', false, 10.5F));
+        }
+    }
+}
+BENCHMARK(LinearAllocatorRequestLifetime);
+
+// Unregistering an allocator searches the allocators that are alive, so this keeps `state.range(0)` other allocators registered
+static void LinearAllocatorConstructionWithLiveAllocators(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<LinearAllocator<constructionLinearSettings>>> liveAllocators;
+    for (Int64 i = 0; i < state.range(0); i++)
+    {
+        liveAllocators.push_back(std::make_unique<LinearAllocator<constructionLinearSettings>>(1_KiB, shortDebugName));
+    }
+
+    for (auto _ : state)
+    {
+        LinearAllocator<constructionLinearSettings> linearAllocator{4_KiB, shortDebugName};
+        benchmark::DoNotOptimize(&linearAllocator);
+    }
+}
+BENCHMARK(LinearAllocatorConstructionWithLiveAllocators)->RangeMultiplier(10)->Range(1, 10000);
+
+// Every thread creates its own arenas, so the threads only share the MemoryTracker and malloc
+static void ParallelLinearAllocatorConstruction(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        LinearAllocator<constructionLinearSettings> linearAllocator{4_KiB, shortDebugName};
+        benchmark::DoNotOptimize(&linearAllocator);
+    }
+}
+BENCHMARK(ParallelLinearAllocatorConstruction)->ThreadRange(1, 16)->UseRealTime();
+
+static void ParallelPoolAllocatorConstruction(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        PoolAllocator<constructionPoolSettings> poolAllocator{sizeof(TestObject), 256, shortDebugName};
+        benchmark::DoNotOptimize(&poolAllocator);
+    }
+}
+BENCHMARK(ParallelPoolAllocatorConstruction)->ThreadRange(1, 16)->UseRealTime();
+
+static void ParallelStackAllocatorConstruction(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        StackAllocator<constructionStackSettings> stackAllocator{4_KiB, shortDebugName};
+        benchmark::DoNotOptimize(&stackAllocator);
+    }
+}
+BENCHMARK(ParallelStackAllocatorConstruction)->ThreadRange(1, 16)->UseRealTime();
+
+static void ParallelTypedPoolsConstruction(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        TypedPools<constructionTypedSettings> typedPools{256, shortDebugName};
+        benchmark::DoNotOptimize(&typedPools.GetPool<TestObject>());
+    }
+}
+BENCHMARK(ParallelTypedPoolsConstruction)->ThreadRange(1, 16)->UseRealTime();
+
+static void ParallelBufferChainConstruction(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        BufferChain<constructionChainSettings> bufferChain{4_KiB, shortDebugName};
+        benchmark::DoNotOptimize(&bufferChain);
+    }
+}
+BENCHMARK(ParallelBufferChainConstruction)->ThreadRange(1, 16)->UseRealTime();
+
+static void ParallelFallbackAllocatorConstruction(benchmark::State& state)
+{
+    for (auto _ : state)
+    {
+        ConstructionFallbackAllocator fallbackAllocator{
+            std::make_shared<StackAllocator<constructionStackSettings>>(4_KiB, shortDebugName),
+            std::make_shared<Mallocator<constructionMallocSettings>>(shortDebugName), shortDebugName};
+        benchmark::DoNotOptimize(&fallbackAllocator);
+    }
+}
+BENCHMARK(ParallelFallbackAllocatorConstruction)->ThreadRange(1, 16)->UseRealTime();
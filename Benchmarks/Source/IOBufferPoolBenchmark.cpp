@@ -0,0 +1,210 @@
+#include <benchmark/benchmark.h>
+
+#if defined(__linux__)
+
+    #include <fcntl.h>
+    #include <stdlib.h>
+    #include <string.h>
+    #include <unistd.h>
+
+    #include <random>
+    #include <vector>
+
+    #include <Memarena/Memarena.hpp>
+
+using namespace Memarena;
+using namespace Memarena::SizeLiterals;
+
+constexpr Size directFileSize = 64_MiB;
+
+constexpr IOBufferPoolSettings ioBenchmarkSettings = {.policy = IOBufferPoolPolicy::Release};
+
+/**
+ * @brief An unlinked file in the working directory opened with O_DIRECT. The working directory is used because /tmp is often a tmpfs,
+ * which doesn't support O_DIRECT
+ */
+class DirectFile
+{
+  public:
+    DirectFile()
+    {
+        char path[]      = "MemarenaDirectIO.XXXXXX";
+        m_FileDescriptor = mkstemp(path);
+        if (m_FileDescriptor < 0)
+        {
+            return;
+        }
+        unlink(path);
+
+        // Write the whole file through the page cache once, so that the reads hit allocated blocks instead of holes
+        std::vector<Byte> chunk(1_MiB, 0xAB);
+        for (Size offset = 0; offset < directFileSize; offset += chunk.size())
+        {
+            if (pwrite(m_FileDescriptor, chunk.data(), chunk.size(), static_cast<off_t>(offset)) != static_cast<ssize_t>(chunk.size()))
+            {
+                Close();
+                return;
+            }
+        }
+        fsync(m_FileDescriptor);
+
+        if (fcntl(m_FileDescriptor, F_SETFL, fcntl(m_FileDescriptor, F_GETFL) | O_DIRECT) != 0)
+        {
+            Close();
+        }
+    }
+
+    DirectFile(const DirectFile&) = delete;
+    DirectFile(DirectFile&&)      = delete;
+    DirectFile& operator=(const DirectFile&) = delete;
+    DirectFile& operator=(DirectFile&&) = delete;
+
+    ~DirectFile() { Close(); }
+
+    [[nodiscard]] int  GetFileDescriptor() const { return m_FileDescriptor; }
+    [[nodiscard]] bool IsOpen() const { return m_FileDescriptor >= 0; }
+
+  private:
+    void Close()
+    {
+        if (m_FileDescriptor >= 0)
+        {
+            close(m_FileDescriptor);
+            m_FileDescriptor = -1;
+        }
+    }
+
+    int m_FileDescriptor = -1;
+};
+
+static DirectFile& GetDirectFile()
+{
+    static DirectFile directFile;
+    return directFile;
+}
+
+// Random offsets aligned to the transfer size, so every I/O satisfies the O_DIRECT alignment rules
+static std::vector<off_t> GetOffsets(const Size transferSize)
+{
+    std::mt19937                        randomEngine{42};
+    std::uniform_int_distribution<Size> distribution(0, directFileSize / transferSize - 1);
+    std::vector<off_t>                  offsets(1024);
+    for (off_t& offset : offsets)
+    {
+        offset = static_cast<off_t>(distribution(randomEngine) * transferSize);
+    }
+    return offsets;
+}
+
+// What the storage engine does today: an aligned allocation for every read
+static void PosixMemalignPread(benchmark::State& state)
+{
+    const Size         transferSize = state.range(0);
+    DirectFile&        file         = GetDirectFile();
+    std::vector<off_t> offsets      = GetOffsets(transferSize);
+
+    if (!file.IsOpen())
+    {
+        state.SkipWithError("O_DIRECT is not supported in the working directory");
+        return;
+    }
+
+    Size i = 0;
+    for (auto _ : state)
+    {
+        void* buffer = nullptr;
+        if (posix_memalign(&buffer, ioBufferAlignment, transferSize) != 0)
+        {
+            state.SkipWithError("posix_memalign failed");
+            break;
+        }
+
+        benchmark::DoNotOptimize(pread(file.GetFileDescriptor(), buffer, transferSize, offsets[i++ % offsets.size()]));
+        free(buffer);
+    }
+
+    state.SetBytesProcessed(static_cast<Int64>(state.iterations() * transferSize));
+}
+BENCHMARK(PosixMemalignPread)->RangeMultiplier(4)->Range(4_KiB, 1_MiB);
+
+static void IOBufferPoolPread(benchmark::State& state)
+{
+    const Size                        transferSize = state.range(0);
+    DirectFile&                       file         = GetDirectFile();
+    std::vector<off_t>                offsets      = GetOffsets(transferSize);
+    IOBufferPool<ioBenchmarkSettings> pool{transferSize, 64};
+
+    if (!file.IsOpen())
+    {
+        state.SkipWithError("O_DIRECT is not supported in the working directory");
+        return;
+    }
+
+    Size i = 0;
+    for (auto _ : state)
+    {
+        IOBuffer<ioBenchmarkSettings> buffer = pool.Acquire();
+        benchmark::DoNotOptimize(pread(file.GetFileDescriptor(), buffer.GetData(), transferSize, offsets[i++ % offsets.size()]));
+    }
+
+    state.SetBytesProcessed(static_cast<Int64>(state.iterations() * transferSize));
+}
+BENCHMARK(IOBufferPoolPread)->RangeMultiplier(4)->Range(4_KiB, 1_MiB);
+
+static void PosixMemalignPwrite(benchmark::State& state)
+{
+    const Size         transferSize = state.range(0);
+    DirectFile&        file         = GetDirectFile();
+    std::vector<off_t> offsets      = GetOffsets(transferSize);
+
+    if (!file.IsOpen())
+    {
+        state.SkipWithError("O_DIRECT is not supported in the working directory");
+        return;
+    }
+
+    Size i = 0;
+    for (auto _ : state)
+    {
+        void* buffer = nullptr;
+        if (posix_memalign(&buffer, ioBufferAlignment, transferSize) != 0)
+        {
+            state.SkipWithError("posix_memalign failed");
+            break;
+        }
+
+        memset(buffer, static_cast<int>(i), transferSize);
+        benchmark::DoNotOptimize(pwrite(file.GetFileDescriptor(), buffer, transferSize, offsets[i++ % offsets.size()]));
+        free(buffer);
+    }
+
+    state.SetBytesProcessed(static_cast<Int64>(state.iterations() * transferSize));
+}
+BENCHMARK(PosixMemalignPwrite)->RangeMultiplier(4)->Range(4_KiB, 1_MiB);
+
+static void IOBufferPoolPwrite(benchmark::State& state)
+{
+    const Size                        transferSize = state.range(0);
+    DirectFile&                       file         = GetDirectFile();
+    std::vector<off_t>                offsets      = GetOffsets(transferSize);
+    IOBufferPool<ioBenchmarkSettings> pool{transferSize, 64};
+
+    if (!file.IsOpen())
+    {
+        state.SkipWithError("O_DIRECT is not supported in the working directory");
+        return;
+    }
+
+    Size i = 0;
+    for (auto _ : state)
+    {
+        IOBuffer<ioBenchmarkSettings> buffer = pool.Acquire();
+        memset(buffer.GetData(), static_cast<int>(i), transferSize);
+        benchmark::DoNotOptimize(pwrite(file.GetFileDescriptor(), buffer.GetData(), transferSize, offsets[i++ % offsets.size()]));
+    }
+
+    state.SetBytesProcessed(static_cast<Int64>(state.iterations() * transferSize));
+}
+BENCHMARK(IOBufferPoolPwrite)->RangeMultiplier(4)->Range(4_KiB, 1_MiB);
+
+#endif
@@ -0,0 +1,102 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+#include "MemoryTestObjects.hpp"
+
+using namespace Memarena;
+
+constexpr PoolAllocatorSettings localitySettings = {.policy = PoolAllocatorPolicy::Release};
+
+// Fills the pool, frees every object in a random order and then allocates half of the objects again, optionally sorting the free
+// list first. The returned objects are in allocation order.
+static std::vector<TestObject*> AllocateAfterChurn(PoolAllocator<localitySettings>& poolAllocator, const Size objectCount,
+                                                   const bool sortFreeList)
+{
+    std::vector<TestObject*> objects;
+    objects.reserve(objectCount);
+
+    for (Size i = 0; i < objectCount; i++)
+    {
+        objects.push_back(poolAllocator.NewRaw<TestObject>(1, 1.5F, 'c', false, 10.5F));
+    }
+
+    std::mt19937 randomEngine{42};
+    std::ranges::shuffle(objects, randomEngine);
+
+    for (TestObject*& object : objects)
+    {
+        poolAllocator.Delete(object);
+    }
+    objects.clear();
+
+    if (sortFreeList)
+    {
+        poolAllocator.SortFreeList();
+    }
+
+    for (Size i = 0; i < objectCount / 2; i++)
+    {
+        objects.push_back(poolAllocator.NewRaw<TestObject>(static_cast<int>(i), 1.5F, 'c', false, 10.5F));
+    }
+
+    return objects;
+}
+
+static void AccessObjects(benchmark::State& state, const bool sortFreeList)
+{
+    const Size                      objectCount = state.range(0);
+    PoolAllocator<localitySettings> poolAllocator{sizeof(TestObject), objectCount};
+    const std::vector<TestObject*>  objects = AllocateAfterChurn(poolAllocator, objectCount, sortFreeList);
+
+    for (auto _ : state)
+    {
+        float sum = 0;
+        for (const TestObject* object : objects)
+        {
+            sum += static_cast<float>(object->a) + object->b + object->e;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.SetItemsProcessed(static_cast<Int64>(state.iterations() * objects.size()));
+}
+
+static void PoolAllocatorChurnedAccess(benchmark::State& state) { AccessObjects(state, false); }
+BENCHMARK(PoolAllocatorChurnedAccess)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+
+static void PoolAllocatorSortedAccess(benchmark::State& state) { AccessObjects(state, true); }
+BENCHMARK(PoolAllocatorSortedAccess)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
+
+static void PoolAllocatorSortFreeList(benchmark::State& state)
+{
+    const Size                      objectCount = state.range(0);
+    PoolAllocator<localitySettings> poolAllocator{sizeof(TestObject), objectCount};
+    std::vector<TestObject*>        objects = AllocateAfterChurn(poolAllocator, objectCount, false);
+
+    for (auto _ : state)
+    {
+        poolAllocator.SortFreeList();
+
+        state.PauseTiming();
+        std::mt19937 randomEngine{42};
+        std::ranges::shuffle(objects, randomEngine);
+        for (TestObject*& object : objects)
+        {
+            poolAllocator.Delete(object);
+        }
+        objects.clear();
+        for (Size i = 0; i < objectCount / 2; i++)
+        {
+            objects.push_back(poolAllocator.NewRaw<TestObject>(1, 1.5F, 'c', false, 10.5F));
+        }
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(static_cast<Int64>(state.iterations() * objectCount));
+}
+BENCHMARK(PoolAllocatorSortFreeList)->RangeMultiplier(8)->Range(1 << 12, 1 << 21);
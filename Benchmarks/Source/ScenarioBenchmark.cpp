@@ -0,0 +1,742 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+using namespace Memarena;
+using namespace Memarena::SizeLiterals;
+
+/**
+ * End-to-end scenarios instead of single allocations in a loop: an HTTP-style request, a game frame, a graph and a JSON document. The
+ * scenarios allocate through a resource and free every object explicitly, so the new/delete and std::pmr baselines pay for every free
+ * while the arenas can turn the frees into destructor calls and drop everything at once at the end of the scope. Every scenario runs on
+ * the arena it is deployed with, on new/delete and on the closest std::pmr resource.
+ */
+
+namespace
+{
+
+constexpr LinearAllocatorSettings scenarioLinearSettings = {.policy = LinearAllocatorPolicy::Release | LinearAllocatorPolicy::Growable};
+constexpr StackAllocatorSettings  scenarioStackSettings  = {.policy = StackAllocatorPolicy::Release};
+constexpr PoolAllocatorSettings   scenarioPoolSettings   = {.policy = PoolAllocatorPolicy::Release | PoolAllocatorPolicy::Growable};
+
+// ======== RESOURCES ========
+
+class NewDeleteResource
+{
+  public:
+    template <typename T, typename... Args>
+    T* New(Args&&... argList)
+    {
+        return new T(std::forward<Args>(argList)...);
+    }
+
+    template <typename T>
+    void Delete(T* ptr)
+    {
+        delete ptr;
+    }
+
+    template <typename T>
+    T* NewArray(const Size count)
+    {
+        return new T[count]();
+    }
+
+    template <typename T>
+    void DeleteArray(T* ptr, const Size /*count*/)
+    {
+        delete[] ptr;
+    }
+
+    void EndScope() {}
+};
+
+// An arena that frees everything at the end of the scope. Deleting only runs the destructor
+template <typename Arena>
+class ArenaResource
+{
+  public:
+    template <typename T, typename... Args>
+    T* New(Args&&... argList)
+    {
+        return m_Arena.template NewRaw<T>(std::forward<Args>(argList)...);
+    }
+
+    template <typename T>
+    void Delete(T* ptr)
+    {
+        std::destroy_at(ptr);
+    }
+
+    template <typename T>
+    T* NewArray(const Size count)
+    {
+        T* ptr = static_cast<T*>(m_Arena.Allocate(count * sizeof(T), alignof(T)));
+        std::uninitialized_value_construct_n(ptr, count);
+        return ptr;
+    }
+
+    template <typename T>
+    void DeleteArray(T* ptr, const Size count)
+    {
+        std::destroy_n(ptr, count);
+    }
+
+    void EndScope() { m_Arena.Release(); }
+
+  protected:
+    explicit ArenaResource(const Size size) : m_Arena(size, "Scenario") {}
+
+  private:
+    Arena m_Arena;
+};
+
+class LinearArenaResource : public ArenaResource<LinearAllocator<scenarioLinearSettings>>
+{
+  public:
+    LinearArenaResource() : ArenaResource(64_KiB) {}
+};
+
+class StackArenaResource : public ArenaResource<StackAllocator<scenarioStackSettings>>
+{
+  public:
+    StackArenaResource() : ArenaResource(4_MiB) {}
+};
+
+// A pool per type, objects are freed one by one
+class TypedPoolsResource
+{
+  public:
+    template <typename T, typename... Args>
+    T* New(Args&&... argList)
+    {
+        return m_Pools.New<T>(std::forward<Args>(argList)...);
+    }
+
+    template <typename T>
+    void Delete(T* ptr)
+    {
+        m_Pools.Delete(ptr);
+    }
+
+    void EndScope() {}
+
+  private:
+    TypedPools<scenarioPoolSettings> m_Pools{1024, "Scenario"};
+};
+
+template <typename MemoryResource>
+class PmrResource
+{
+  public:
+    template <typename T, typename... Args>
+    T* New(Args&&... argList)
+    {
+        return m_Allocator.new_object<T>(std::forward<Args>(argList)...);
+    }
+
+    template <typename T>
+    void Delete(T* ptr)
+    {
+        m_Allocator.delete_object(ptr);
+    }
+
+    template <typename T>
+    T* NewArray(const Size count)
+    {
+        T* ptr = m_Allocator.allocate_object<T>(count);
+        std::uninitialized_value_construct_n(ptr, count);
+        return ptr;
+    }
+
+    template <typename T>
+    void DeleteArray(T* ptr, const Size count)
+    {
+        std::destroy_n(ptr, count);
+        m_Allocator.deallocate_object(ptr, count);
+    }
+
+    void EndScope()
+    {
+        if constexpr (std::is_same_v<MemoryResource, std::pmr::monotonic_buffer_resource>)
+        {
+            m_Resource.release();
+        }
+    }
+
+  private:
+    MemoryResource                    m_Resource;
+    std::pmr::polymorphic_allocator<> m_Allocator{&m_Resource};
+};
+
+using PmrMonotonicResource = PmrResource<std::pmr::monotonic_buffer_resource>;
+using PmrPoolResource      = PmrResource<std::pmr::unsynchronized_pool_resource>;
+
+template <typename Resource>
+char* CopyString(Resource& resource, const std::string_view text)
+{
+    char* copy = resource.template NewArray<char>(text.size() + 1);
+    std::memcpy(copy, text.data(), text.size());
+    return copy;
+}
+
+// ======== HTTP REQUEST ========
+
+struct HttpHeader
+{
+    char*       name;
+    char*       value;
+    Size        nameLength;
+    Size        valueLength;
+    HttpHeader* next;
+};
+
+struct Expression
+{
+    char        op; // 0 for a number
+    double      value;
+    Expression* left;
+    Expression* right;
+};
+
+// A request with a dozen headers and an arithmetic expression as the body
+std::string MakeHttpRequest()
+{
+    std::string request = "POST /api/v1/evaluate?format=json&trace=false HTTP/1.1\r\n";
+    for (int i = 0; i < 12; i++)
+    {
+        request += "X-Header-" + std::to_string(i) + ": value-" + std::to_string(i * 7919) + "-with-some-payload\r\n";
+    }
+    request += "\r\n";
+
+    std::mt19937 randomEngine{7};
+    std::string  body = "1";
+    for (int i = 0; i < 200; i++)
+    {
+        const char op = "+-*"[randomEngine() % 3];
+        body          = (i % 8 == 0 ? "(" + body + ")" : body) + op + std::to_string(randomEngine() % 100 + 1);
+    }
+    return request + body;
+}
+
+template <typename Resource>
+class ExpressionParser
+{
+  public:
+    ExpressionParser(Resource& resource, const std::string_view text) : m_Resource(resource), m_Text(text) {}
+
+    Expression* ParseSum()
+    {
+        Expression* left = ParseProduct();
+        while (m_Position < m_Text.size() && (m_Text[m_Position] == '+' || m_Text[m_Position] == '-'))
+        {
+            const char op = m_Text[m_Position++];
+            left          = m_Resource.template New<Expression>(Expression{op, 0.0, left, ParseProduct()});
+        }
+        return left;
+    }
+
+  private:
+    Expression* ParseProduct()
+    {
+        Expression* left = ParseAtom();
+        while (m_Position < m_Text.size() && m_Text[m_Position] == '*')
+        {
+            m_Position++;
+            left = m_Resource.template New<Expression>(Expression{'*', 0.0, left, ParseAtom()});
+        }
+        return left;
+    }
+
+    Expression* ParseAtom()
+    {
+        if (m_Text[m_Position] == '(')
+        {
+            m_Position++;
+            Expression* inner = ParseSum();
+            m_Position++; // ')'
+            return inner;
+        }
+
+        double value = 0.0;
+        while (m_Position < m_Text.size() && m_Text[m_Position] >= '0' && m_Text[m_Position] <= '9')
+        {
+            value = value * 10.0 + (m_Text[m_Position++] - '0');
+        }
+        return m_Resource.template New<Expression>(Expression{0, value, nullptr, nullptr});
+    }
+
+    Resource&        m_Resource;
+    std::string_view m_Text;
+    Size             m_Position = 0;
+};
+
+double Evaluate(const Expression* expression)
+{
+    switch (expression->op)
+    {
+    case '+':
+        return Evaluate(expression->left) + Evaluate(expression->right);
+    case '-':
+        return Evaluate(expression->left) - Evaluate(expression->right);
+    case '*':
+        return Evaluate(expression->left) * Evaluate(expression->right);
+    default:
+        return expression->value;
+    }
+}
+
+template <typename Resource>
+void DeleteExpression(Resource& resource, Expression* expression)
+{
+    if (expression->op != 0)
+    {
+        DeleteExpression(resource, expression->left);
+        DeleteExpression(resource, expression->right);
+    }
+    resource.Delete(expression);
+}
+
+// A response buffer that doubles when it is full, like a string builder
+template <typename Resource>
+class ResponseWriter
+{
+  public:
+    explicit ResponseWriter(Resource& resource) : m_Resource(resource), m_Data(resource.template NewArray<char>(m_Capacity)) {}
+
+    void Append(const std::string_view text)
+    {
+        if (m_Size + text.size() > m_Capacity)
+        {
+            const Size newCapacity = std::max(m_Capacity * 2, m_Size + text.size());
+            char*      newData     = m_Resource.template NewArray<char>(newCapacity);
+            std::memcpy(newData, m_Data, m_Size);
+            m_Resource.DeleteArray(m_Data, m_Capacity);
+            m_Data     = newData;
+            m_Capacity = newCapacity;
+        }
+        std::memcpy(m_Data + m_Size, text.data(), text.size());
+        m_Size += text.size();
+    }
+
+    void Free() { m_Resource.DeleteArray(m_Data, m_Capacity); }
+
+    [[nodiscard]] Size GetSize() const { return m_Size; }
+
+  private:
+    Resource& m_Resource;
+    Size      m_Capacity = 128;
+    Size      m_Size     = 0;
+    char*     m_Data;
+};
+
+template <typename Resource>
+void HttpRequest(benchmark::State& state)
+{
+    const std::string request = MakeHttpRequest();
+    Resource          resource;
+
+    for (auto _ : state)
+    {
+        // Parse the headers into a list of copies
+        const Size       headerEnd = request.find("\r\n\r\n");
+        std::string_view headers   = std::string_view(request).substr(0, headerEnd);
+        headers.remove_prefix(headers.find("\r\n") + 2);
+
+        HttpHeader* firstHeader = nullptr;
+        while (!headers.empty())
+        {
+            const Size             lineEnd = std::min(headers.find("\r\n"), headers.size());
+            const std::string_view line    = headers.substr(0, lineEnd);
+            const Size             colon   = line.find(':');
+
+            firstHeader = resource.template New<HttpHeader>(HttpHeader{CopyString(resource, line.substr(0, colon)),
+                                                                       CopyString(resource, line.substr(colon + 2)), colon,
+                                                                       line.size() - colon - 2, firstHeader});
+            headers.remove_prefix(std::min(lineEnd + 2, headers.size()));
+        }
+
+        // Build the AST of the body and render the response
+        ExpressionParser<Resource> parser(resource, std::string_view(request).substr(headerEnd + 4));
+        Expression*                expression = parser.ParseSum();
+
+        ResponseWriter<Resource> response(resource);
+        response.Append("HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n");
+        for (const HttpHeader* header = firstHeader; header != nullptr; header = header->next)
+        {
+            response.Append("X-Echo-");
+            response.Append(std::string_view(header->name, header->nameLength));
+            response.Append(": ");
+            response.Append(std::string_view(header->value, header->valueLength));
+            response.Append("\r\n");
+        }
+        response.Append("\r\n{\"result\":");
+        response.Append(std::to_string(Evaluate(expression)));
+        response.Append("}");
+        benchmark::DoNotOptimize(response.GetSize());
+
+        // Tear the request down
+        response.Free();
+        DeleteExpression(resource, expression);
+        while (firstHeader != nullptr)
+        {
+            HttpHeader* next = firstHeader->next;
+            resource.DeleteArray(firstHeader->name, firstHeader->nameLength + 1);
+            resource.DeleteArray(firstHeader->value, firstHeader->valueLength + 1);
+            resource.Delete(firstHeader);
+            firstHeader = next;
+        }
+        resource.EndScope();
+    }
+}
+
+BENCHMARK_TEMPLATE(HttpRequest, NewDeleteResource);
+BENCHMARK_TEMPLATE(HttpRequest, PmrMonotonicResource);
+BENCHMARK_TEMPLATE(HttpRequest, LinearArenaResource);
+
+// ======== GAME FRAME ========
+
+struct Particle
+{
+    float position[3];
+    float velocity[3];
+    float lifetime;
+};
+
+struct DrawCommand
+{
+    const Particle* particle;
+    float           depth;
+    UInt32          material;
+};
+
+// Every frame spawns particles from the persistent resource, updates them, frees the expired ones and builds a sorted draw list in
+// memory from the frame resource
+template <typename FrameResource, typename PersistentResource>
+void GameFrame(benchmark::State& state)
+{
+    constexpr Size  spawnsPerFrame = 256;
+    constexpr float frameTime      = 1.0F / 60.0F;
+
+    FrameResource          frameResource;
+    PersistentResource     persistentResource;
+    std::vector<Particle*> particles;
+    particles.reserve(64_KiB);
+
+    std::mt19937                          randomEngine{13};
+    std::uniform_real_distribution<float> distribution(-1.0F, 1.0F);
+
+    for (auto _ : state)
+    {
+        for (Size i = 0; i < spawnsPerFrame; i++)
+        {
+            const float lifetime = 0.5F + distribution(randomEngine) * 0.4F;
+            particles.push_back(persistentResource.template New<Particle>(
+                Particle{{0.0F, 0.0F, 0.0F}, {distribution(randomEngine), 1.0F, distribution(randomEngine)}, lifetime}));
+        }
+
+        // Update and free the expired particles, keeping the order of the others
+        Size aliveCount = 0;
+        for (Particle* particle : particles)
+        {
+            particle->lifetime -= frameTime;
+            if (particle->lifetime <= 0.0F)
+            {
+                persistentResource.Delete(particle);
+                continue;
+            }
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                particle->position[axis] += particle->velocity[axis] * frameTime;
+            }
+            particles[aliveCount++] = particle;
+        }
+        particles.resize(aliveCount);
+
+        // Cull, sort back to front and build the draw list in frame memory
+        const Particle** visible      = frameResource.template NewArray<const Particle*>(aliveCount);
+        Size             visibleCount = 0;
+        for (const Particle* particle : particles)
+        {
+            if (particle->position[2] > -0.5F)
+            {
+                visible[visibleCount++] = particle;
+            }
+        }
+
+        DrawCommand* commands = frameResource.template NewArray<DrawCommand>(visibleCount);
+        for (Size i = 0; i < visibleCount; i++)
+        {
+            commands[i] = DrawCommand{visible[i], visible[i]->position[2], static_cast<UInt32>(i % 4)};
+        }
+        std::sort(commands, commands + visibleCount, [](const DrawCommand& a, const DrawCommand& b) { return a.depth > b.depth; });
+        benchmark::DoNotOptimize(commands);
+
+        frameResource.DeleteArray(commands, visibleCount);
+        frameResource.DeleteArray(visible, aliveCount);
+        frameResource.EndScope();
+    }
+
+    for (Particle* particle : particles)
+    {
+        persistentResource.Delete(particle);
+    }
+}
+
+BENCHMARK_TEMPLATE(GameFrame, NewDeleteResource, NewDeleteResource);
+BENCHMARK_TEMPLATE(GameFrame, PmrMonotonicResource, PmrPoolResource);
+BENCHMARK_TEMPLATE(GameFrame, StackArenaResource, TypedPoolsResource);
+
+// ======== GRAPH ========
+
+struct GraphNode;
+
+struct GraphEdge
+{
+    GraphNode* target;
+    GraphEdge* next;
+};
+
+struct GraphNode
+{
+    UInt32     id;
+    UInt32     distance;
+    GraphEdge* firstEdge;
+};
+
+// Builds a random graph with `state.range(0)` nodes and four edges per node, traverses it breadth first and frees it
+template <typename Resource>
+void Graph(benchmark::State& state)
+{
+    constexpr Size edgesPerNode = 4;
+
+    const Size nodeCount = state.range(0);
+    Resource   resource;
+
+    std::vector<GraphNode*> nodes(nodeCount);
+    std::vector<GraphNode*> queue(nodeCount);
+
+    for (auto _ : state)
+    {
+        std::mt19937 randomEngine{21};
+
+        for (Size i = 0; i < nodeCount; i++)
+        {
+            nodes[i] = resource.template New<GraphNode>(GraphNode{static_cast<UInt32>(i), std::numeric_limits<UInt32>::max(), nullptr});
+        }
+        for (GraphNode* node : nodes)
+        {
+            for (Size i = 0; i < edgesPerNode; i++)
+            {
+                node->firstEdge = resource.template New<GraphEdge>(GraphEdge{nodes[randomEngine() % nodeCount], node->firstEdge});
+            }
+        }
+
+        Size queueBegin = 0;
+        Size queueEnd   = 0;
+
+        nodes[0]->distance = 0;
+        queue[queueEnd++]  = nodes[0];
+        while (queueBegin < queueEnd)
+        {
+            const GraphNode* node = queue[queueBegin++];
+            for (const GraphEdge* edge = node->firstEdge; edge != nullptr; edge = edge->next)
+            {
+                if (edge->target->distance == std::numeric_limits<UInt32>::max())
+                {
+                    edge->target->distance = node->distance + 1;
+                    queue[queueEnd++]      = edge->target;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(queueEnd);
+
+        for (GraphNode* node : nodes)
+        {
+            while (node->firstEdge != nullptr)
+            {
+                GraphEdge* next = node->firstEdge->next;
+                resource.Delete(node->firstEdge);
+                node->firstEdge = next;
+            }
+            resource.Delete(node);
+        }
+        resource.EndScope();
+    }
+
+    state.SetItemsProcessed(static_cast<Int64>(state.iterations() * nodeCount));
+}
+
+BENCHMARK_TEMPLATE(Graph, NewDeleteResource)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(Graph, PmrPoolResource)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+BENCHMARK_TEMPLATE(Graph, TypedPoolsResource)->RangeMultiplier(16)->Range(1 << 10, 1 << 18);
+
+// ======== JSON DOM ========
+
+struct JsonValue
+{
+    enum class Type : UInt8
+    {
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    Type       type;
+    double     number;
+    char*      text; // The characters of a string
+    Size       textLength;
+    char*      key; // The key of a member of an object
+    Size       keyLength;
+    JsonValue* firstChild;
+    JsonValue* next;
+};
+
+// An array of `recordCount` records with a few fields and a nested array each
+std::string MakeJsonDocument(const Size recordCount)
+{
+    std::string document = "[";
+    for (Size i = 0; i < recordCount; i++)
+    {
+        document += (i > 0 ? "," : "");
+        document += R"({"id":)" + std::to_string(i) + R"(,"name":"record-)" + std::to_string(i) +
+                    R"(","score":)" + std::to_string(i * 0.25) + R"(,"tags":["alpha","beta","gamma"],"position":[)" +
+                    std::to_string(i % 17) + "," + std::to_string(i % 31) + "]}";
+    }
+    return document + "]";
+}
+
+// A parser for the subset of JSON that `MakeJsonDocument` writes
+template <typename Resource>
+class JsonParser
+{
+  public:
+    JsonParser(Resource& resource, const std::string_view text) : m_Resource(resource), m_Text(text) {}
+
+    JsonValue* ParseValue()
+    {
+        JsonValue* value = m_Resource.template New<JsonValue>(JsonValue{});
+
+        const char first = m_Text[m_Position];
+        if (first == '[' || first == '{')
+        {
+            const bool isObject = first == '{';
+            value->type         = isObject ? JsonValue::Type::Object : JsonValue::Type::Array;
+            m_Position++;
+
+            JsonValue** lastChild = &value->firstChild;
+            while (m_Text[m_Position] != (isObject ? '}' : ']'))
+            {
+                std::string_view key;
+                if (isObject)
+                {
+                    key = ParseString();
+                    m_Position++; // ':'
+                }
+
+                JsonValue* child = ParseValue();
+                if (isObject)
+                {
+                    child->key       = CopyString(m_Resource, key);
+                    child->keyLength = key.size();
+                }
+                *lastChild = child;
+                lastChild  = &child->next;
+
+                if (m_Text[m_Position] == ',')
+                {
+                    m_Position++;
+                }
+            }
+            m_Position++;
+        }
+        else if (first == '"')
+        {
+            const std::string_view text = ParseString();
+            value->type                 = JsonValue::Type::String;
+            value->text                 = CopyString(m_Resource, text);
+            value->textLength           = text.size();
+        }
+        else
+        {
+            const Size end = m_Text.find_first_of(",]}", m_Position);
+            value->type    = JsonValue::Type::Number;
+            std::from_chars(m_Text.data() + m_Position, m_Text.data() + end, value->number);
+            m_Position = end;
+        }
+
+        return value;
+    }
+
+  private:
+    std::string_view ParseString()
+    {
+        const Size begin = m_Position + 1;
+        m_Position       = m_Text.find('"', begin) + 1;
+        return m_Text.substr(begin, m_Position - begin - 1);
+    }
+
+    Resource&        m_Resource;
+    std::string_view m_Text;
+    Size             m_Position = 0;
+};
+
+template <typename Resource>
+void DeleteJsonValue(Resource& resource, JsonValue* value)
+{
+    JsonValue* child = value->firstChild;
+    while (child != nullptr)
+    {
+        JsonValue* next = child->next;
+        DeleteJsonValue(resource, child);
+        child = next;
+    }
+
+    if (value->text != nullptr)
+    {
+        resource.DeleteArray(value->text, value->textLength + 1);
+    }
+    if (value->key != nullptr)
+    {
+        resource.DeleteArray(value->key, value->keyLength + 1);
+    }
+    resource.Delete(value);
+}
+
+// Builds the DOM of a document with `state.range(0)` records and tears it down
+template <typename Resource>
+void JsonDom(benchmark::State& state)
+{
+    const std::string document = MakeJsonDocument(state.range(0));
+    Resource          resource;
+
+    for (auto _ : state)
+    {
+        JsonParser<Resource> parser(resource, document);
+        JsonValue*           root = parser.ParseValue();
+        benchmark::DoNotOptimize(root);
+
+        DeleteJsonValue(resource, root);
+        resource.EndScope();
+    }
+
+    state.SetBytesProcessed(static_cast<Int64>(state.iterations() * document.size()));
+}
+
+BENCHMARK_TEMPLATE(JsonDom, NewDeleteResource)->RangeMultiplier(16)->Range(16, 16 << 8);
+BENCHMARK_TEMPLATE(JsonDom, PmrMonotonicResource)->RangeMultiplier(16)->Range(16, 16 << 8);
+BENCHMARK_TEMPLATE(JsonDom, LinearArenaResource)->RangeMultiplier(16)->Range(16, 16 << 8);
+} // namespace
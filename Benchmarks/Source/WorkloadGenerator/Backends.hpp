@@ -0,0 +1,259 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+#include <Memarena/Memarena.hpp>
+
+namespace Memarena::Workload
+{
+
+/**
+ * The allocators a workload can run against. A backend is shared by all the threads of a workload, so the `IsMultithreaded` variant
+ * is used when there is more than one thread. Every backend has the same interface:
+ *   Allocate(size), which returns nullptr when the allocator is exhausted
+ *   Deallocate(ptr, size)
+ *   GetFootprint(), the bytes the allocator holds, if it knows them
+ * and declares whether it needs its frees in LIFO order and whether it can serve more than one thread.
+ */
+
+struct BackendOptions
+{
+    Size blockSize; // Of the growable allocators
+    Size arenaSize; // Of the StackAllocator
+};
+
+template <bool IsMultithreaded>
+class MallocBackend
+{
+  public:
+    static constexpr bool RequiresLifoOrder = false;
+    static constexpr bool SupportsThreads   = true;
+
+    explicit MallocBackend(const BackendOptions& /*options*/) {}
+
+    [[nodiscard]] void* Allocate(const Size size) { return std::malloc(size); }
+    void                Deallocate(void* ptr, const Size /*size*/) { std::free(ptr); }
+
+    [[nodiscard]] std::optional<Size> GetFootprint() const { return std::nullopt; }
+};
+
+// Counts the bytes a std::pmr pool holds from its upstream. The synchronized pool calls its upstream under its own lock
+class CountingResource : public std::pmr::memory_resource
+{
+  public:
+    [[nodiscard]] Size GetSize() const { return m_Size.load(std::memory_order_relaxed); }
+
+  private:
+    void* do_allocate(const Size bytes, const Size alignment) override
+    {
+        m_Size.fetch_add(bytes, std::memory_order_relaxed);
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, const Size bytes, const Size alignment) override
+    {
+        m_Size.fetch_sub(bytes, std::memory_order_relaxed);
+        std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    std::atomic<Size> m_Size = 0;
+};
+
+template <bool IsMultithreaded>
+class PmrPoolBackend
+{
+  public:
+    static constexpr bool RequiresLifoOrder = false;
+    static constexpr bool SupportsThreads   = true;
+
+    explicit PmrPoolBackend(const BackendOptions& /*options*/) {}
+
+    [[nodiscard]] void* Allocate(const Size size) { return m_PoolResource.allocate(size); }
+    void                Deallocate(void* ptr, const Size size) { m_PoolResource.deallocate(ptr, size); }
+
+    [[nodiscard]] std::optional<Size> GetFootprint() const { return m_UpstreamResource.GetSize(); }
+
+  private:
+    using PoolResource =
+        std::conditional_t<IsMultithreaded, std::pmr::synchronized_pool_resource, std::pmr::unsynchronized_pool_resource>;
+
+    CountingResource m_UpstreamResource;
+    PoolResource     m_PoolResource{&m_UpstreamResource};
+};
+
+template <bool IsMultithreaded>
+class MallocatorBackend
+{
+  public:
+    static constexpr bool RequiresLifoOrder = false;
+    static constexpr bool SupportsThreads   = true;
+
+    static constexpr MallocatorSettings settings = {
+        .policy = MallocatorPolicy::Release | MallocatorPolicy::Headerless |
+                  (IsMultithreaded ? MallocatorPolicy::Multithreaded : MallocatorPolicy::Empty)};
+
+    explicit MallocatorBackend(const BackendOptions& /*options*/) {}
+
+    [[nodiscard]] void* Allocate(const Size size) { return m_Mallocator.Allocate(size); }
+    void                Deallocate(void* ptr, const Size size) { m_Mallocator.Deallocate(ptr, size); }
+
+    [[nodiscard]] std::optional<Size> GetFootprint() const { return std::nullopt; }
+
+  private:
+    Mallocator<settings> m_Mallocator{"Workload"};
+};
+
+/**
+ * A growable PoolAllocator per power of two size class from 16 bytes to 4 KiB, like a size class allocator built from the pools.
+ * Larger allocations go to a Mallocator. The extra policy selects a pool configuration, e.g. block local free lists
+ */
+template <bool IsMultithreaded, PoolAllocatorPolicy ExtraPolicy = PoolAllocatorPolicy::Empty>
+class PoolBackend
+{
+  public:
+    static constexpr bool RequiresLifoOrder = false;
+    static constexpr bool SupportsThreads   = true;
+
+    static constexpr PoolAllocatorSettings settings = {
+        .policy = PoolAllocatorPolicy::Release | PoolAllocatorPolicy::Growable | PoolAllocatorPolicy::SizeTracking | ExtraPolicy |
+                  (IsMultithreaded ? PoolAllocatorPolicy::Multithreaded : PoolAllocatorPolicy::Empty)};
+
+    static constexpr MallocatorSettings largeSettings = {
+        .policy = MallocatorPolicy::Release | MallocatorPolicy::Headerless |
+                  (IsMultithreaded ? MallocatorPolicy::Multithreaded : MallocatorPolicy::Empty)};
+
+    explicit PoolBackend(const BackendOptions& options)
+    {
+        for (Size sizeClass = 0; sizeClass < SizeClassCount; sizeClass++)
+        {
+            const Size        objectSize      = MinObjectSize << sizeClass;
+            const Size        objectsPerBlock = std::max<Size>(options.blockSize / objectSize, 16);
+            const std::string debugName       = "Workload" + std::to_string(objectSize);
+            m_Pools[sizeClass] = std::make_unique<PoolAllocator<settings>>(objectSize, objectsPerBlock, debugName);
+        }
+    }
+
+    [[nodiscard]] void* Allocate(const Size size)
+    {
+        if (size > MaxObjectSize)
+        {
+            return m_LargeAllocator.Allocate(size);
+        }
+        return m_Pools[GetSizeClass(size)]->Allocate();
+    }
+
+    void Deallocate(void* ptr, const Size size)
+    {
+        if (size > MaxObjectSize)
+        {
+            m_LargeAllocator.Deallocate(ptr, size);
+            return;
+        }
+        m_Pools[GetSizeClass(size)]->Deallocate(ptr);
+    }
+
+    // Without the large allocations, which the Mallocator doesn't count
+    [[nodiscard]] std::optional<Size> GetFootprint() const
+    {
+        Size footprint = 0;
+        for (const auto& pool : m_Pools)
+        {
+            footprint += pool->GetTotalSize();
+        }
+        return footprint;
+    }
+
+  private:
+    static constexpr Size MinObjectSize  = 16;
+    static constexpr Size MaxObjectSize  = 4096;
+    static constexpr Size SizeClassCount = std::countr_zero(MaxObjectSize / MinObjectSize) + 1;
+
+    [[nodiscard]] static Size GetSizeClass(const Size size)
+    {
+        return size <= MinObjectSize ? 0 : std::bit_width(size - 1) - std::countr_zero(MinObjectSize);
+    }
+
+    std::array<std::unique_ptr<PoolAllocator<settings>>, SizeClassCount> m_Pools;
+    Mallocator<largeSettings>                                            m_LargeAllocator{"WorkloadLarge"};
+};
+
+template <bool IsMultithreaded>
+using BlockLocalPoolBackend = PoolBackend<IsMultithreaded, PoolAllocatorPolicy::BlockLocalFreeLists>;
+
+/**
+ * A growable LinearAllocator. Frees are no-ops, and a single threaded workload releases the allocator whenever its last live allocation
+ * is freed. Other threads may be allocating at that point, so a multithreaded workload never releases it
+ */
+template <bool IsMultithreaded>
+class LinearBackend
+{
+  public:
+    static constexpr bool RequiresLifoOrder = false;
+    static constexpr bool SupportsThreads   = true;
+
+    static constexpr LinearAllocatorSettings settings = {
+        .policy = LinearAllocatorPolicy::Release | LinearAllocatorPolicy::Growable | LinearAllocatorPolicy::SizeTracking |
+                  (IsMultithreaded ? LinearAllocatorPolicy::Multithreaded : LinearAllocatorPolicy::Empty)};
+
+    explicit LinearBackend(const BackendOptions& options) : m_LinearAllocator(options.blockSize, "Workload") {}
+
+    [[nodiscard]] void* Allocate(const Size size)
+    {
+        if constexpr (!IsMultithreaded)
+        {
+            m_LiveCount++;
+        }
+        return m_LinearAllocator.Allocate(size);
+    }
+
+    void Deallocate(void* /*ptr*/, const Size /*size*/)
+    {
+        if constexpr (!IsMultithreaded)
+        {
+            if (--m_LiveCount == 0)
+            {
+                m_LinearAllocator.Release();
+            }
+        }
+    }
+
+    [[nodiscard]] std::optional<Size> GetFootprint() const { return m_LinearAllocator.GetTotalSize(); }
+
+  private:
+    LinearAllocator<settings> m_LinearAllocator;
+    Size                      m_LiveCount = 0;
+};
+
+// A StackAllocator of a fixed size, which only supports LIFO frees from a single thread
+template <bool IsMultithreaded>
+class StackBackend
+{
+  public:
+    static constexpr bool RequiresLifoOrder = true;
+    static constexpr bool SupportsThreads   = false;
+
+    static constexpr StackAllocatorSettings settings = {.policy = StackAllocatorPolicy::Release | StackAllocatorPolicy::SizeTracking};
+
+    explicit StackBackend(const BackendOptions& options) : m_StackAllocator(options.arenaSize, "Workload") {}
+
+    [[nodiscard]] void* Allocate(const Size size) { return m_StackAllocator.Allocate(size); }
+    void                Deallocate(void* ptr, const Size /*size*/) { m_StackAllocator.Deallocate(ptr); }
+
+    [[nodiscard]] std::optional<Size> GetFootprint() const { return m_StackAllocator.GetTotalSize(); }
+
+  private:
+    StackAllocator<settings> m_StackAllocator;
+};
+
+} // namespace Memarena::Workload
@@ -0,0 +1,213 @@
+#pragma once
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+namespace Memarena::Workload
+{
+
+/**
+ * A distribution of positive integers, used for the allocation sizes in bytes and the lifetimes in allocations. It's parsed from a
+ * specification of the form `kind:parameters`:
+ *   fixed:value
+ *   uniform:min:max
+ *   lognormal:mu:sigma    the exponential of a normal distribution, so mu and sigma are in log space
+ *   exponential:mean
+ *   pareto:scale:shape    heavy tailed, every value is at least the scale
+ *   histogram:path        a file with a `value weight` pair per line, `#` starts a comment
+ *
+ * Draws are rounded and at least 1. A distribution keeps the state of the standard distributions, so every thread needs its own copy.
+ */
+class Distribution
+{
+  public:
+    [[nodiscard]] static std::optional<Distribution> Parse(const std::string& specification, std::string& error)
+    {
+        const std::vector<std::string> fields = Split(specification, ':');
+
+        Distribution distribution;
+        distribution.m_Specification = specification;
+
+        const std::string& kind = fields[0];
+        if (kind == "histogram")
+        {
+            if (fields.size() != 2)
+            {
+                error = "expected histogram:path";
+                return std::nullopt;
+            }
+
+            distribution.m_Kind = Kind::Histogram;
+            if (!distribution.LoadHistogram(fields[1], error))
+            {
+                return std::nullopt;
+            }
+            return distribution;
+        }
+
+        std::vector<double> parameters;
+        for (Size i = 1; i < fields.size(); i++)
+        {
+            double parameter = 0.0;
+            const auto [end, errorCode] = std::from_chars(fields[i].data(), fields[i].data() + fields[i].size(), parameter);
+            if (errorCode != std::errc() || end != fields[i].data() + fields[i].size())
+            {
+                error = "'" + fields[i] + "' is not a number";
+                return std::nullopt;
+            }
+            parameters.push_back(parameter);
+        }
+
+        if (kind == "fixed" && parameters.size() == 1 && parameters[0] >= 1.0)
+        {
+            distribution.m_Kind = Kind::Fixed;
+        }
+        else if (kind == "uniform" && parameters.size() == 2 && parameters[0] >= 1.0 && parameters[0] <= parameters[1])
+        {
+            distribution.m_Kind = Kind::Uniform;
+            distribution.m_Uniform =
+                std::uniform_int_distribution<Size>(static_cast<Size>(parameters[0]), static_cast<Size>(parameters[1]));
+        }
+        else if (kind == "lognormal" && parameters.size() == 2 && parameters[1] > 0.0)
+        {
+            distribution.m_Kind      = Kind::LogNormal;
+            distribution.m_LogNormal = std::lognormal_distribution<double>(parameters[0], parameters[1]);
+        }
+        else if (kind == "exponential" && parameters.size() == 1 && parameters[0] > 0.0)
+        {
+            distribution.m_Kind        = Kind::Exponential;
+            distribution.m_Exponential = std::exponential_distribution<double>(1.0 / parameters[0]);
+        }
+        else if (kind == "pareto" && parameters.size() == 2 && parameters[0] > 0.0 && parameters[1] > 0.0)
+        {
+            distribution.m_Kind = Kind::Pareto;
+        }
+        else
+        {
+            error = "invalid distribution '" + specification + "'";
+            return std::nullopt;
+        }
+
+        distribution.m_Parameters = parameters;
+        return distribution;
+    }
+
+    [[nodiscard]] Size Draw(std::mt19937_64& engine)
+    {
+        switch (m_Kind)
+        {
+        case Kind::Fixed:
+            return static_cast<Size>(m_Parameters[0]);
+        case Kind::Uniform:
+            return m_Uniform(engine);
+        case Kind::LogNormal:
+            return ToSize(m_LogNormal(engine));
+        case Kind::Exponential:
+            return ToSize(m_Exponential(engine));
+        case Kind::Pareto:
+        {
+            const double uniform = 1.0 - m_UnitUniform(engine);
+            return ToSize(m_Parameters[0] / std::pow(uniform, 1.0 / m_Parameters[1]));
+        }
+        default:
+            return m_HistogramValues[m_Histogram(engine)];
+        }
+    }
+
+    [[nodiscard]] const std::string& GetSpecification() const { return m_Specification; }
+
+  private:
+    enum class Kind
+    {
+        Fixed,
+        Uniform,
+        LogNormal,
+        Exponential,
+        Pareto,
+        Histogram
+    };
+
+    // Caps the heavy tails so a draw always fits in a Size
+    static constexpr double MaxValue = 1e15;
+
+    [[nodiscard]] static Size ToSize(const double value) { return static_cast<Size>(std::clamp(std::round(value), 1.0, MaxValue)); }
+
+    [[nodiscard]] static std::vector<std::string> Split(const std::string& text, const char separator)
+    {
+        std::vector<std::string> fields;
+        std::stringstream        stream(text);
+        std::string              field;
+        while (std::getline(stream, field, separator))
+        {
+            fields.push_back(field);
+        }
+        if (fields.empty())
+        {
+            fields.emplace_back();
+        }
+        return fields;
+    }
+
+    bool LoadHistogram(const std::string& path, std::string& error)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            error = "can't open the histogram '" + path + "'";
+            return false;
+        }
+
+        std::vector<double> weights;
+        std::string         line;
+        for (Size lineNumber = 1; std::getline(file, line); lineNumber++)
+        {
+            line = line.substr(0, line.find('#'));
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+            {
+                continue;
+            }
+
+            std::istringstream lineStream(line);
+            double             value  = 0.0;
+            double             weight = 0.0;
+            if (!(lineStream >> value >> weight) || value < 1.0 || weight < 0.0)
+            {
+                error = path + ":" + std::to_string(lineNumber) + ": expected a value of at least 1 and a non-negative weight";
+                return false;
+            }
+
+            m_HistogramValues.push_back(ToSize(value));
+            weights.push_back(weight);
+        }
+
+        if (m_HistogramValues.empty() || std::all_of(weights.begin(), weights.end(), [](const double weight) { return weight == 0.0; }))
+        {
+            error = "the histogram '" + path + "' has no weighted values";
+            return false;
+        }
+
+        m_Histogram = std::discrete_distribution<Size>(weights.begin(), weights.end());
+        return true;
+    }
+
+    Kind                                   m_Kind = Kind::Fixed;
+    std::vector<double>                    m_Parameters;
+    std::uniform_int_distribution<Size>    m_Uniform;
+    std::lognormal_distribution<double>    m_LogNormal;
+    std::exponential_distribution<double>  m_Exponential;
+    std::uniform_real_distribution<double> m_UnitUniform{0.0, 1.0};
+    std::discrete_distribution<Size>       m_Histogram;
+    std::vector<Size>                      m_HistogramValues;
+    std::string                            m_Specification;
+};
+
+} // namespace Memarena::Workload
@@ -0,0 +1,662 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <barrier>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    #include <malloc.h>
+    #define MEMARENA_HAS_MALLINFO2
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+    #include <sys/resource.h>
+    #define MEMARENA_HAS_GETRUSAGE
+#endif
+
+#include <Memarena/Memarena.hpp>
+
+#include "Backends.hpp"
+#include "Distribution.hpp"
+
+using namespace Memarena;
+using namespace Memarena::Workload;
+using namespace Memarena::SizeLiterals;
+
+/**
+ * Runs a synthetic allocation workload described on the command line against one of the allocators, to model a traffic pattern without
+ * writing a benchmark for it. Every thread allocates `--ops` times, drawing the sizes from the size distribution, and frees its live
+ * allocations in the selected order:
+ *   lifo, fifo, random  keep `--live` allocations per thread alive and free one whenever a new one exceeds them
+ *   lifetime            free every allocation after a number of allocations of its thread drawn from the lifetime distribution
+ *
+ * A share of the frees, `--cross-thread`, is handed to another thread which frees the allocation the next time it allocates, like
+ * objects passed between a producer and a consumer. Every `--sample-every` operations the allocation or free is timed for the latency
+ * percentiles, the timing itself adds a few tens of nanoseconds to every sample. The throughput counts all the operations of the run,
+ * including drawing the workload.
+ *
+ * The footprint is taken when all the threads finished allocating, before the remaining live allocations are freed.
+ */
+
+namespace
+{
+
+using Clock = std::chrono::steady_clock;
+
+enum class FreeOrder
+{
+    Lifo,
+    Fifo,
+    Random,
+    Lifetime
+};
+
+struct WorkloadOptions
+{
+    std::string                 allocator        = "pool";
+    std::optional<Distribution> sizes;
+    std::optional<Distribution> lifetimes;
+    FreeOrder                   order            = FreeOrder::Random;
+    Size                        liveCount        = 1000;
+    Size                        operationCount   = 1'000'000;
+    Size                        threadCount      = 1;
+    double                      crossThreadRatio = 0.0;
+    Size                        sampleInterval   = 16;
+    UInt64                      seed             = 42;
+    BackendOptions              backendOptions   = {.blockSize = 64_KiB, .arenaSize = 256_MiB};
+};
+
+constexpr const char* usage = R"(Usage: MemarenaWorkloadGenerator [--option=value]...
+
+  --allocator=NAME      malloc, pmr, mallocator, pool, pool-blocklocal, linear or stack (default pool)
+  --size=DIST           allocation sizes in bytes (default lognormal:4.5:1)
+  --order=ORDER         lifo, fifo, random or lifetime (default random)
+  --live=N              live allocations per thread for lifo, fifo and random (default 1000)
+  --lifetime=DIST       lifetimes in allocations of the thread for the lifetime order (default exponential:1000)
+  --ops=N               allocations per thread (default 1000000)
+  --threads=N           threads sharing the allocator (default 1)
+  --cross-thread=RATIO  share of the frees done by another thread (default 0)
+  --sample-every=N      time every Nth allocation and free, 0 disables the latencies (default 16)
+  --seed=N              seed of the workload (default 42)
+  --block-size=BYTES    block size of the pool and linear allocators (default 65536)
+  --arena-size=BYTES    size of the stack allocator (default 268435456)
+
+DIST is one of fixed:N, uniform:MIN:MAX, lognormal:MU:SIGMA, exponential:MEAN, pareto:SCALE:SHAPE or histogram:PATH, where the
+histogram file has a "value weight" pair per line.
+)";
+
+template <typename Value>
+bool ParseNumber(const std::string& text, Value& value)
+{
+    const auto [end, errorCode] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return errorCode == std::errc() && end == text.data() + text.size();
+}
+
+std::optional<WorkloadOptions> ParseOptions(const int argc, char** argv)
+{
+    WorkloadOptions options;
+    std::string     error;
+    std::string     sizeSpecification     = "lognormal:4.5:1";
+    std::string     lifetimeSpecification = "exponential:1000";
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string argument = argv[i];
+        const Size        equals   = argument.find('=');
+        const std::string key      = argument.substr(0, equals);
+        const std::string value    = equals == std::string::npos ? "" : argument.substr(equals + 1);
+
+        bool isValid = true;
+        if (key == "--allocator")
+        {
+            options.allocator = value;
+        }
+        else if (key == "--size")
+        {
+            sizeSpecification = value;
+        }
+        else if (key == "--lifetime")
+        {
+            lifetimeSpecification = value;
+        }
+        else if (key == "--order")
+        {
+            const std::array<std::pair<const char*, FreeOrder>, 4> orders = {
+                {{"lifo", FreeOrder::Lifo}, {"fifo", FreeOrder::Fifo}, {"random", FreeOrder::Random}, {"lifetime", FreeOrder::Lifetime}}};
+            const auto order = std::find_if(orders.begin(), orders.end(), [&](const auto& entry) { return value == entry.first; });
+            isValid          = order != orders.end();
+            options.order    = isValid ? order->second : options.order;
+        }
+        else if (key == "--live")
+        {
+            isValid = ParseNumber(value, options.liveCount);
+        }
+        else if (key == "--ops")
+        {
+            isValid = ParseNumber(value, options.operationCount);
+        }
+        else if (key == "--threads")
+        {
+            isValid = ParseNumber(value, options.threadCount) && options.threadCount > 0;
+        }
+        else if (key == "--cross-thread")
+        {
+            isValid = ParseNumber(value, options.crossThreadRatio) && options.crossThreadRatio >= 0.0 && options.crossThreadRatio <= 1.0;
+        }
+        else if (key == "--sample-every")
+        {
+            isValid = ParseNumber(value, options.sampleInterval);
+        }
+        else if (key == "--seed")
+        {
+            isValid = ParseNumber(value, options.seed);
+        }
+        else if (key == "--block-size")
+        {
+            isValid = ParseNumber(value, options.backendOptions.blockSize) && options.backendOptions.blockSize > 0;
+        }
+        else if (key == "--arena-size")
+        {
+            isValid = ParseNumber(value, options.backendOptions.arenaSize) && options.backendOptions.arenaSize > 0;
+        }
+        else if (key == "--help" || key == "-h")
+        {
+            std::printf("%s", usage);
+            std::exit(0);
+        }
+        else
+        {
+            std::fprintf(stderr, "Unknown option '%s'\n\n%s", argument.c_str(), usage);
+            return std::nullopt;
+        }
+
+        if (!isValid)
+        {
+            std::fprintf(stderr, "Invalid value '%s' for %s\n", value.c_str(), key.c_str());
+            return std::nullopt;
+        }
+    }
+
+    options.sizes = Distribution::Parse(sizeSpecification, error);
+    if (options.sizes.has_value() && options.order == FreeOrder::Lifetime)
+    {
+        options.lifetimes = Distribution::Parse(lifetimeSpecification, error);
+    }
+
+    if (!options.sizes.has_value() || (options.order == FreeOrder::Lifetime && !options.lifetimes.has_value()))
+    {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return std::nullopt;
+    }
+
+    if (options.threadCount == 1 && options.crossThreadRatio > 0.0)
+    {
+        std::fprintf(stderr, "A cross-thread ratio needs more than one thread\n");
+        return std::nullopt;
+    }
+
+    return options;
+}
+
+const char* ToString(const FreeOrder order)
+{
+    switch (order)
+    {
+    case FreeOrder::Lifo:
+        return "lifo";
+    case FreeOrder::Fifo:
+        return "fifo";
+    case FreeOrder::Random:
+        return "random";
+    default:
+        return "lifetime";
+    }
+}
+
+struct LiveAllocation
+{
+    void*  ptr;
+    Size   size;
+    UInt64 expiry; // The allocation count of the thread at which it's freed, only used by the lifetime order
+};
+
+// The live allocations of a thread, in the order they are freed
+class LiveSet
+{
+  public:
+    explicit LiveSet(const FreeOrder order) : m_Order(order) {}
+
+    void Push(const LiveAllocation& allocation)
+    {
+        m_Allocations.push_back(allocation);
+        if (m_Order == FreeOrder::Lifetime)
+        {
+            std::push_heap(m_Allocations.begin(), m_Allocations.end(), ExpiresLater);
+        }
+    }
+
+    [[nodiscard]] bool HasExpired(const UInt64 allocationCount, const Size liveCount) const
+    {
+        if (m_Order == FreeOrder::Lifetime)
+        {
+            return !m_Allocations.empty() && m_Allocations.front().expiry <= allocationCount;
+        }
+        return m_Allocations.size() > liveCount;
+    }
+
+    [[nodiscard]] LiveAllocation Pop(std::mt19937_64& engine)
+    {
+        switch (m_Order)
+        {
+        case FreeOrder::Lifo:
+            break;
+        case FreeOrder::Fifo:
+        {
+            const LiveAllocation allocation = m_Allocations.front();
+            m_Allocations.pop_front();
+            return allocation;
+        }
+        case FreeOrder::Random:
+            std::swap(m_Allocations[std::uniform_int_distribution<Size>(0, m_Allocations.size() - 1)(engine)], m_Allocations.back());
+            break;
+        case FreeOrder::Lifetime:
+            std::pop_heap(m_Allocations.begin(), m_Allocations.end(), ExpiresLater);
+            break;
+        }
+
+        const LiveAllocation allocation = m_Allocations.back();
+        m_Allocations.pop_back();
+        return allocation;
+    }
+
+    [[nodiscard]] bool IsEmpty() const { return m_Allocations.empty(); }
+
+  private:
+    static bool ExpiresLater(const LiveAllocation& first, const LiveAllocation& second) { return first.expiry > second.expiry; }
+
+    FreeOrder                  m_Order;
+    std::deque<LiveAllocation> m_Allocations;
+};
+
+// The allocations other threads handed to a thread to free
+struct Mailbox
+{
+    std::mutex                  mutex;
+    std::vector<LiveAllocation> allocations;
+    std::atomic<bool>           hasAllocations = false;
+};
+
+struct alignas(64) ThreadState
+{
+    std::vector<UInt64> allocateLatencies;
+    std::vector<UInt64> deallocateLatencies;
+    Size                allocationCount   = 0;
+    Size                deallocationCount = 0;
+    Int64               liveSize          = 0; // Frees of other threads' allocations make it negative
+    bool                hasFailed         = false;
+    Mailbox             mailbox;
+};
+
+struct Footprint
+{
+    Size                liveSize;
+    std::optional<Size> allocatorSize;
+    std::optional<Size> mallocSize;
+};
+
+std::optional<Size> GetMallocFootprint()
+{
+#ifdef MEMARENA_HAS_MALLINFO2
+    const struct mallinfo2 info = mallinfo2();
+    return info.arena + info.hblkhd;
+#else
+    return std::nullopt;
+#endif
+}
+
+std::optional<Size> GetPeakResidentSize()
+{
+#ifdef MEMARENA_HAS_GETRUSAGE
+    struct rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    #ifdef __APPLE__
+    return static_cast<Size>(usage.ru_maxrss);
+    #else
+    return static_cast<Size>(usage.ru_maxrss) * 1024;
+    #endif
+#else
+    return std::nullopt;
+#endif
+}
+
+template <typename Backend>
+class WorkloadRunner
+{
+  public:
+    explicit WorkloadRunner(const WorkloadOptions& options)
+        : m_Options(options), m_Backend(options.backendOptions), m_ThreadStates(options.threadCount)
+    {
+    }
+
+    void Run()
+    {
+        std::barrier startBarrier(static_cast<std::ptrdiff_t>(m_Options.threadCount), [this]() noexcept { m_StartTime = Clock::now(); });
+        std::barrier endBarrier(static_cast<std::ptrdiff_t>(m_Options.threadCount), [this]() noexcept { OnWorkloadEnd(); });
+
+        std::vector<std::thread> threads;
+        for (Size threadIndex = 0; threadIndex < m_Options.threadCount; threadIndex++)
+        {
+            threads.emplace_back([&, threadIndex]() { RunThread(threadIndex, startBarrier, endBarrier); });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    [[nodiscard]] const std::vector<ThreadState>& GetThreadStates() const { return m_ThreadStates; }
+    [[nodiscard]] Clock::duration                 GetDuration() const { return m_EndTime - m_StartTime; }
+    [[nodiscard]] const Footprint&                GetFootprint() const { return m_Footprint; }
+
+  private:
+    template <typename StartBarrier, typename EndBarrier>
+    void RunThread(const Size threadIndex, StartBarrier& startBarrier, EndBarrier& endBarrier)
+    {
+        ThreadState&    state = m_ThreadStates[threadIndex];
+        std::mt19937_64 engine(m_Options.seed + threadIndex);
+        Distribution    sizes     = *m_Options.sizes;
+        Distribution    lifetimes = m_Options.lifetimes.value_or(sizes);
+        LiveSet         liveSet(m_Options.order);
+
+        std::uniform_real_distribution<double> unitUniform(0.0, 1.0);
+        std::uniform_int_distribution<Size>    otherThread(1, std::max<Size>(m_Options.threadCount, 2) - 1);
+
+        const Size sampleCount = m_Options.sampleInterval > 0 ? m_Options.operationCount / m_Options.sampleInterval + 1 : 0;
+        state.allocateLatencies.reserve(sampleCount);
+        state.deallocateLatencies.reserve(sampleCount);
+
+        const auto deallocate = [&](const LiveAllocation& allocation)
+        {
+            if (m_Options.crossThreadRatio > 0.0 && unitUniform(engine) < m_Options.crossThreadRatio)
+            {
+                Mailbox& mailbox = m_ThreadStates[(threadIndex + otherThread(engine)) % m_Options.threadCount].mailbox;
+
+                const std::lock_guard<std::mutex> guard(mailbox.mutex);
+                mailbox.allocations.push_back(allocation);
+                mailbox.hasAllocations.store(true, std::memory_order_release);
+                return;
+            }
+            Deallocate(state, allocation);
+        };
+
+        startBarrier.arrive_and_wait();
+
+        for (UInt64 allocationIndex = 0; allocationIndex < m_Options.operationCount && !state.hasFailed; allocationIndex++)
+        {
+            DrainMailbox(state);
+
+            const Size size = sizes.Draw(engine);
+            void*      ptr  = nullptr;
+            if (ShouldSample(state.allocationCount))
+            {
+                const Clock::time_point start = Clock::now();
+                ptr                           = m_Backend.Allocate(size);
+                state.allocateLatencies.push_back(ToNanoseconds(Clock::now() - start));
+            }
+            else
+            {
+                ptr = m_Backend.Allocate(size);
+            }
+
+            if (ptr == nullptr)
+            {
+                state.hasFailed = true;
+                break;
+            }
+
+            // Touches the allocation like a constructor would, which also makes the pages resident
+            *static_cast<volatile char*>(ptr) = 1;
+            state.allocationCount++;
+            state.liveSize += static_cast<Int64>(size);
+
+            const UInt64 expiry = m_Options.order == FreeOrder::Lifetime ? allocationIndex + lifetimes.Draw(engine) : 0;
+            liveSet.Push({.ptr = ptr, .size = size, .expiry = expiry});
+
+            while (liveSet.HasExpired(allocationIndex, m_Options.liveCount))
+            {
+                deallocate(liveSet.Pop(engine));
+            }
+        }
+
+        // No thread hands over allocations after the end barrier, so the mailboxes can be drained for the last time
+        endBarrier.arrive_and_wait();
+
+        while (!liveSet.IsEmpty())
+        {
+            Deallocate(state, liveSet.Pop(engine));
+        }
+        DrainMailbox(state);
+    }
+
+    void Deallocate(ThreadState& state, const LiveAllocation& allocation)
+    {
+        if (ShouldSample(state.deallocationCount))
+        {
+            const Clock::time_point start = Clock::now();
+            m_Backend.Deallocate(allocation.ptr, allocation.size);
+            state.deallocateLatencies.push_back(ToNanoseconds(Clock::now() - start));
+        }
+        else
+        {
+            m_Backend.Deallocate(allocation.ptr, allocation.size);
+        }
+
+        state.deallocationCount++;
+        state.liveSize -= static_cast<Int64>(allocation.size);
+    }
+
+    void DrainMailbox(ThreadState& state)
+    {
+        if (!state.mailbox.hasAllocations.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        std::vector<LiveAllocation> allocations;
+        {
+            const std::lock_guard<std::mutex> guard(state.mailbox.mutex);
+            allocations.swap(state.mailbox.allocations);
+            state.mailbox.hasAllocations.store(false, std::memory_order_relaxed);
+        }
+
+        for (const LiveAllocation& allocation : allocations)
+        {
+            Deallocate(state, allocation);
+        }
+    }
+
+    // Runs on the last thread to arrive, while the others wait
+    void OnWorkloadEnd()
+    {
+        m_EndTime = Clock::now();
+
+        Int64 liveSize = 0;
+        for (const ThreadState& state : m_ThreadStates)
+        {
+            liveSize += state.liveSize;
+        }
+
+        m_Footprint = {
+            .liveSize = static_cast<Size>(liveSize), .allocatorSize = m_Backend.GetFootprint(), .mallocSize = GetMallocFootprint()};
+    }
+
+    [[nodiscard]] bool ShouldSample(const Size operationIndex) const
+    {
+        return m_Options.sampleInterval > 0 && operationIndex % m_Options.sampleInterval == 0;
+    }
+
+    [[nodiscard]] static UInt64 ToNanoseconds(const Clock::duration duration)
+    {
+        return static_cast<UInt64>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+    }
+
+    const WorkloadOptions&   m_Options;
+    Backend                  m_Backend;
+    std::vector<ThreadState> m_ThreadStates;
+    Clock::time_point        m_StartTime;
+    Clock::time_point        m_EndTime;
+    Footprint                m_Footprint = {};
+};
+
+void PrintSize(const char* label, const std::optional<Size> size)
+{
+    if (size.has_value())
+    {
+        std::printf("  %-16s %10.2f MiB\n", label, static_cast<double>(*size) / static_cast<double>(1_MiB));
+    }
+    else
+    {
+        std::printf("  %-16s %14s\n", label, "n/a");
+    }
+}
+
+void PrintLatencies(const char* label, std::vector<UInt64>& latencies)
+{
+    if (latencies.empty())
+    {
+        std::printf("  %-16s %8s\n", label, "n/a");
+        return;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    const auto percentile = [&](const double fraction)
+    { return latencies[std::min(static_cast<Size>(fraction * static_cast<double>(latencies.size())), latencies.size() - 1)]; };
+
+    std::printf("  %-16s %8llu %8llu %8llu %8llu %8llu\n", label, static_cast<unsigned long long>(percentile(0.5)),
+                static_cast<unsigned long long>(percentile(0.9)), static_cast<unsigned long long>(percentile(0.99)),
+                static_cast<unsigned long long>(percentile(0.999)), static_cast<unsigned long long>(latencies.back()));
+}
+
+template <typename Backend>
+int RunWorkload(const WorkloadOptions& options)
+{
+    if (Backend::RequiresLifoOrder && options.order != FreeOrder::Lifo)
+    {
+        std::fprintf(stderr, "The %s allocator only supports --order=lifo\n", options.allocator.c_str());
+        return 1;
+    }
+    if (!Backend::SupportsThreads && options.threadCount > 1)
+    {
+        std::fprintf(stderr, "The %s allocator only supports a single thread\n", options.allocator.c_str());
+        return 1;
+    }
+
+    WorkloadRunner<Backend> runner(options);
+    runner.Run();
+
+    Size                allocationCount   = 0;
+    Size                deallocationCount = 0;
+    bool                hasFailed         = false;
+    std::vector<UInt64> allocateLatencies;
+    std::vector<UInt64> deallocateLatencies;
+    for (const ThreadState& state : runner.GetThreadStates())
+    {
+        allocationCount   += state.allocationCount;
+        deallocationCount += state.deallocationCount;
+        hasFailed         |= state.hasFailed;
+        allocateLatencies.insert(allocateLatencies.end(), state.allocateLatencies.begin(), state.allocateLatencies.end());
+        deallocateLatencies.insert(deallocateLatencies.end(), state.deallocateLatencies.begin(), state.deallocateLatencies.end());
+    }
+
+    const double seconds = std::chrono::duration<double>(runner.GetDuration()).count();
+
+    std::printf("allocator          %s (%s)\n", options.allocator.c_str(), options.threadCount > 1 ? "multithreaded" : "single threaded");
+    std::printf("sizes              %s\n", options.sizes->GetSpecification().c_str());
+    if (options.order == FreeOrder::Lifetime)
+    {
+        std::printf("order              lifetime %s\n", options.lifetimes->GetSpecification().c_str());
+    }
+    else
+    {
+        std::printf("order              %s, %zu live per thread\n", ToString(options.order), options.liveCount);
+    }
+    std::printf("threads            %zu, %.0f%% of the frees cross-thread\n", options.threadCount, options.crossThreadRatio * 100.0);
+    std::printf("operations         %zu allocations, %zu frees in %.3f s\n", allocationCount, deallocationCount, seconds);
+    std::printf("throughput         %.2f Mops/s\n", static_cast<double>(allocationCount + deallocationCount) / seconds / 1e6);
+    std::printf("latency (ns)            p50      p90      p99    p99.9      max\n");
+    PrintLatencies("allocate", allocateLatencies);
+    PrintLatencies("free", deallocateLatencies);
+    std::printf("footprint\n");
+    PrintSize("live", runner.GetFootprint().liveSize);
+    PrintSize("allocator", runner.GetFootprint().allocatorSize);
+    PrintSize("malloc heap", runner.GetFootprint().mallocSize);
+    PrintSize("peak resident", GetPeakResidentSize());
+
+    if (hasFailed)
+    {
+        std::fprintf(stderr, "The allocator ran out of memory, the workload stopped early\n");
+        return 1;
+    }
+    return 0;
+}
+
+template <template <bool> typename Backend>
+int RunWorkload(const WorkloadOptions& options)
+{
+    return options.threadCount > 1 ? RunWorkload<Backend<true>>(options) : RunWorkload<Backend<false>>(options);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    const std::optional<WorkloadOptions> options = ParseOptions(argc, argv);
+    if (!options.has_value())
+    {
+        return 1;
+    }
+
+    const std::string& allocator = options->allocator;
+    if (allocator == "malloc")
+    {
+        return RunWorkload<MallocBackend>(*options);
+    }
+    if (allocator == "pmr")
+    {
+        return RunWorkload<PmrPoolBackend>(*options);
+    }
+    if (allocator == "mallocator")
+    {
+        return RunWorkload<MallocatorBackend>(*options);
+    }
+    if (allocator == "pool")
+    {
+        return RunWorkload<PoolBackend>(*options);
+    }
+    if (allocator == "pool-blocklocal")
+    {
+        return RunWorkload<BlockLocalPoolBackend>(*options);
+    }
+    if (allocator == "linear")
+    {
+        return RunWorkload<LinearBackend>(*options);
+    }
+    if (allocator == "stack")
+    {
+        return RunWorkload<StackBackend>(*options);
+    }
+
+    std::fprintf(stderr, "Unknown allocator '%s'\n\n%s", allocator.c_str(), usage);
+    return 1;
+}
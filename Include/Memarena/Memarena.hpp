@@ -2,8 +2,15 @@
 
 #include "Source/Macros.hpp"
 
+#include "BufferChain.hpp"
 #include "FallbackAllocator.hpp"
+#include "FrameAllocator.hpp"
+#include "InternTable.hpp"
+#include "IOBufferPool.hpp"
 #include "LinearAllocator.hpp"
 #include "Mallocator.hpp"
+#include "ObjectCache.hpp"
 #include "PoolAllocator.hpp"
 #include "StackAllocator.hpp"
+#include "TypedPools.hpp"
+#include "VirtualVector.hpp"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "Source/Allocators/ObjectCache/ObjectCache.hpp"
@@ -0,0 +1,3 @@
+#pragma once
+
+#include "Source/Allocators/VirtualVector/VirtualVector.hpp"
@@ -1,4 +1,3 @@
-#include "Allocators/Mallocator/Mallocator.hpp"
 #include "PCH.hpp"
 
 #include "Allocator.hpp"
@@ -11,16 +10,17 @@
 
 namespace Memarena
 {
-Allocator::Allocator(Size totalSize, const std::string& debugName, bool isBaseAllocator)
+Allocator::Allocator(Size totalSize, const std::string& debugName, bool isBaseAllocator, Size maxTotalSize)
 {
-    MEMARENA_DEFAULT_ASSERT(totalSize <= std::numeric_limits<Offset>::max(),
-                            "Error: Max size of allocator cannot be more than %u! Value passed was %u.\n",
-                            std::numeric_limits<Offset>::max(), totalSize);
+    MEMARENA_DEFAULT_ASSERT(totalSize <= maxTotalSize, "Error: Max size of allocator cannot be more than %zu! Value passed was %zu.\n",
+                            maxTotalSize, totalSize);
 
     MEMARENA_DEFAULT_ASSERT(totalSize >= 0, "Error: Max size of allocator must be >= 0! Value passed was %d", totalSize);
 
-    m_Data =
-        std::make_shared<AllocatorData>(AllocatorData{.debugName = debugName, .totalSize = totalSize, .isBaseAllocator = isBaseAllocator});
+    m_Data                  = std::make_shared<AllocatorData>();
+    m_Data->debugName       = debugName;
+    m_Data->isBaseAllocator = isBaseAllocator;
+    m_Data->totalSize.store(totalSize, std::memory_order_relaxed);
 
     MemoryTracker::RegisterAllocator(m_Data);
 }
@@ -29,25 +29,36 @@ Allocator::~Allocator() { MemoryTracker::UnRegisterAllocator(m_Data); }
 
 void Allocator::SetUsedSize(Size size)
 {
-    m_Data->usedSize  = size;
-    m_Data->peakUsage = std::max(m_Data->peakUsage, m_Data->usedSize);
+    m_Data->usedSize.store(size, std::memory_order_relaxed);
+    if (size > m_Data->peakUsage.load(std::memory_order_relaxed))
+    {
+        m_Data->peakUsage.store(size, std::memory_order_relaxed);
+    }
 }
 
 void Allocator::SetTotalSize(Size size)
 {
-    m_Data->totalSize = size;
+    m_Data->totalSize.store(size, std::memory_order_relaxed);
     MemoryTracker::InvalidateTotalAllocatedSizeCache();
 }
 
 void Allocator::AddAllocation(const Size size, const std::string& category, const SourceLocation& sourceLocation)
 {
     m_Data->allocations.push_back({sourceLocation, category, size});
-    m_Data->allocationCount++;
+    m_Data->allocationCount.store(m_Data->allocationCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
 }
 
-constexpr MallocatorSettings defaultAllocatorSettings = {.policy = MallocatorPolicy::Default};
+void Allocator::RecordBaseAllocator(const Allocator* baseAllocator)
+{
+    if (baseAllocator != nullptr)
+    {
+        MemoryTracker::SetParent(m_Data, baseAllocator->m_Data, AllocatorRelation::BaseAllocator);
+    }
+}
 
-const std::shared_ptr<Allocator> Allocator::m_DefaultAllocator =
-    std::make_shared<Mallocator<defaultAllocatorSettings>>("DefaultMallocator");
+void Allocator::RecordWrappedAllocator(const Allocator& child)
+{
+    MemoryTracker::SetParent(child.m_Data, m_Data, AllocatorRelation::Wrapped);
+}
 
 } // namespace Memarena
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <concepts>
+#include <limits>
 #include <memory>
 #include <numeric>
 #include <string>
@@ -7,6 +9,7 @@
 #include "Pointer.hpp"
 #include "Source/AllocatorData.hpp"
 #include "Source/Assert.hpp"
+#include "Source/HeapProfiler.hpp"
 #include "Source/MemoryTracker.hpp"
 #include "Source/Policies/MultithreadedPolicy.hpp"
 #include "Source/TypeAliases.hpp"
@@ -28,35 +31,120 @@ class Allocator
 
     ~Allocator();
 
-    [[nodiscard]] inline Size        GetUsedSize() const { return m_Data->usedSize; }
-    [[nodiscard]] inline Size        GetTotalSize() const { return m_Data->totalSize; }
-    [[nodiscard]] inline Size        GetPeakUsedSize() const { return m_Data->peakUsage; }
-    [[nodiscard]] inline UInt32      GetAllocationCount() const { return m_Data->allocationCount; }
-    [[nodiscard]] inline UInt32      GetDeallocationCount() const { return m_Data->deallocationCount; }
+    [[nodiscard]] inline Size        GetUsedSize() const { return m_Data->usedSize.load(std::memory_order_relaxed); }
+    [[nodiscard]] inline Size        GetTotalSize() const { return m_Data->totalSize.load(std::memory_order_relaxed); }
+    [[nodiscard]] inline Size        GetPeakUsedSize() const { return m_Data->peakUsage.load(std::memory_order_relaxed); }
+    [[nodiscard]] inline UInt32      GetAllocationCount() const { return m_Data->allocationCount.load(std::memory_order_relaxed); }
+    [[nodiscard]] inline UInt32      GetDeallocationCount() const { return m_Data->deallocationCount.load(std::memory_order_relaxed); }
     [[nodiscard]] inline std::string GetDebugName() const { return m_Data->debugName; }
 
     [[nodiscard]] inline const std::vector<AllocationData>& GetAllocations() const { return m_Data->allocations; }
 
-    [[nodiscard]] static std::shared_ptr<Allocator> GetDefaultAllocator() { return m_DefaultAllocator; }
+    [[nodiscard]] static const std::shared_ptr<Allocator>& GetDefaultAllocator() { return m_DefaultAllocator; }
 
     NO_DISCARD virtual void* AllocateBase(Size /*size*/) { return nullptr; }
-    virtual void             DeallocateBase(void* ptr) {}
+    virtual void             DeallocateBase(void* /*ptr*/, Size /*size*/) {}
 
   protected:
-    Allocator(Size totalSize, const std::string& debugName, bool isBaseAllocator = false);
+    // `maxTotalSize` is the largest size the offsets of the derived allocator can address
+    Allocator(Size totalSize, const std::string& debugName, bool isBaseAllocator = false,
+              Size maxTotalSize = std::numeric_limits<Offset>::max());
 
     void        SetUsedSize(Size size);
-    inline void IncreaseUsedSize(Size size) { SetUsedSize(m_Data->usedSize + size); }
-    inline void DecreaseUsedSize(Size size) { m_Data->usedSize -= size; }
+    inline void IncreaseUsedSize(Size size) { SetUsedSize(GetUsedSize() + size); }
+    inline void DecreaseUsedSize(Size size) { m_Data->usedSize.store(GetUsedSize() - size, std::memory_order_relaxed); }
     void        SetTotalSize(Size size);
-    inline void IncreaseTotalSize(Size size) { SetTotalSize(m_Data->totalSize + size); }
-    inline void DecreaseTotalSize(Size size) { SetTotalSize(m_Data->totalSize - size); }
+    inline void IncreaseTotalSize(Size size) { SetTotalSize(GetTotalSize() + size); }
+    inline void DecreaseTotalSize(Size size) { SetTotalSize(GetTotalSize() - size); }
     void        AddAllocation(Size size, const std::string& category, const SourceLocation& sourceLocation = SourceLocation::current());
-    inline void AddDeallocation() { m_Data->deallocationCount++; }
+    inline void AddDeallocation() { m_Data->deallocationCount.store(GetDeallocationCount() + 1, std::memory_order_relaxed); }
+
+    // Used by allocators with the `HeapProfiling` policy. Only sampled allocations reach the HeapProfiler
+    inline void SampleAllocation(const void* ptr, const Size size)
+    {
+        if (HeapProfiler::ShouldSample(size))
+        {
+            HeapProfiler::RecordAllocation(this, ptr, size);
+        }
+    }
+    inline void SampleDeallocation(const void* ptr) { HeapProfiler::RecordDeallocation(this, ptr); }
+    inline void ReleaseSamples() { HeapProfiler::RecordRelease(this); }
+
+    // Record the edges of the MemoryTracker's allocator tree. `baseAllocator` may be null for blocks that don't come from an Allocator
+    void RecordBaseAllocator(const Allocator* baseAllocator);
+    void RecordWrappedAllocator(const Allocator& child);
 
   private:
     std::shared_ptr<AllocatorData>          m_Data;
     static const std::shared_ptr<Allocator> m_DefaultAllocator;
 };
 
+/**
+ * @brief What the arenas get their blocks from. The base allocator is a template parameter of the arena, so that growing it is a
+ * direct call
+ */
+template <typename T>
+concept BaseAllocatorType = std::copy_constructible<T> && requires(T baseAllocator, void* ptr, Size size)
+{
+    { baseAllocator.AllocateBase(size) } -> std::same_as<void*>;
+    baseAllocator.DeallocateBase(ptr, size);
+};
+
+/**
+ * @brief Gets the blocks from an `Allocator` chosen at runtime, e.g. a Mallocator with tracking enabled or a parent arena. This costs
+ * a shared_ptr in every arena and a virtual call for every block
+ */
+class SharedBase
+{
+  public:
+    SharedBase() : m_Allocator(Allocator::GetDefaultAllocator()) {}
+
+    template <std::derived_from<Allocator> BaseAllocator>
+    SharedBase(std::shared_ptr<BaseAllocator> allocator) : m_Allocator(std::move(allocator)) {} // NOLINT
+
+    NO_DISCARD void* AllocateBase(const Size size) const { return m_Allocator->AllocateBase(size); }
+    void             DeallocateBase(void* ptr, const Size size) const { m_Allocator->DeallocateBase(ptr, size); }
+
+    [[nodiscard]] const Allocator* GetAllocator() const { return m_Allocator.get(); }
+
+  private:
+    std::shared_ptr<Allocator> m_Allocator;
+};
+
+/**
+ * @brief Whether an arena may return its blocks to `BaseAllocator` in any order. Base allocators that don't declare `FreesInAnyOrder`
+ * could be a StackAllocator, so they get their blocks back in reverse order of allocation
+ */
+template <BaseAllocatorType BaseAllocator>
+constexpr bool BaseFreesInAnyOrder = requires { requires BaseAllocator::FreesInAnyOrder; };
+
+/**
+ * @brief The Allocator the blocks of an arena come from, or null if the base allocator doesn't get them from an Allocator
+ */
+template <BaseAllocatorType BaseAllocator>
+[[nodiscard]] const Allocator* GetTrackedAllocator(const BaseAllocator& baseAllocator)
+{
+    if constexpr (requires { baseAllocator.GetAllocator(); })
+    {
+        return baseAllocator.GetAllocator();
+    }
+    else
+    {
+        return nullptr;
+    }
+}
+
+/**
+ * @brief Creates an allocator whose blocks come from `parent` instead of the default allocator, e.g. a per-request StackAllocator
+ * inside a per-session LinearAllocator. `argList` are the constructor arguments of `ChildArena` up to and including its debug name,
+ * and `ChildArena` has to use `SharedBase` as its base allocator. The child doesn't own the parent, so the parent has to outlive it
+ */
+template <typename ChildArena, typename... Args>
+std::unique_ptr<ChildArena> CreateChildArena(Allocator& parent, Args&&... argList)
+{
+    // Aliasing an empty shared_ptr gives a pointer to the parent without a control block, so the parent is never deleted through it
+    std::shared_ptr<Allocator> parentPtr(std::shared_ptr<Allocator>(), &parent);
+    return std::make_unique<ChildArena>(std::forward<Args>(argList)..., std::move(parentPtr));
+}
+
 } // namespace Memarena
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -15,16 +16,32 @@ struct AllocationData
     Size           size = 0;
 };
 
+// How an allocator relates to its parent in the MemoryTracker's allocator tree
+enum class AllocatorRelation : UInt8
+{
+    None,          // The allocator is a root
+    BaseAllocator, // The blocks of the allocator come from the parent, so they are part of the used size of the parent
+    Wrapped,       // The parent forwards allocations to the allocator, e.g. a FallbackAllocator to its primary allocator
+};
+
+/**
+ * The counters are written by the thread that uses the allocator, under its lock if it has one, and read by the MemoryTracker and the
+ * stats sampler without that lock. They are atomics accessed with relaxed loads and stores, so reads never block an allocation. A
+ * reader may see the counters of an allocator from slightly different points in time
+ */
 struct AllocatorData
 {
     std::vector<AllocationData> allocations;
     std::string                 debugName;
-    UInt32                      allocationCount   = 0;
-    UInt32                      deallocationCount = 0;
-    Size                        totalSize         = 0;
-    Size                        usedSize          = 0;
-    Size                        peakUsage         = 0;
+    std::atomic<UInt32>         allocationCount   = 0;
+    std::atomic<UInt32>         deallocationCount = 0;
+    std::atomic<Size>           totalSize         = 0;
+    std::atomic<Size>           usedSize          = 0;
+    std::atomic<Size>           peakUsage         = 0;
     bool                        isBaseAllocator   = false;
+    UInt64                      id                = 0; // Assigned by the MemoryTracker
+    UInt64                      parentId          = 0; // The ID of the parent in the allocator tree or 0 for a root
+    AllocatorRelation           parentRelation    = AllocatorRelation::None;
 };
 
 } // namespace Memarena
\ No newline at end of file
@@ -0,0 +1,204 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if !defined(_WIN32)
+    #include <cerrno>
+    #include <climits>
+    #include <sys/uio.h>
+    #include <unistd.h>
+#endif
+
+#include "Source/Allocators/LinearAllocator/LinearAllocator.hpp"
+#include "Source/Macros.hpp"
+
+namespace Memarena
+{
+
+#if defined(_WIN32)
+// Layout compatible stand-in for the POSIX scatter/gather element, so the chain can be passed on to e.g. WSASend after conversion
+struct iovec
+{
+    void*  iov_base;
+    size_t iov_len;
+};
+#endif
+
+constexpr LinearAllocatorSettings bufferChainDefaultSettings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::Growable};
+
+/**
+ * @brief Collects serialized output in the segments of a growable LinearAllocator. Appending never moves what was written before, so
+ * output is copied once, into the arena, and the segments are handed to `writev`/`sendmsg` as an iovec array instead of being joined
+ * into one contiguous buffer. Appends that land directly after the previous one extend its segment, so a new segment is only started
+ * when the arena moves to a new block
+ *
+ * Once everything was written, as reported through `Consume`, the arena is released and the chain can be reused
+ */
+template <LinearAllocatorSettings Settings = bufferChainDefaultSettings, BaseAllocatorType BaseAllocator = MallocBase>
+class BufferChain
+{
+    static_assert(PolicyContains(Settings.policy, LinearAllocatorPolicy::Growable), "A BufferChain requires a growable LinearAllocator");
+    static_assert(!PolicyContains(Settings.policy, LinearAllocatorPolicy::BumpDown), "Appends have to be laid out in increasing order");
+
+    using Arena = LinearAllocator<Settings, BaseAllocator>;
+
+  public:
+    // Prohibit default construction, moving and assignment
+    BufferChain()                   = delete;
+    BufferChain(const BufferChain&) = delete;
+    BufferChain(BufferChain&)       = delete;
+    BufferChain(BufferChain&&)      = delete;
+    BufferChain& operator=(const BufferChain&) = delete;
+    BufferChain& operator=(BufferChain&&) = delete;
+
+    /**
+     * @param segmentSize The block size of the arena. Appends larger than this are split over several segments
+     */
+    explicit BufferChain(const Size segmentSize, const std::string& debugName = "BufferChain",
+                         BaseAllocator baseAllocator = BaseAllocator())
+        : m_Arena(segmentSize, debugName, std::move(baseAllocator)), m_SegmentSize(segmentSize)
+    {
+    }
+
+    ~BufferChain() = default;
+
+    void Append(const void* data, Size size)
+    {
+        const Byte* bytes = static_cast<const Byte*>(data);
+
+        while (size > 0)
+        {
+            // Fill the rest of the current block before moving on, so that a split append doesn't leave a gap behind
+            const Size remainingSize = m_Arena.GetRemainingSize();
+            const Size chunkSize     = std::min(size, remainingSize > 0 ? remainingSize : m_SegmentSize);
+
+            Byte* destination = AppendUninitialized(chunkSize);
+            RETURN_VAL_IF_NULLPTR(destination, void());
+            std::memcpy(destination, bytes, chunkSize);
+
+            bytes += chunkSize;
+            size -= chunkSize;
+        }
+    }
+
+    void Append(const std::string_view text) { Append(text.data(), text.size()); }
+
+    /**
+     * @brief Appends `size` contiguous bytes and returns them to be written in place, e.g. by an encoder that knows the size of a field
+     * up front. `size` must not be larger than the segment size
+     */
+    NO_DISCARD Byte* AppendUninitialized(const Size size)
+    {
+        Byte* ptr = static_cast<Byte*>(m_Arena.Allocate(size, 1));
+        RETURN_IF_NULLPTR(ptr);
+
+        if (!m_Segments.empty() && static_cast<Byte*>(m_Segments.back().iov_base) + m_Segments.back().iov_len == ptr)
+        {
+            m_Segments.back().iov_len += size;
+        }
+        else
+        {
+            m_Segments.push_back({.iov_base = ptr, .iov_len = size});
+        }
+
+        m_Size += size;
+        return ptr;
+    }
+
+    /**
+     * @brief Marks the first `byteCount` bytes as written, e.g. after a partial `writev` to a non-blocking socket. When everything is
+     * written the arena is released
+     */
+    void Consume(Size byteCount)
+    {
+        byteCount = std::min(byteCount, m_Size);
+        m_Size -= byteCount;
+
+        while (byteCount > 0)
+        {
+            iovec&     segment       = m_Segments[m_FirstSegment];
+            const Size consumedCount = std::min(byteCount, segment.iov_len);
+
+            segment.iov_base = static_cast<Byte*>(segment.iov_base) + consumedCount;
+            segment.iov_len -= consumedCount;
+            byteCount -= consumedCount;
+
+            if (segment.iov_len == 0)
+            {
+                m_FirstSegment++;
+            }
+        }
+
+        if (m_Size == 0)
+        {
+            Release();
+        }
+    }
+
+    /**
+     * @brief Drops all output that was not written yet and releases the arena
+     */
+    void Release()
+    {
+        m_Segments.clear();
+        m_FirstSegment = 0;
+        m_Size         = 0;
+        m_Arena.Release();
+    }
+
+#if !defined(_WIN32)
+    /**
+     * @brief Writes all output to `fileDescriptor` with `writev`, retrying partial writes, and releases the arena afterwards. Returns
+     * false if a write fails, in which case the unwritten output is kept
+     */
+    bool WriteTo(const int fileDescriptor)
+    {
+        while (m_Size > 0)
+        {
+            const std::span<const iovec> segments     = GetSegments();
+            const int                    segmentCount = static_cast<int>(std::min<Size>(segments.size(), IOV_MAX));
+
+            const ssize_t writtenCount = writev(fileDescriptor, segments.data(), segmentCount);
+            if (writtenCount < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                return false;
+            }
+
+            Consume(static_cast<Size>(writtenCount));
+        }
+        return true;
+    }
+#endif
+
+    /**
+     * @brief The output that was not consumed yet, valid until the next append, `Consume` or `Release`
+     */
+    [[nodiscard]] std::span<const iovec> GetSegments() const
+    {
+        return std::span<const iovec>(m_Segments).subspan(m_FirstSegment);
+    }
+
+    [[nodiscard]] Size         GetSegmentCount() const { return m_Segments.size() - m_FirstSegment; }
+    [[nodiscard]] Size         GetSize() const { return m_Size; }
+    [[nodiscard]] bool         IsEmpty() const { return m_Size == 0; }
+    [[nodiscard]] const Arena& GetArena() const { return m_Arena; }
+
+  private:
+    Arena m_Arena;
+    Size  m_SegmentSize;
+
+    std::vector<iovec> m_Segments;
+    Size               m_FirstSegment = 0; // Segments before this one were consumed completely
+    Size               m_Size         = 0; // Bytes that were appended but not consumed yet
+};
+} // namespace Memarena
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <bit>
+#include <concepts>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -105,6 +106,14 @@ class FallbackAllocator : public Allocator
                                std::shared_ptr<FallbackAllocatorType> fallbackAllocator, const std::string& debugName = "FallbackAllocator")
         : Allocator(0, debugName), m_PrimaryAllocator(std::move(primaryAllocator)), m_FallbackAllocator(std::move(fallbackAllocator))
     {
+        if constexpr (std::derived_from<PrimaryAllocatorType, Allocator>)
+        {
+            RecordWrappedAllocator(*m_PrimaryAllocator);
+        }
+        if constexpr (std::derived_from<FallbackAllocatorType, Allocator>)
+        {
+            RecordWrappedAllocator(*m_FallbackAllocator);
+        }
     }
 
     ~FallbackAllocator(){
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <utility>
+
+#include "Source/Allocators/LinearAllocator/LinearAllocator.hpp"
+#include "Source/Assert.hpp"
+#include "Source/Macros.hpp"
+#include "Source/Traits.hpp"
+
+namespace Memarena
+{
+
+/**
+ * @brief A monotonic counter that a consumer thread signals when it is done with frame memory. The FrameAllocator waits for the value
+ * attached to a frame before it reuses the frame's memory
+ */
+class FrameFence
+{
+  public:
+    FrameFence()                  = default;
+    FrameFence(const FrameFence&) = delete;
+    FrameFence(FrameFence&&)      = delete;
+    FrameFence& operator=(const FrameFence&) = delete;
+    FrameFence& operator=(FrameFence&&) = delete;
+
+    ~FrameFence() = default;
+
+    void Signal(const UInt64 value)
+    {
+        m_Value.store(value, std::memory_order_release);
+        m_Value.notify_all();
+    }
+
+    void Wait(const UInt64 value) const
+    {
+        UInt64 currentValue = m_Value.load(std::memory_order_acquire);
+        while (currentValue < value)
+        {
+            m_Value.wait(currentValue, std::memory_order_acquire);
+            currentValue = m_Value.load(std::memory_order_acquire);
+        }
+    }
+
+    [[nodiscard]] bool   IsSignaled(const UInt64 value) const { return m_Value.load(std::memory_order_acquire) >= value; }
+    [[nodiscard]] UInt64 GetValue() const { return m_Value.load(std::memory_order_acquire); }
+
+  private:
+    std::atomic<UInt64> m_Value = 0;
+};
+
+/**
+ * @brief Hands out memory that lives for exactly `FrameCount` frames. Every frame allocates from its own LinearAllocator and
+ * `BeginFrame` moves to the next one, releasing the memory allocated `FrameCount` frames ago. Memory that is handed to another thread
+ * can be protected with a fence, which `BeginFrame` waits for before the frame is reused
+ *
+ * @tparam FrameCount The number of frames memory lives for, e.g. 2 for double buffering
+ */
+template <Size FrameCount, LinearAllocatorSettings Settings = linearAllocatorDefaultSettings,
+          BaseAllocatorType BaseAllocator = MallocBase>
+class FrameAllocator
+{
+    static_assert(FrameCount > 0, "A FrameAllocator needs at least one frame");
+
+  private:
+    using Arena = LinearAllocator<Settings, BaseAllocator>;
+
+    struct Frame
+    {
+        Arena             allocator;
+        const FrameFence* fence      = nullptr;
+        UInt64            fenceValue = 0;
+    };
+
+  public:
+    // Prohibit default construction, moving and assignment
+    FrameAllocator()                      = delete;
+    FrameAllocator(const FrameAllocator&) = delete;
+    FrameAllocator(FrameAllocator&)       = delete;
+    FrameAllocator(FrameAllocator&&)      = delete;
+    FrameAllocator& operator=(const FrameAllocator&) = delete;
+    FrameAllocator& operator=(FrameAllocator&&) = delete;
+
+    explicit FrameAllocator(const Size frameSize, const std::string& debugName = "FrameAllocator",
+                            const BaseAllocator& baseAllocator = BaseAllocator())
+        : m_Frames(CreateFrames(frameSize, debugName, baseAllocator, std::make_index_sequence<FrameCount>{}))
+    {
+    }
+
+    /**
+     * @brief Waits for the fences of the frames that still have one, so that no other thread uses the memory after it is freed
+     */
+    ~FrameAllocator()
+    {
+        for (Frame& frame : m_Frames)
+        {
+            WaitForFence(frame);
+        }
+    }
+
+    /**
+     * @brief Moves to the next frame. The memory of that frame, allocated `FrameCount` frames ago, is released after waiting for its
+     * fence
+     */
+    void BeginFrame()
+    {
+        m_CurrentFrame = (m_CurrentFrame + 1) % FrameCount;
+        m_FrameNumber++;
+
+        Frame& frame = m_Frames[m_CurrentFrame];
+        WaitForFence(frame);
+        frame.allocator.Release();
+    }
+
+    /**
+     * @brief Keeps the memory of the current frame alive until `fence` reaches `value`. A frame can wait for a single fence, attaching
+     * the same fence again raises the value to wait for
+     */
+    void AttachFence(const FrameFence& fence, const UInt64 value)
+    {
+        Frame& frame = m_Frames[m_CurrentFrame];
+
+        MEMARENA_ASSERT_RETURN(frame.fence == nullptr || frame.fence == &fence, void(),
+                               "Error: The current frame of the allocator '%s' already waits for another fence!\n",
+                               frame.allocator.GetDebugName().c_str());
+
+        frame.fence      = &fence;
+        frame.fenceValue = std::max(frame.fenceValue, value);
+    }
+
+    template <Allocatable Object, typename... Args>
+    NO_DISCARD Object* NewRaw(Args&&... argList)
+    {
+        return GetCurrentAllocator().template NewRaw<Object>(std::forward<Args>(argList)...);
+    }
+
+    template <Allocatable Object, typename... Args>
+    NO_DISCARD Object* NewArrayRaw(const Size objectCount, Args&&... argList)
+    {
+        return GetCurrentAllocator().template NewArrayRaw<Object>(objectCount, std::forward<Args>(argList)...);
+    }
+
+    NO_DISCARD void* Allocate(const Size size, const Alignment& alignment = defaultAlignment, const std::string& category = "",
+                              const SourceLocation& sourceLocation = SourceLocation::current())
+    {
+        return GetCurrentAllocator().Allocate(size, alignment, category, sourceLocation);
+    }
+
+    template <typename Object>
+    NO_DISCARD void* Allocate(const std::string& category = "", const SourceLocation& sourceLocation = SourceLocation::current())
+    {
+        return GetCurrentAllocator().Allocate(sizeof(Object), alignof(Object), category, sourceLocation);
+    }
+
+    NO_DISCARD void* AllocateArray(const Size objectCount, const Size objectSize, const Alignment& alignment,
+                                   const std::string& category = "", const SourceLocation& sourceLocation = SourceLocation::current())
+    {
+        return GetCurrentAllocator().AllocateArray(objectCount, objectSize, alignment, category, sourceLocation);
+    }
+
+    template <typename Object>
+    NO_DISCARD void* AllocateArray(const Size objectCount, const std::string& category = "",
+                                   const SourceLocation& sourceLocation = SourceLocation::current())
+    {
+        return GetCurrentAllocator().AllocateArray(objectCount, sizeof(Object), alignof(Object), category, sourceLocation);
+    }
+
+    [[nodiscard]] bool Owns(UIntPtr address) const
+    {
+        return std::ranges::any_of(m_Frames, [&](const Frame& frame) { return frame.allocator.Owns(address); });
+    }
+    [[nodiscard]] bool Owns(void* ptr) const { return Owns(std::bit_cast<UIntPtr>(ptr)); }
+
+    [[nodiscard]] Arena&                GetCurrentAllocator() { return m_Frames[m_CurrentFrame].allocator; }
+    [[nodiscard]] const Arena&          GetCurrentAllocator() const { return m_Frames[m_CurrentFrame].allocator; }
+    [[nodiscard]] Size                  GetCurrentFrameIndex() const { return m_CurrentFrame; }
+    [[nodiscard]] UInt64                GetFrameNumber() const { return m_FrameNumber; }
+    [[nodiscard]] static constexpr Size GetFrameCount() { return FrameCount; }
+
+  private:
+    template <Size... Indices>
+    static std::array<Frame, FrameCount> CreateFrames(const Size frameSize, const std::string& debugName,
+                                                      const BaseAllocator& baseAllocator, std::index_sequence<Indices...>)
+    {
+        // The LinearAllocators can't be moved, so they are constructed in place through guaranteed copy elision
+        return {Frame{Arena(frameSize, debugName + "/Frame" + std::to_string(Indices), baseAllocator)}...};
+    }
+
+    static void WaitForFence(Frame& frame)
+    {
+        if (frame.fence != nullptr)
+        {
+            frame.fence->Wait(frame.fenceValue);
+            frame.fence      = nullptr;
+            frame.fenceValue = 0;
+        }
+    }
+
+    std::array<Frame, FrameCount> m_Frames;
+    Size                          m_CurrentFrame = 0;
+    UInt64                        m_FrameNumber  = 0;
+};
+} // namespace Memarena
@@ -0,0 +1,539 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Source/AllocatorSettings.hpp"
+#include "Source/Assert.hpp"
+#include "Source/Macros.hpp"
+#include "Source/Policies/Policies.hpp"
+#include "Source/Probes.hpp"
+#include "Source/Utility/Math.hpp"
+#include "Source/Utility/VirtualMemory.hpp"
+
+namespace Memarena
+{
+
+using IOBufferPoolSettings = AllocatorSettings<IOBufferPoolPolicy>;
+
+constexpr IOBufferPoolSettings ioBufferPoolDefaultSettings = {};
+
+// O_DIRECT requires the buffer address, the transfer size and the file offset to be multiples of the logical block size
+constexpr Size ioBufferAlignment = 4096;
+
+namespace Internal
+{
+/**
+ * @brief Implemented by the pools that keep a cache per thread index, so the caches of a thread can be flushed when it exits
+ */
+class ThreadCacheOwner
+{
+  public:
+    virtual ~ThreadCacheOwner() = default;
+
+    // Called on the exiting thread itself, before its index is handed to another thread
+    virtual void FlushThreadCache(Size threadIndex) = 0;
+};
+
+/**
+ * @brief Hands every thread a small index that is unique among the running threads. When a thread exits, the caches of its index are
+ * flushed in all registered owners before the index is reused by the next thread, so no buffers are stranded. Threads beyond
+ * `MaxCount` get `None` and always use the shared free list
+ */
+class ThreadCacheIndex
+{
+  public:
+    static constexpr Size MaxCount = 64;
+    static constexpr Size None     = std::numeric_limits<Size>::max();
+
+    ThreadCacheIndex(const ThreadCacheIndex&) = delete;
+    ThreadCacheIndex(ThreadCacheIndex&&)      = delete;
+    ThreadCacheIndex& operator=(const ThreadCacheIndex&) = delete;
+    ThreadCacheIndex& operator=(ThreadCacheIndex&&) = delete;
+
+    static Size Get()
+    {
+        thread_local ThreadCacheIndex threadCacheIndex;
+        return threadCacheIndex.m_Index;
+    }
+
+    // A bit per index that is held by a running thread
+    static UInt64 GetUsedIndices() { return GetUsedIndexBits().load(std::memory_order_relaxed); }
+
+    static void RegisterOwner(ThreadCacheOwner* owner)
+    {
+        Owners&                     owners = GetOwners();
+        std::lock_guard<std::mutex> guard(owners.mutex);
+        owners.owners.push_back(owner);
+    }
+
+    static void UnregisterOwner(ThreadCacheOwner* owner)
+    {
+        Owners&                     owners = GetOwners();
+        std::lock_guard<std::mutex> guard(owners.mutex);
+        std::erase(owners.owners, owner);
+    }
+
+  private:
+    ThreadCacheIndex()
+    {
+        std::atomic<UInt64>& usedIndices = GetUsedIndexBits();
+
+        // Acquiring the index synchronizes with the release by the previous owner, so its cache contents are visible to this thread
+        UInt64 used = usedIndices.load(std::memory_order_relaxed);
+        while (used != std::numeric_limits<UInt64>::max())
+        {
+            const Size index = std::countr_one(used);
+            if (usedIndices.compare_exchange_weak(used, used | (UInt64{1} << index), std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                m_Index = index;
+                return;
+            }
+        }
+    }
+
+    ~ThreadCacheIndex()
+    {
+        if (m_Index == None)
+        {
+            return;
+        }
+
+        {
+            // The lock keeps an owner from being destroyed while its cache is flushed
+            Owners&                     owners = GetOwners();
+            std::lock_guard<std::mutex> guard(owners.mutex);
+            for (ThreadCacheOwner* owner : owners.owners)
+            {
+                owner->FlushThreadCache(m_Index);
+            }
+        }
+
+        GetUsedIndexBits().fetch_and(~(UInt64{1} << m_Index), std::memory_order_release);
+    }
+
+    struct Owners
+    {
+        std::mutex                     mutex;
+        std::vector<ThreadCacheOwner*> owners;
+    };
+
+    static std::atomic<UInt64>& GetUsedIndexBits()
+    {
+        static std::atomic<UInt64> usedIndices = 0;
+        return usedIndices;
+    }
+
+    static Owners& GetOwners()
+    {
+        static Owners owners;
+        return owners;
+    }
+
+    Size m_Index = None;
+};
+} // namespace Internal
+
+template <IOBufferPoolSettings Settings>
+class IOBufferPool;
+
+/**
+ * @brief A reference counted handle to a buffer of an IOBufferPool. Copies share the buffer and the last handle to be destroyed
+ * returns it to the pool, so a buffer can be filled on an I/O thread and handed to compute threads without further bookkeeping. The
+ * buffer goes to the cache of the thread that drops the last reference
+ */
+template <IOBufferPoolSettings Settings>
+class IOBuffer
+{
+  public:
+    IOBuffer() = default;
+
+    IOBuffer(const IOBuffer& other) : m_Pool(other.m_Pool), m_Index(other.m_Index)
+    {
+        if (m_Pool != nullptr)
+        {
+            m_Pool->AddReference(m_Index);
+        }
+    }
+
+    IOBuffer(IOBuffer&& other) noexcept : m_Pool(std::exchange(other.m_Pool, nullptr)), m_Index(other.m_Index) {}
+
+    IOBuffer& operator=(IOBuffer other) noexcept
+    {
+        std::swap(m_Pool, other.m_Pool);
+        std::swap(m_Index, other.m_Index);
+        return *this;
+    }
+
+    ~IOBuffer() { Reset(); }
+
+    void Reset()
+    {
+        if (m_Pool != nullptr)
+        {
+            std::exchange(m_Pool, nullptr)->RemoveReference(m_Index);
+        }
+    }
+
+    [[nodiscard]] Byte*  GetData() const { return m_Pool != nullptr ? m_Pool->GetBufferData(m_Index) : nullptr; }
+    [[nodiscard]] Size   GetSize() const { return m_Pool != nullptr ? m_Pool->GetBufferSize() : 0; }
+    [[nodiscard]] UInt32 GetUseCount() const { return m_Pool != nullptr ? m_Pool->GetReferenceCount(m_Index) : 0; }
+    [[nodiscard]] bool   IsNull() const { return m_Pool == nullptr; }
+
+    explicit operator bool() const { return m_Pool != nullptr; }
+
+  private:
+    friend class IOBufferPool<Settings>;
+
+    IOBuffer(IOBufferPool<Settings>* pool, const UInt32 index) : m_Pool(pool), m_Index(index) {}
+
+    IOBufferPool<Settings>* m_Pool  = nullptr;
+    UInt32                  m_Index = 0;
+};
+
+/**
+ * @brief A fixed set of equally sized buffers for direct I/O. All buffers live in one region that is mapped once, optionally
+ * prefaulted and backed by huge pages, and every buffer is aligned to and a multiple of `ioBufferAlignment`, so they can be used with
+ * O_DIRECT as they are. Acquiring and releasing a buffer goes through a small cache per thread and falls back to a lock-free shared
+ * free list, so neither takes a lock or makes a system call. A thread caches at most its share of the buffers, takes buffers out of the
+ * caches of the other threads when the shared free list is empty and flushes its cache when it exits, so a buffer that is released on
+ * another thread than the one that acquires it isn't stranded
+ *
+ * The region is mapped directly instead of coming from a base allocator, so the pool is not registered with the MemoryTracker
+ */
+template <IOBufferPoolSettings Settings = ioBufferPoolDefaultSettings>
+class IOBufferPool : private Internal::ThreadCacheOwner
+{
+  private:
+    static constexpr bool IsPrefaulted       = PolicyContains(Settings.policy, IOBufferPoolPolicy::Prefault);
+    static constexpr bool UsesHugePages      = PolicyContains(Settings.policy, IOBufferPoolPolicy::HugePages);
+    static constexpr bool NeedsUsageTracking = PolicyContains(Settings.policy, IOBufferPoolPolicy::UsageTracking);
+
+    static constexpr UInt32 NoBuffer            = std::numeric_limits<UInt32>::max();
+    static constexpr Size   ThreadCacheCapacity = 16;
+
+    struct BufferSlot
+    {
+        std::atomic<UInt32> referenceCount = 0;
+        std::atomic<UInt32> nextFree       = NoBuffer;
+    };
+
+    // Only the thread that owns the index puts buffers into its cache, any thread may take them out. Empty slots hold `NoBuffer`.
+    // Aligned so that neighbouring caches don't share a cache line
+    struct alignas(64) ThreadCache
+    {
+        ThreadCache()
+        {
+            for (std::atomic<UInt32>& buffer : buffers)
+            {
+                buffer.store(NoBuffer, std::memory_order_relaxed);
+            }
+        }
+
+        std::array<std::atomic<UInt32>, ThreadCacheCapacity> buffers;
+    };
+
+  public:
+    // Prohibit default construction, moving and assignment
+    IOBufferPool()                    = delete;
+    IOBufferPool(const IOBufferPool&) = delete;
+    IOBufferPool(IOBufferPool&)       = delete;
+    IOBufferPool(IOBufferPool&&)      = delete;
+    IOBufferPool& operator=(const IOBufferPool&) = delete;
+    IOBufferPool& operator=(IOBufferPool&&) = delete;
+
+    /**
+     * @param bufferSize The size of every buffer, rounded up to a multiple of `ioBufferAlignment` and the page size
+     */
+    explicit IOBufferPool(const Size bufferSize, const Size bufferCount, const std::string& debugName = "IOBufferPool")
+        : m_BufferSize(RoundUpToMultiple(RoundUpToMultiple(bufferSize, ioBufferAlignment), GetPageSize())),
+          m_BufferCount(bufferCount),
+          m_DebugName(debugName),
+          m_Slots(std::make_unique<BufferSlot[]>(bufferCount)),
+          m_ThreadCaches(std::make_unique<ThreadCache[]>(Internal::ThreadCacheIndex::MaxCount))
+    {
+        MEMARENA_ASSERT(bufferSize > 0, "Error: The buffer size must be greater than 0 for the pool '%s'\n", m_DebugName.c_str());
+        MEMARENA_ASSERT(bufferCount > 0 && bufferCount < NoBuffer, "Error: The buffer count must be in [1, %u) for the pool '%s'\n",
+                        NoBuffer, m_DebugName.c_str());
+
+        void* region = ReserveVirtualMemory(GetTotalSize());
+        if (region == nullptr || !CommitVirtualMemory(region, GetTotalSize()))
+        {
+            MEMARENA_ERROR("Error: Failed to map %zu bytes for the pool '%s'!\n", GetTotalSize(), m_DebugName.c_str());
+            if (region != nullptr)
+            {
+                FreeVirtualMemory(region, GetTotalSize());
+            }
+            m_BufferCount = 0;
+            return;
+        }
+
+        m_Region = static_cast<Byte*>(region);
+
+        // Huge pages have to be requested before the pages are faulted in
+        if constexpr (UsesHugePages)
+        {
+            m_HasHugePages = AdviseHugePages(m_Region, GetTotalSize());
+        }
+
+        if constexpr (IsPrefaulted)
+        {
+            PrefaultVirtualMemory(m_Region, GetTotalSize());
+        }
+
+        for (UInt32 index = 0; index + 1 < m_BufferCount; index++)
+        {
+            m_Slots[index].nextFree.store(index + 1, std::memory_order_relaxed);
+        }
+        m_FreeHead.store(MakeHead(0, 0), std::memory_order_release);
+
+        Internal::ThreadCacheIndex::RegisterOwner(this);
+    }
+
+    /**
+     * @brief Unmaps all buffers. No handle to a buffer of this pool may outlive it
+     */
+    ~IOBufferPool() override
+    {
+        Internal::ThreadCacheIndex::UnregisterOwner(this);
+
+        if constexpr (NeedsUsageTracking)
+        {
+            MEMARENA_ASSERT(GetAcquiredCount() == 0, "Error: %zu buffers of the pool '%s' are still in use on destruction!\n",
+                            GetAcquiredCount(), m_DebugName.c_str());
+        }
+
+        if (m_Region != nullptr)
+        {
+            FreeVirtualMemory(m_Region, GetTotalSize());
+        }
+    }
+
+    /**
+     * @brief Returns a buffer with a use count of 1, or an empty handle if no buffer is free so callers can apply backpressure. The
+     * caches of the other threads are searched before giving up, so it only fails when all buffers are in use or are being released
+     * while it searches
+     */
+    NO_DISCARD IOBuffer<Settings> Acquire()
+    {
+        UInt32       index = NoBuffer;
+        ThreadCache* cache = GetThreadCache();
+
+        if (cache != nullptr)
+        {
+            index = TakeFromCache(*cache);
+        }
+        if (index == NoBuffer)
+        {
+            index = PopShared();
+        }
+        if (index == NoBuffer)
+        {
+            index = TakeFromOtherCaches(cache);
+        }
+
+        if (index == NoBuffer)
+        {
+            return {};
+        }
+
+        m_Slots[index].referenceCount.store(1, std::memory_order_relaxed);
+
+        if constexpr (NeedsUsageTracking)
+        {
+            m_AcquiredCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        MEMARENA_PROBE(allocate, this, GetBufferData(index), m_BufferSize);
+
+        return IOBuffer<Settings>(this, index);
+    }
+
+    [[nodiscard]] bool Owns(const void* ptr) const
+    {
+        const Byte* bytePtr = static_cast<const Byte*>(ptr);
+        return m_Region != nullptr && bytePtr >= m_Region && bytePtr < m_Region + GetTotalSize();
+    }
+
+    /**
+     * @brief The number of buffers that have a handle. Only available with `IOBufferPoolPolicy::UsageTracking`
+     */
+    [[nodiscard]] Size GetAcquiredCount() const
+    {
+        static_assert(NeedsUsageTracking, "GetAcquiredCount requires IOBufferPoolPolicy::UsageTracking");
+        return m_AcquiredCount.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] Size               GetBufferSize() const { return m_BufferSize; }
+    [[nodiscard]] Size               GetBufferCount() const { return m_BufferCount; }
+    [[nodiscard]] Size               GetTotalSize() const { return m_BufferSize * m_BufferCount; }
+    [[nodiscard]] bool               HasHugePages() const { return m_HasHugePages; }
+    [[nodiscard]] const std::string& GetDebugName() const { return m_DebugName; }
+
+  private:
+    friend class IOBuffer<Settings>;
+
+    [[nodiscard]] Byte* GetBufferData(const UInt32 index) const { return m_Region + static_cast<Size>(index) * m_BufferSize; }
+
+    [[nodiscard]] UInt32 GetReferenceCount(const UInt32 index) const
+    {
+        return m_Slots[index].referenceCount.load(std::memory_order_relaxed);
+    }
+
+    void AddReference(const UInt32 index) { m_Slots[index].referenceCount.fetch_add(1, std::memory_order_relaxed); }
+
+    void RemoveReference(const UInt32 index)
+    {
+        // Acquire-release so that all writes to the buffer through other handles happen before it is reused
+        if (m_Slots[index].referenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            ReleaseBuffer(index);
+        }
+    }
+
+    void ReleaseBuffer(const UInt32 index)
+    {
+        MEMARENA_PROBE(deallocate, this, GetBufferData(index));
+
+        if constexpr (NeedsUsageTracking)
+        {
+            m_AcquiredCount.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        ThreadCache* cache = GetThreadCache();
+        if (cache == nullptr || !PutIntoCache(*cache, index))
+        {
+            PushShared(index, index);
+        }
+    }
+
+    [[nodiscard]] ThreadCache* GetThreadCache() const
+    {
+        const Size threadIndex = Internal::ThreadCacheIndex::Get();
+        return threadIndex != Internal::ThreadCacheIndex::None ? &m_ThreadCaches[threadIndex] : nullptr;
+    }
+
+    // Threads that only release would otherwise hoard the buffers of threads that only acquire, so a cache holds about its share
+    [[nodiscard]] Size GetThreadCacheLimit() const
+    {
+        const Size threadCount = std::max<Size>(std::popcount(Internal::ThreadCacheIndex::GetUsedIndices()), 1);
+        return std::min(ThreadCacheCapacity, m_BufferCount / threadCount);
+    }
+
+    // Only called by the thread that owns the cache, so a slot it sees empty stays empty until it fills it
+    bool PutIntoCache(ThreadCache& cache, const UInt32 index)
+    {
+        const Size limit = GetThreadCacheLimit();
+        for (Size slot = 0; slot < limit; slot++)
+        {
+            if (cache.buffers[slot].load(std::memory_order_relaxed) == NoBuffer)
+            {
+                // Release so that a thread that takes the buffer out of the cache sees the writes to it
+                cache.buffers[slot].store(index, std::memory_order_release);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Takes the most recently cached buffer, the slots past the limit may still hold buffers from when the limit was higher
+    UInt32 TakeFromCache(ThreadCache& cache)
+    {
+        for (Size slot = ThreadCacheCapacity; slot-- > 0;)
+        {
+            if (cache.buffers[slot].load(std::memory_order_relaxed) != NoBuffer)
+            {
+                const UInt32 index = cache.buffers[slot].exchange(NoBuffer, std::memory_order_acquire);
+                if (index != NoBuffer)
+                {
+                    return index;
+                }
+            }
+        }
+        return NoBuffer;
+    }
+
+    // The caches of exited threads were flushed, so only the caches of running threads are searched
+    UInt32 TakeFromOtherCaches(const ThreadCache* ownCache)
+    {
+        for (UInt64 usedIndices = Internal::ThreadCacheIndex::GetUsedIndices(); usedIndices != 0; usedIndices &= usedIndices - 1)
+        {
+            ThreadCache& cache = m_ThreadCaches[std::countr_zero(usedIndices)];
+            if (&cache == ownCache)
+            {
+                continue;
+            }
+
+            const UInt32 index = TakeFromCache(cache);
+            if (index != NoBuffer)
+            {
+                return index;
+            }
+        }
+        return NoBuffer;
+    }
+
+    void FlushThreadCache(const Size threadIndex) override
+    {
+        ThreadCache& cache = m_ThreadCaches[threadIndex];
+        for (UInt32 index = TakeFromCache(cache); index != NoBuffer; index = TakeFromCache(cache))
+        {
+            PushShared(index, index);
+        }
+    }
+
+    // The head of the shared free list carries a tag that changes on every update, which keeps a stale pop from succeeding when the
+    // same buffer was popped and pushed again in between (the ABA problem)
+    static constexpr UInt64 MakeHead(const UInt32 tag, const UInt32 index) { return (static_cast<UInt64>(tag) << 32) | index; }
+    static constexpr UInt32 GetHeadTag(const UInt64 head) { return static_cast<UInt32>(head >> 32); }
+    static constexpr UInt32 GetHeadIndex(const UInt64 head) { return static_cast<UInt32>(head); }
+
+    UInt32 PopShared()
+    {
+        UInt64 head = m_FreeHead.load(std::memory_order_acquire);
+        while (GetHeadIndex(head) != NoBuffer)
+        {
+            const UInt32 index = GetHeadIndex(head);
+            const UInt32 next  = m_Slots[index].nextFree.load(std::memory_order_relaxed);
+
+            if (m_FreeHead.compare_exchange_weak(head, MakeHead(GetHeadTag(head) + 1, next), std::memory_order_acquire,
+                                                 std::memory_order_acquire))
+            {
+                return index;
+            }
+        }
+        return NoBuffer;
+    }
+
+    // Pushes the chain of buffers from `first` to `last`, which are already linked through their slots
+    void PushShared(const UInt32 first, const UInt32 last)
+    {
+        UInt64 head = m_FreeHead.load(std::memory_order_relaxed);
+        do
+        {
+            m_Slots[last].nextFree.store(GetHeadIndex(head), std::memory_order_relaxed);
+        } while (!m_FreeHead.compare_exchange_weak(head, MakeHead(GetHeadTag(head) + 1, first), std::memory_order_release,
+                                                   std::memory_order_relaxed));
+    }
+
+    Size        m_BufferSize;
+    Size        m_BufferCount;
+    std::string m_DebugName;
+    Byte*       m_Region       = nullptr;
+    bool        m_HasHugePages = false;
+
+    std::unique_ptr<BufferSlot[]>  m_Slots;
+    std::unique_ptr<ThreadCache[]> m_ThreadCaches;
+
+    alignas(64) std::atomic<UInt64> m_FreeHead = MakeHead(0, NoBuffer);
+    alignas(64) std::atomic<Size> m_AcquiredCount = 0;
+};
+} // namespace Memarena
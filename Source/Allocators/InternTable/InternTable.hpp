@@ -0,0 +1,263 @@
+#pragma once
+
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Source/Allocators/LinearAllocator/LinearAllocator.hpp"
+#include "Source/Assert.hpp"
+#include "Source/Macros.hpp"
+#include "Source/Policies/MultithreadedPolicy.hpp"
+
+namespace Memarena
+{
+
+using InternId = UInt32;
+
+// Without the size check, contents larger than a block get a block of their own
+constexpr LinearAllocatorSettings internTableDefaultSettings = {
+    .policy = (LinearAllocatorPolicy::Default | LinearAllocatorPolicy::Growable) & ~LinearAllocatorPolicy::SizeCheck};
+
+/**
+ * @brief Deduplicates strings and byte blobs. Every unique content is copied once into a growable LinearAllocator and gets a 32-bit
+ * ID in the order of insertion, so equal contents compare as equal IDs and the views returned stay valid for the lifetime of the table
+ *
+ * The index is an open-addressing hash table that keeps the 32-bit IDs and the cached 32-bit hashes of the contents in two separate
+ * arrays. Lookups compare the hashes of a group of slots at once, which compilers turn into vector compares, and only read the
+ * contents on a hash match. Growing the index never touches the contents
+ */
+template <LinearAllocatorSettings Settings = internTableDefaultSettings, BaseAllocatorType BaseAllocator = MallocBase>
+class InternTable
+{
+    static_assert(PolicyContains(Settings.policy, LinearAllocatorPolicy::Growable), "An InternTable requires a growable LinearAllocator");
+
+  private:
+    static constexpr bool IsMultithreaded = PolicyContains(Settings.policy, LinearAllocatorPolicy::Multithreaded);
+
+    using ThreadPolicy = MultithreadedPolicy<IsMultithreaded>;
+
+    template <typename SyncPrimitive>
+    using LockGuard = typename ThreadPolicy::template LockGuard<SyncPrimitive>;
+    using Mutex     = typename ThreadPolicy::Mutex;
+
+    static constexpr UInt32 EmptyHash       = 0;
+    static constexpr Size   GroupSize       = 8;
+    static constexpr Size   InitialCapacity = 64;
+
+  public:
+    // Returned by `Intern` when the content couldn't be interned
+    static constexpr InternId InvalidId = std::numeric_limits<InternId>::max();
+
+    // Prohibit default construction, moving and assignment
+    InternTable()                   = delete;
+    InternTable(const InternTable&) = delete;
+    InternTable(InternTable&)       = delete;
+    InternTable(InternTable&&)      = delete;
+    InternTable& operator=(const InternTable&) = delete;
+    InternTable& operator=(InternTable&&) = delete;
+
+    /**
+     * @param blockSize The block size of the arena that stores the contents
+     */
+    explicit InternTable(const Size blockSize, const std::string& debugName = "InternTable", BaseAllocator baseAllocator = BaseAllocator())
+        : m_Arena(blockSize, debugName, std::move(baseAllocator)), m_Hashes(InitialCapacity, EmptyHash), m_Ids(InitialCapacity, 0)
+    {
+    }
+
+    ~InternTable() = default;
+
+    /**
+     * @brief Returns the ID of `text`, copying it into the table if it wasn't interned before, or `InvalidId` if the table is out of IDs
+     * or memory
+     */
+    NO_DISCARD InternId Intern(const std::string_view text)
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        return InternInternal(text);
+    }
+
+    NO_DISCARD InternId Intern(const void* data, const Size size) { return Intern(std::string_view(static_cast<const char*>(data), size)); }
+
+    /**
+     * @brief Returns the interned copy of `text`. Views of equal contents point to the same bytes. Returns an empty view if `text`
+     * couldn't be interned
+     */
+    NO_DISCARD std::string_view InternView(const std::string_view text)
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        const InternId id = InternInternal(text);
+        return id != InvalidId ? m_Entries[id] : std::string_view();
+    }
+
+    /**
+     * @brief Looks up `text` without interning it
+     */
+    [[nodiscard]] std::optional<InternId> Find(const std::string_view text) const
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        const auto [slot, found] = FindSlot(text, Hash(text));
+        return found ? std::optional<InternId>(m_Ids[slot]) : std::nullopt;
+    }
+
+    [[nodiscard]] std::string_view Get(const InternId id) const
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        MEMARENA_ASSERT_RETURN(id < m_Entries.size(), std::string_view(), "Error: The ID %u is not in the intern table '%s'!\n", id,
+                               m_Arena.GetDebugName().c_str());
+        return m_Entries[id];
+    }
+
+    [[nodiscard]] std::span<const Byte> GetBytes(const InternId id) const
+    {
+        const std::string_view entry = Get(id);
+        return {std::bit_cast<const Byte*>(entry.data()), entry.size()};
+    }
+
+    [[nodiscard]] Size GetCount() const
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        return m_Entries.size();
+    }
+
+    [[nodiscard]] const LinearAllocator<Settings, BaseAllocator>& GetArena() const { return m_Arena; }
+
+  private:
+    InternId InternInternal(const std::string_view text)
+    {
+        const UInt32 hash        = Hash(text);
+        const auto [slot, found] = FindSlot(text, hash);
+        if (found)
+        {
+            return m_Ids[slot];
+        }
+
+        MEMARENA_ASSERT_RETURN(m_Entries.size() < InvalidId, InvalidId, "Error: The intern table '%s' is out of IDs!\n",
+                               m_Arena.GetDebugName().c_str());
+
+        std::string_view entry;
+        if (!text.empty())
+        {
+            char* copy = static_cast<char*>(m_Arena.Allocate(text.size(), 1));
+            RETURN_VAL_IF_NULLPTR(copy, InvalidId);
+            std::memcpy(copy, text.data(), text.size());
+            entry = std::string_view(copy, text.size());
+        }
+
+        const InternId id = static_cast<InternId>(m_Entries.size());
+        m_Entries.push_back(entry);
+        m_Hashes[slot] = hash;
+        m_Ids[slot]    = id;
+
+        // Keep the load factor at or below 3/4, so probe sequences stay short and there is always an empty slot
+        if (m_Entries.size() * 4 > m_Hashes.size() * 3)
+        {
+            Grow();
+        }
+        return id;
+    }
+
+    // Returns the slot holding `text` or, if it isn't interned, the empty slot it would be inserted into
+    std::pair<Size, bool> FindSlot(const std::string_view text, const UInt32 hash) const
+    {
+        const Size mask  = m_Hashes.size() - 1;
+        Size       group = hash & mask & ~(GroupSize - 1);
+
+        while (true)
+        {
+            UInt32 matchMask = 0;
+            UInt32 emptyMask = 0;
+            for (Size i = 0; i < GroupSize; i++)
+            {
+                matchMask |= UInt32(m_Hashes[group + i] == hash) << i;
+                emptyMask |= UInt32(m_Hashes[group + i] == EmptyHash) << i;
+            }
+
+            for (; matchMask != 0; matchMask &= matchMask - 1)
+            {
+                const Size slot = group + std::countr_zero(matchMask);
+                if (m_Entries[m_Ids[slot]] == text)
+                {
+                    return {slot, true};
+                }
+            }
+
+            // Nothing is ever removed, so a group with an empty slot ends the probe sequence
+            if (emptyMask != 0)
+            {
+                return {group + std::countr_zero(emptyMask), false};
+            }
+
+            group = (group + GroupSize) & mask;
+        }
+    }
+
+    void Grow()
+    {
+        std::vector<UInt32>   hashes = std::move(m_Hashes);
+        std::vector<InternId> ids    = std::move(m_Ids);
+
+        m_Hashes.assign(hashes.size() * 2, EmptyHash);
+        m_Ids.assign(hashes.size() * 2, 0);
+
+        // The cached hashes are enough to place the entries again, so the contents aren't read
+        const Size mask = m_Hashes.size() - 1;
+        for (Size oldSlot = 0; oldSlot < hashes.size(); oldSlot++)
+        {
+            if (hashes[oldSlot] == EmptyHash)
+            {
+                continue;
+            }
+
+            Size group = hashes[oldSlot] & mask & ~(GroupSize - 1);
+            Size slot  = FindEmptySlot(group);
+            while (slot == GroupSize)
+            {
+                group = (group + GroupSize) & mask;
+                slot  = FindEmptySlot(group);
+            }
+
+            m_Hashes[group + slot] = hashes[oldSlot];
+            m_Ids[group + slot]    = ids[oldSlot];
+        }
+    }
+
+    // Returns the index of the first empty slot in `group` or `GroupSize` if the group is full
+    [[nodiscard]] Size FindEmptySlot(const Size group) const
+    {
+        for (Size i = 0; i < GroupSize; i++)
+        {
+            if (m_Hashes[group + i] == EmptyHash)
+            {
+                return i;
+            }
+        }
+        return GroupSize;
+    }
+
+    static UInt32 Hash(const std::string_view text)
+    {
+        const UInt64 hash   = std::hash<std::string_view>{}(text);
+        const UInt32 folded = static_cast<UInt32>(hash ^ (hash >> 32));
+
+        // Zero marks empty slots
+        return folded == EmptyHash ? 1 : folded;
+    }
+
+    mutable ThreadPolicy m_MultithreadedPolicy;
+
+    LinearAllocator<Settings, BaseAllocator> m_Arena;
+    std::vector<std::string_view>            m_Entries; // Indexed by ID
+
+    std::vector<UInt32>   m_Hashes; // Cached hashes of the entries in the slots, the index is a power of two in size
+    std::vector<InternId> m_Ids;
+};
+} // namespace Memarena
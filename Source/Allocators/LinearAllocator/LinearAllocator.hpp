@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <bit>
+#include <limits>
 #include <utility>
 #include <vector>
 
@@ -9,10 +10,14 @@
 #include "Source/AllocatorData.hpp"
 #include "Source/AllocatorSettings.hpp"
 #include "Source/AllocatorUtils.hpp"
+#include "Source/Allocators/Mallocator/Mallocator.hpp"
 #include "Source/Assert.hpp"
 #include "Source/Macros.hpp"
+#include "Source/Policies/AdaptiveBlockSizePolicy.hpp"
+#include "Source/Policies/ThreadTrackingPolicy.hpp"
 #include "Source/Policies/MultithreadedPolicy.hpp"
 #include "Source/Policies/Policies.hpp"
+#include "Source/Probes.hpp"
 #include "Source/Traits.hpp"
 #include "Source/Utility/Alignment/Alignment.hpp"
 
@@ -26,9 +31,16 @@ constexpr LinearAllocatorSettings linearAllocatorDefaultSettings{};
  * @brief A custom memory allocator that cannot deallocate individual allocations. To free allocations, you must
  *       free the entire arena by calling `Release`.
  *
+ * With `LinearAllocatorPolicy::BumpDown` every block is filled from its end towards its start. The used size and the offsets stay
+ * the same, only the addresses of the allocations change.
+ *
+ * The offset into the current block is 32-bit by default. `LinearAllocatorPolicy::WideOffsets` makes it 64-bit for blocks larger
+ * than 4 GiB.
+ *
  * @tparam policy
+ * @tparam BaseAllocator Where the blocks come from
  */
-template <LinearAllocatorSettings Settings = linearAllocatorDefaultSettings>
+template <LinearAllocatorSettings Settings = linearAllocatorDefaultSettings, BaseAllocatorType BaseAllocator = MallocBase>
 class LinearAllocator : public Allocator
 {
   private:
@@ -39,8 +51,21 @@ class LinearAllocator : public Allocator
     static constexpr bool UsageTrackingIsEnabled      = PolicyContains(Policy, LinearAllocatorPolicy::SizeTracking);
     static constexpr bool AllocationTrackingIsEnabled = PolicyContains(Policy, LinearAllocatorPolicy::AllocationTracking);
     static constexpr bool IsMultithreaded             = PolicyContains(Policy, LinearAllocatorPolicy::Multithreaded);
+    static constexpr bool HasAdaptiveBlockSize        = PolicyContains(Policy, LinearAllocatorPolicy::AdaptiveBlockSize);
+    static constexpr bool IsBumpDown                  = PolicyContains(Policy, LinearAllocatorPolicy::BumpDown);
+    static constexpr bool HasWideOffsets              = PolicyContains(Policy, LinearAllocatorPolicy::WideOffsets);
+    static constexpr bool HeapProfilingIsEnabled      = PolicyContains(Policy, LinearAllocatorPolicy::HeapProfiling);
+    static constexpr bool ThreadTrackingIsEnabled     = PolicyContains(Policy, LinearAllocatorPolicy::ThreadTracking);
+
+    static_assert(!HasAdaptiveBlockSize || IsGrowable, "The adaptive block size policy requires the growable policy");
+
+    using ThreadPolicy         = MultithreadedPolicy<IsMultithreaded, IsGrowable>;
+    using BlockSizePolicy      = AdaptiveBlockSizePolicy<HasAdaptiveBlockSize>;
+    using ThreadTrackingPolicy = Memarena::ThreadTrackingPolicy<ThreadTrackingIsEnabled>;
+    using OffsetType           = std::conditional_t<HasWideOffsets, UInt64, Offset>;
 
-    using ThreadPolicy = MultithreadedPolicy<IsMultithreaded, IsGrowable>;
+    // The offset into a block has to be able to address all of it
+    static constexpr Size MaxBlockSize = std::numeric_limits<OffsetType>::max();
 
     template <typename SyncPrimitive>
     using LockGuard = typename ThreadPolicy::template LockGuard<SyncPrimitive>;
@@ -56,17 +81,37 @@ class LinearAllocator : public Allocator
     LinearAllocator& operator=(LinearAllocator&&) = delete;
 
     explicit LinearAllocator(const Size blockSize, const std::string& debugName = "LinearAllocator",
-                             std::shared_ptr<Allocator> baseAllocator = Allocator::GetDefaultAllocator())
-        : Allocator(blockSize, debugName), m_BlockSize(blockSize), m_BaseAllocator(std::move(baseAllocator))
+                             BaseAllocator baseAllocator = BaseAllocator())
+        : LinearAllocator(blockSize, BlockSizeBounds{}, debugName, std::move(baseAllocator))
     {
-        AllocateBlock();
+    }
+
+    /**
+     * @brief With the adaptive block size policy, the size of new blocks follows the observed demand within `blockSizeBounds`,
+     * starting from `blockSize`. Without it the bounds are ignored
+     */
+    LinearAllocator(const Size blockSize, const BlockSizeBounds& blockSizeBounds, const std::string& debugName = "LinearAllocator",
+                    BaseAllocator baseAllocator = BaseAllocator())
+        : Allocator(blockSize, debugName, false, MaxBlockSize), m_BlockSizePolicy(blockSize, blockSizeBounds, MaxBlockSize),
+          m_BaseAllocator(std::move(baseAllocator))
+    {
+        RecordBaseAllocator(GetTrackedAllocator(m_BaseAllocator));
+        AllocateBlock(m_BlockSizePolicy.GetInitialBlockSize());
     }
 
     ~LinearAllocator()
     {
-        for (auto& blockPtr : m_BlockPtrs)
+        if constexpr (HeapProfilingIsEnabled)
         {
-            m_BaseAllocator->DeallocateBase(blockPtr);
+            ReleaseSamples();
+        }
+
+        m_ThreadTrackingPolicy.RecordRelease();
+
+        // Blocks are freed in reverse order, so that a StackAllocator can be the base allocator
+        for (Size blockIndex = m_BlockPtrs.size(); blockIndex-- > 0;)
+        {
+            m_BaseAllocator.DeallocateBase(m_BlockPtrs[blockIndex], m_BlockSizes[blockIndex]);
         }
     };
 
@@ -94,8 +139,9 @@ class LinearAllocator : public Allocator
     {
         if constexpr (SizeCheckIsEnabled)
         {
-            MEMARENA_ASSERT_RETURN(size <= m_BlockSize, nullptr,
-                                   "Error: Allocation size (%u) must be <= to block size (%u) for allocator '%s'!\n", size, m_BlockSize,
+            const Size maxBlockSize = m_BlockSizePolicy.GetMaxBlockSize();
+            MEMARENA_ASSERT_RETURN(size <= maxBlockSize, nullptr,
+                                   "Error: Allocation size (%zu) must be <= to block size (%zu) for allocator '%s'!\n", size, maxBlockSize,
                                    GetDebugName().c_str());
         }
 
@@ -105,19 +151,34 @@ class LinearAllocator : public Allocator
             // Scope to release the lock after the allocation
             LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
 
-            const UIntPtr baseAddress = m_CurrentStartAddress + m_CurrentOffset;
-            alignedAddress            = CalculateAlignedAddress(baseAddress, alignment);
-            const Padding padding     = alignedAddress - baseAddress;
+            Padding padding{0};
 
-            Size totalSizeAfterAllocation = m_CurrentOffset + padding + size;
-            SetCurrentOffset(totalSizeAfterAllocation);
+            if constexpr (IsBumpDown)
+            {
+                // Aligning the start of the allocation down is a subtraction and a mask, the padding ends up above it
+                const UIntPtr topAddress = m_CurrentStartAddress + m_BlockSize - m_CurrentOffset;
+                alignedAddress           = CalculateAlignedDownAddress(topAddress - size, alignment);
+                padding                  = topAddress - size - alignedAddress;
+            }
+            else
+            {
+                const UIntPtr baseAddress = m_CurrentStartAddress + m_CurrentOffset;
+                alignedAddress            = CalculateAlignedAddress(baseAddress, alignment);
+                padding                   = alignedAddress - baseAddress;
+            }
+
+            // Only stored once it fits, it may not fit into an offset before that
+            const Size totalSizeAfterAllocation = m_CurrentOffset + padding + size;
 
             if constexpr (IsGrowable)
             {
-                // TODO(Ahsan): Check if allocation will be more than max possible size
                 if (totalSizeAfterAllocation > m_BlockSize)
                 {
-                    AllocateBlock();
+                    // The new block must fit the allocation even if it needs the largest possible padding
+                    if (!AllocateBlock(std::max(m_BlockSizePolicy.GetGrowthBlockSize(), size + alignment - 1)))
+                    {
+                        return nullptr;
+                    }
                     guard.unlock();
                     return Allocate(size, alignment, category, sourceLocation);
                 }
@@ -127,6 +188,11 @@ class LinearAllocator : public Allocator
                 MEMARENA_ASSERT_RETURN(totalSizeAfterAllocation <= m_BlockSize, nullptr, "Error: The allocator '%s' is out of memory!\n",
                                        GetDebugName().c_str());
             }
+
+            SetCurrentOffset(totalSizeAfterAllocation);
+
+            m_BlockSizePolicy.RecordAllocation(padding + size);
+            m_ThreadTrackingPolicy.RecordAllocation(padding + size);
         }
 
         if constexpr (AllocationTrackingIsEnabled)
@@ -134,6 +200,13 @@ class LinearAllocator : public Allocator
             AddAllocation(size, category, sourceLocation);
         }
 
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            SampleAllocation(std::bit_cast<void*>(alignedAddress), size);
+        }
+
+        MEMARENA_PROBE(allocate, this, alignedAddress, size);
+
         return std::bit_cast<void*>(alignedAddress);
     }
 
@@ -159,22 +232,35 @@ class LinearAllocator : public Allocator
 
     /**
      * @brief Releases the allocator to its initial state. Since LinearAllocators dont support de-allocating separate allocation, this
-     * is how you clean the memory
+     * is how you clean the memory. With the adaptive block size policy, the kept block is resized to fit the peak usage since the last
+     * release
      *
      */
     inline void Release()
     {
         LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        MEMARENA_PROBE(release, this);
         DeallocateBlocks();
+        m_ThreadTrackingPolicy.RecordRelease();
+
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            ReleaseSamples();
+        }
     };
 
     [[nodiscard]] bool Owns(UIntPtr address) const
     {
-        return std::ranges::any_of(m_BlockPtrs, [&](void* blockPtr) {
-            const UIntPtr startAddress = std::bit_cast<UIntPtr>(blockPtr);
-            const UIntPtr endAddress   = startAddress + m_BlockSize;
-            return address >= startAddress && address <= endAddress;
-        });
+        for (Size blockIndex = 0; blockIndex < m_BlockPtrs.size(); blockIndex++)
+        {
+            const UIntPtr startAddress = std::bit_cast<UIntPtr>(m_BlockPtrs[blockIndex]);
+            const UIntPtr endAddress   = startAddress + m_BlockSizes[blockIndex];
+            if (address >= startAddress && address <= endAddress)
+            {
+                return true;
+            }
+        }
+        return false;
     }
     [[nodiscard]] bool Owns(void* ptr) const { return Owns(std::bit_cast<UIntPtr>(ptr)); }
     template <typename Object>
@@ -183,32 +269,59 @@ class LinearAllocator : public Allocator
         return Owns(ptr.GetPtr());
     }
 
-    // NO_DISCARD BaseAllocatorPtr<void> AllocateBase(const Size size) final { return Allocate(size); }
+    [[nodiscard]] Size GetBlockCount() const { return m_BlockPtrs.size(); }
+    [[nodiscard]] Size GetBlockSize(const Size blockIndex) const { return m_BlockSizes[blockIndex]; }
+
+    /**
+     * @brief The space left in the current block. An allocation with an alignment of 1 that fits is placed directly after the previous
+     * allocation, or directly before it when bumping down
+     */
+    [[nodiscard]] Size GetRemainingSize() const { return m_CurrentOffset < m_BlockSize ? m_BlockSize - m_CurrentOffset : 0; }
+
+    /**
+     * @brief Lets child arenas allocate their blocks from this allocator. Like every other allocation, the blocks are only freed by
+     * `Release`, so `DeallocateBase` does nothing
+     */
+    NO_DISCARD void* AllocateBase(const Size size) final { return Allocate(size); }
+    void             DeallocateBase(void* /*ptr*/, const Size /*size*/) final {}
 
   private:
-    void SetCurrentOffset(const Offset offset)
+    void SetCurrentOffset(const OffsetType offset)
     {
         m_CurrentOffset = offset;
 
         if constexpr (UsageTrackingIsEnabled)
         {
-            SetUsedSize((m_BlockPtrs.size() - 1) * m_BlockSize + offset);
+            SetUsedSize(m_PreviousBlocksSize + offset);
         }
     }
 
-    inline void AllocateBlock()
+    // Returns false if the block is larger than the offsets can address or the base allocator is out of memory, the current block stays
+    // as it is then
+    inline bool AllocateBlock(const Size blockSize)
     {
+        MEMARENA_ASSERT_RETURN(blockSize <= MaxBlockSize, false,
+                               "Error: The block size %zu of the allocator '%s' is larger than its offsets can address (%zu)!\n", blockSize,
+                               GetDebugName().c_str(), MaxBlockSize);
 
-        void* newBlockPtr = m_BaseAllocator->AllocateBase(m_BlockSize);
-        m_BlockPtrs.push_back(newBlockPtr);
-        m_CurrentStartAddress = std::bit_cast<UIntPtr>(m_BlockPtrs.back());
-        m_CurrentOffset       = 0;
+        void* newBlockPtr = m_BaseAllocator.AllocateBase(blockSize);
+        RETURN_VAL_IF_NULLPTR(newBlockPtr, false);
+        MEMARENA_PROBE(block_grow, this, newBlockPtr, blockSize);
 
-        if constexpr (UsageTrackingIsEnabled)
+        if (!m_BlockPtrs.empty())
         {
-            SetUsedSize((m_BlockPtrs.size() - 1) * m_BlockSize);
+            m_PreviousBlocksSize += m_BlockSize;
         }
+
+        m_BlockPtrs.push_back(newBlockPtr);
+        m_BlockSizes.push_back(blockSize);
+        m_CurrentStartAddress = std::bit_cast<UIntPtr>(m_BlockPtrs.back());
+        m_BlockSize           = blockSize;
+        m_TotalBlocksSize += blockSize;
+
+        SetCurrentOffset(0);
         UpdateTotalSize();
+        return true;
     }
 
     // Deallocates all but the first block
@@ -220,25 +333,48 @@ class LinearAllocator : public Allocator
             {
                 FreeLastBlock();
             }
+        }
+
+        m_PreviousBlocksSize = 0;
+
+        // The allocator has no block if the base allocator was out of memory, the next allocation tries to get one again
+        const Size releaseBlockSize = m_BlockSizePolicy.GetReleaseBlockSize();
+        if (m_BlockPtrs.empty() || BlockSizePolicy::ShouldReplaceBlock(m_BlockSizes[0], releaseBlockSize))
+        {
+            if (!m_BlockPtrs.empty())
+            {
+                FreeLastBlock();
+            }
+
+            m_CurrentStartAddress = 0;
+            m_BlockSize           = 0;
             UpdateTotalSize();
+            SetCurrentOffset(0);
+
+            AllocateBlock(releaseBlockSize);
+            return;
         }
 
         m_CurrentStartAddress = std::bit_cast<UIntPtr>(m_BlockPtrs[0]);
+        m_BlockSize           = m_BlockSizes[0];
 
+        UpdateTotalSize();
         SetCurrentOffset(0);
     }
 
     inline void FreeLastBlock()
     {
-        m_BaseAllocator->DeallocateBase(m_BlockPtrs.back());
+        m_BaseAllocator.DeallocateBase(m_BlockPtrs.back(), m_BlockSizes.back());
+        m_TotalBlocksSize -= m_BlockSizes.back();
         m_BlockPtrs.pop_back();
+        m_BlockSizes.pop_back();
     }
 
     inline void UpdateTotalSize()
     {
         if constexpr (UsageTrackingIsEnabled)
         {
-            SetTotalSize(m_BlockPtrs.size() * m_BlockSize);
+            SetTotalSize(m_TotalBlocksSize);
         }
     }
 
@@ -249,9 +385,15 @@ class LinearAllocator : public Allocator
     UIntPtr            m_CurrentStartAddress = 0;
     // ---------------------------------------
 
-    Size   m_BlockSize;
-    Offset m_CurrentOffset = 0;
+    Size       m_BlockSize     = 0; // Size of the current block
+    OffsetType m_CurrentOffset = 0;
+
+    std::vector<Size> m_BlockSizes;
+    Size              m_PreviousBlocksSize = 0; // Size of the blocks before the current one
+    Size              m_TotalBlocksSize    = 0;
+    BlockSizePolicy   m_BlockSizePolicy;
 
-    std::shared_ptr<Allocator> m_BaseAllocator;
+    NO_UNIQUE_ADDRESS ThreadTrackingPolicy m_ThreadTrackingPolicy;
+    NO_UNIQUE_ADDRESS BaseAllocator        m_BaseAllocator;
 };
 } // namespace Memarena
\ No newline at end of file
@@ -4,7 +4,7 @@
 
 namespace Memarena
 {
-template <Allocatable Object, auto Settings = AllocatorSettings<LinearAllocatorPolicy>()>
+template <Allocatable Object, auto Settings = AllocatorSettings<LinearAllocatorPolicy>(), BaseAllocatorType BaseAllocator = MallocBase>
 class LinearAllocatorTemplated
 {
   public:
@@ -16,8 +16,8 @@ class LinearAllocatorTemplated
     LinearAllocatorTemplated& operator=(LinearAllocatorTemplated&&) = delete;
 
     explicit LinearAllocatorTemplated(const Size totalSize, const std::string& debugName = "LinearAllocatorTemplated",
-                                      std::shared_ptr<Allocator> baseAllocator = Allocator::GetDefaultAllocator())
-        : m_LinearAllocator(totalSize, debugName, baseAllocator)
+                                      BaseAllocator baseAllocator = BaseAllocator())
+        : m_LinearAllocator(totalSize, debugName, std::move(baseAllocator))
     {
     }
 
@@ -73,6 +73,6 @@ class LinearAllocatorTemplated
     [[nodiscard]] std::string GetDebugName() const { return m_LinearAllocator.GetDebugName(); }
 
   private:
-    LinearAllocator<Settings> m_LinearAllocator;
+    LinearAllocator<Settings, BaseAllocator> m_LinearAllocator;
 };
 } // namespace Memarena
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <bit>
 #include <vector>
 
@@ -10,6 +11,7 @@
 #include "Source/Macros.hpp"
 #include "Source/Policies/MultithreadedPolicy.hpp"
 #include "Source/Policies/Policies.hpp"
+#include "Source/Probes.hpp"
 #include "Source/Traits.hpp"
 #include "Source/Utility/Alignment/Alignment.hpp"
 
@@ -49,8 +51,13 @@ class LocalAllocator : public Allocator
 
     ~LocalAllocator() = default;
 
-    NO_DISCARD void* AllocateBase(const Size size) final { return m_Memory[0]; }
-    void             DeallocateBase(void* ptr) final {}
+    NO_DISCARD void* AllocateBase(const Size size) final
+    {
+        MEMARENA_PROBE(allocate, this, m_Memory.data(), size);
+        return m_Memory.data();
+    }
+
+    void DeallocateBase(void* ptr, const Size size) final { MEMARENA_PROBE(deallocate, this, ptr); }
 
   private:
     std::array<char, TotalSize> m_Memory;
@@ -9,10 +9,14 @@
 #include "Source/AllocatorUtils.hpp"
 #include "Source/Assert.hpp"
 #include "Source/Macros.hpp"
+#include "Source/MemoryTracker.hpp"
 #include "Source/Policies/MultithreadedPolicy.hpp"
 #include "Source/Policies/Policies.hpp"
+#include "Source/Probes.hpp"
 #include "Source/Traits.hpp"
 #include "Source/Utility/Alignment/Alignment.hpp"
+#include "Source/Utility/MallocSize.hpp"
+#include "Source/Utility/Math.hpp"
 
 namespace Memarena
 {
@@ -61,6 +65,16 @@ class Mallocator : public Allocator
     static constexpr bool SizeTrackingIsEnabled       = PolicyContains(Policy, MallocatorPolicy::SizeTracking);
     static constexpr bool NeedsMultithreading         = AllocationTrackingIsEnabled || SizeTrackingIsEnabled;
     static constexpr bool IsMultithreaded             = PolicyContains(Policy, MallocatorPolicy::Multithreaded) && NeedsMultithreading;
+    static constexpr bool IsHeaderless                = PolicyContains(Policy, MallocatorPolicy::Headerless);
+    static constexpr bool HeapProfilingIsEnabled      = PolicyContains(Policy, MallocatorPolicy::HeapProfiling);
+    static constexpr bool ThreadTrackingIsEnabled     = PolicyContains(Policy, MallocatorPolicy::ThreadTracking);
+
+    // Header of raw allocations. `padding` is the distance from the pointer returned by malloc to the allocation
+    struct AllocationHeader
+    {
+        Size size;
+        Size padding;
+    };
 
     using ThreadPolicy = MultithreadedPolicy<IsMultithreaded>;
 
@@ -85,7 +99,7 @@ class Mallocator : public Allocator
     template <Allocatable Object, typename... Args>
     NO_DISCARD MallocPtr<Object> New(Args&&... argList)
     {
-        void* voidPtr = AllocateInternal(sizeof(Object));
+        void* voidPtr = AllocateInternal(sizeof(Object), "", SourceLocation::current(), 0, alignof(Object));
         RETURN_VAL_IF_NULLPTR(voidPtr, MallocPtr<Object>(nullptr, 0));
         Object* objectPtr = new (voidPtr) Object(std::forward<Args>(argList)...);
         return MallocPtr<Object>(objectPtr, sizeof(Object));
@@ -94,7 +108,7 @@ class Mallocator : public Allocator
     template <Allocatable Object, typename... Args>
     NO_DISCARD Object* NewRaw(Args&&... argList)
     {
-        void* voidPtr = Allocate(sizeof(Object));
+        void* voidPtr = Allocate(sizeof(Object), alignof(Object));
         RETURN_VAL_IF_NULLPTR(voidPtr, nullptr);
         Object* objectPtr = new (voidPtr) Object(std::forward<Args>(argList)...);
         return objectPtr;
@@ -103,7 +117,7 @@ class Mallocator : public Allocator
     template <Allocatable Object, typename... Args>
     NO_DISCARD MallocArrayPtr<Object> NewArray(const Size objectCount, Args&&... argList)
     {
-        void* voidPtr = AllocateInternal(sizeof(Object) * objectCount);
+        void* voidPtr = AllocateInternal(sizeof(Object) * objectCount, "", SourceLocation::current(), 0, alignof(Object));
         RETURN_VAL_IF_NULLPTR(voidPtr, MallocArrayPtr<Object>(nullptr, 0, 0));
         Object* objectPtr = Internal::ConstructArray<Object>(voidPtr, objectCount, std::forward<Args>(argList)...);
         return MallocArrayPtr<Object>(objectPtr, objectCount * sizeof(Object), objectCount);
@@ -112,7 +126,7 @@ class Mallocator : public Allocator
     template <Allocatable Object, typename... Args>
     NO_DISCARD Object* NewArrayRaw(const Size objectCount, Args&&... argList)
     {
-        void* voidPtr = AllocateArray(objectCount, sizeof(Object));
+        void* voidPtr = AllocateRawInternal(objectCount * sizeof(Object), alignof(Object));
         RETURN_VAL_IF_NULLPTR(voidPtr, nullptr);
         Object* objectPtr = Internal::ConstructArray<Object>(voidPtr, objectCount, std::forward<Args>(argList)...);
         return objectPtr;
@@ -128,8 +142,8 @@ class Mallocator : public Allocator
     template <Allocatable Object>
     void Delete(Object*& ptr)
     {
-        DeallocateInternalWithHeader(ptr);
         ptr->~Object();
+        DeallocateRawInternal(ptr, sizeof(Object));
     }
 
     template <Allocatable Object>
@@ -139,29 +153,47 @@ class Mallocator : public Allocator
         std::destroy_n(ptr.GetPtr(), ptr.GetCount());
     }
 
+    /**
+     * @brief Destroys and deallocates an array allocated with `NewArrayRaw`. Without a header the object count can't be recovered,
+     * so headerless allocators need the `objectCount` overload
+     */
     template <Allocatable Object>
-    void DeleteArray(Object*& ptr)
+    void DeleteArray(Object*& ptr) requires(!IsHeaderless)
     {
-        const Size size = DeallocateInternalWithHeader(ptr);
+        const Size size = GetAllocationSize(ptr);
         std::destroy_n(ptr, size / sizeof(Object));
+        DeallocateRawInternal(ptr, size);
+    }
+
+    template <Allocatable Object>
+    void DeleteArray(Object*& ptr, const Size objectCount)
+    {
+        std::destroy_n(ptr, objectCount);
+        DeallocateRawInternal(ptr, objectCount * sizeof(Object));
     }
 
     NO_DISCARD void* Allocate(const Size size, const std::string& category = "",
                               const SourceLocation& sourceLocation = SourceLocation::current())
     {
-        return AllocateInternalWithHeader(size, category, sourceLocation);
+        return AllocateRawInternal(size, defaultAlignment, category, sourceLocation);
+    }
+
+    NO_DISCARD void* Allocate(const Size size, const Alignment& alignment, const std::string& category = "",
+                              const SourceLocation& sourceLocation = SourceLocation::current())
+    {
+        return AllocateRawInternal(size, alignment, category, sourceLocation);
     }
 
     template <typename Object>
     NO_DISCARD void* Allocate(const std::string& category = "", const SourceLocation& sourceLocation = SourceLocation::current())
     {
-        return AllocateInternalWithHeader(sizeof(Object), category, sourceLocation);
+        return AllocateRawInternal(sizeof(Object), alignof(Object), category, sourceLocation);
     }
 
     NO_DISCARD void* AllocateArray(const Size objectCount, const Size objectSize, const std::string& category = "",
                                    const SourceLocation& sourceLocation = SourceLocation::current())
     {
-        return AllocateInternalWithHeader(objectCount * objectSize, category, sourceLocation);
+        return AllocateRawInternal(objectCount * objectSize, defaultAlignment, category, sourceLocation);
     }
 
     template <typename Object>
@@ -171,17 +203,41 @@ class Mallocator : public Allocator
         return AllocateArray(objectCount, sizeof(Object), category, sourceLocation);
     }
 
-    void Deallocate(void*& ptr) { DeallocateInternalWithHeader(ptr); }
-    Size DeallocateArray(void*& ptr) { return DeallocateInternalWithHeader(ptr); }
+    /**
+     * @brief Deallocates a raw allocation. Headerless allocators look the size up with `malloc_usable_size`, use the sized overload when
+     * the size is known
+     */
+    void Deallocate(void*& ptr) { DeallocateRawInternal(ptr, 0); }
+    void Deallocate(void*& ptr, const Size size) { DeallocateRawInternal(ptr, size); }
+    Size DeallocateArray(void*& ptr) requires(!IsHeaderless) { return DeallocateRawInternal(ptr, 0); }
+
+    /**
+     * @brief Returns the size of a raw allocation. This is the requested size when the allocation has a header and the usable size
+     * reported by malloc otherwise
+     */
+    [[nodiscard]] Size GetAllocationSize(void* ptr) const
+    {
+        if constexpr (IsHeaderless)
+        {
+            return Internal::GetMallocSize(ptr);
+        }
+        else
+        {
+            return std::get<0>(Internal::GetHeaderFromAddress<AllocationHeader>(std::bit_cast<UIntPtr>(ptr))).size;
+        }
+    }
 
-    NO_DISCARD void* AllocateBase(const Size size) final { return Allocate(size); }
-    void             DeallocateBase(void* ptr) final { Deallocate(ptr); }
+    // Final, so that a call through the concrete type, like the one of `MallocBase`, is a direct call. Blocks are never headed, since
+    // the arena passes their size back when it frees them, so a block is the pointer returned by malloc
+    NO_DISCARD void* AllocateBase(const Size size) final { return AllocateInternal(size); }
+    void             DeallocateBase(void* ptr, const Size size) final { DeallocateInternal(ptr, size); }
 
   private:
     NO_DISCARD void* AllocateInternal(const Size size, const std::string& category = "",
-                                      const SourceLocation& sourceLocation = SourceLocation::current(), Padding padding = 0)
+                                      const SourceLocation& sourceLocation = SourceLocation::current(), const Size padding = 0,
+                                      const Size alignment = defaultAlignment)
     {
-        void* ptr = malloc(padding + size);
+        void* ptr = Internal::MallocAligned(padding + size, alignment);
 
         if constexpr (NullAllocCheckIsEnabled)
         {
@@ -198,72 +254,123 @@ class Mallocator : public Allocator
             }
             if constexpr (SizeTrackingIsEnabled)
             {
-                IncreaseTotalSize(size);
-                IncreaseUsedSize(size);
+                const Size trackedSize = IsHeaderless ? Internal::GetMallocSize(ptr) : size;
+                IncreaseTotalSize(trackedSize);
+                IncreaseUsedSize(trackedSize);
             }
         }
 
+        // The counters are per thread, so they don't need the lock. There is no release to balance, so the Mallocator reports to the
+        // tracker directly instead of keeping a live size in the thread tracking policy
+        if constexpr (ThreadTrackingIsEnabled)
+        {
+            MemoryTracker::AddThreadAllocation(IsHeaderless ? Internal::GetMallocSize(ptr) : size);
+        }
+
+        // Samples are keyed by the pointer returned by malloc, which is what `DeallocateInternal` gets
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            SampleAllocation(ptr, size);
+        }
+
         UIntPtr address       = std::bit_cast<UIntPtr>(ptr);
         void*   allocationPtr = std::bit_cast<void*>(address + padding);
 
+        MEMARENA_PROBE(allocate, this, allocationPtr, size);
+
         return allocationPtr;
     }
 
-    void* AllocateInternalWithHeader(const Size size, const std::string& category = "",
-                                     const SourceLocation& sourceLocation = SourceLocation::current())
+    // Allocates memory for `Allocate`. With a header, the header goes right before the allocation and the padding in front of it keeps
+    // the allocation aligned, so raw allocations are at least aligned to `std::max_align_t`
+    NO_DISCARD void* AllocateRawInternal(const Size size, const Alignment& alignment, const std::string& category = "",
+                                         const SourceLocation& sourceLocation = SourceLocation::current())
     {
-        const Padding padding = ExtendPaddingForHeader(0, alignof(size), sizeof(MallocHeader));
-        void*         ptr     = AllocateInternal(size, category, sourceLocation, padding);
-        Internal::AllocateHeader<MallocHeader>(ptr, size);
-        return ptr;
+        const Size allocationAlignment = std::max<Size>(alignment, defaultAlignment);
+
+        if constexpr (IsHeaderless)
+        {
+            return AllocateInternal(size, category, sourceLocation, 0, allocationAlignment);
+        }
+        else
+        {
+            const Size padding = RoundUpToMultiple(sizeof(AllocationHeader), allocationAlignment);
+            void*      ptr     = AllocateInternal(size, category, sourceLocation, padding, allocationAlignment);
+            RETURN_VAL_IF_NULLPTR(ptr, nullptr);
+            Internal::AllocateHeader<AllocationHeader>(ptr, AllocationHeader{.size = size, .padding = padding});
+            return ptr;
+        }
     }
 
-    template <typename Object>
-    void DeallocateInternal(Ptr<Object>& ptr, Size size)
+    // Deallocates memory from `Allocate`. `size` is the requested size or 0 if it is unknown, it is only needed by headerless allocators
+    template <typename T>
+    Size DeallocateRawInternal(T*& ptr, Size size)
     {
         if constexpr (NullDeallocCheckIsEnabled || DoubleFreePreventionIsEnabled)
         {
-            MEMARENA_ASSERT_RETURN(ptr, void(), "Error: Cannot deallocate nullptr in allocator '%s'!\n", GetDebugName().c_str());
+            MEMARENA_ASSERT_RETURN(ptr, 0, "Error: Cannot deallocate nullptr in allocator '%s'!\n", GetDebugName().c_str());
         }
 
-        DeallocateInternal(ptr.GetPtr(), size);
+        void* mallocPtr = ptr;
+
+        if constexpr (!IsHeaderless)
+        {
+            const UIntPtr address        = std::bit_cast<UIntPtr>(ptr);
+            auto [header, headerAddress] = Internal::GetHeaderFromAddress<AllocationHeader>(address);
+
+            // We can't call `free(ptr)` because `ptr` not the same as the one returned by malloc, since we added padding for header
+            // So we subtract that padding to get the original pointer
+            mallocPtr = std::bit_cast<void*>(address - header.padding);
+            size      = header.size;
+        }
+
+        DeallocateInternal(mallocPtr, size);
 
         if constexpr (DoubleFreePreventionIsEnabled)
         {
-            ptr.Reset();
+            ptr = nullptr;
         }
+
+        return size;
     }
 
-    template <typename T>
-    Size DeallocateInternalWithHeader(T*& ptr)
+    template <typename Object>
+    void DeallocateInternal(Ptr<Object>& ptr, Size size)
     {
         if constexpr (NullDeallocCheckIsEnabled || DoubleFreePreventionIsEnabled)
         {
-            MEMARENA_ASSERT_RETURN(ptr, 0, "Error: Cannot deallocate nullptr in allocator '%s'!\n", GetDebugName().c_str());
+            MEMARENA_ASSERT_RETURN(ptr, void(), "Error: Cannot deallocate nullptr in allocator '%s'!\n", GetDebugName().c_str());
         }
 
-        const UIntPtr address        = std::bit_cast<UIntPtr>(ptr);
-        auto [header, headerAddress] = Internal::GetHeaderFromAddress<MallocHeader>(address);
-        const Padding padding        = ExtendPaddingForHeader(0, alignof(header.size), sizeof(MallocHeader));
-
-        // We can't call `free(ptr)` because `ptr` not the same as the one returned by malloc, since we added padding for header
-        // So we subtract that padding to get the original pointer
-        const UIntPtr mallocAddress = address - padding;
-        void*         mallocPtr     = std::bit_cast<void*>(mallocAddress);
-        DeallocateInternal(mallocPtr, header.size);
+        DeallocateInternal(ptr.GetPtr(), size);
 
         if constexpr (DoubleFreePreventionIsEnabled)
         {
-            ptr = nullptr;
+            ptr.Reset();
         }
-
-        return header.size;
     }
 
     void DeallocateInternal(void* ptr, Size size)
     {
+        // Headerless allocations are tracked with their usable size, which also covers the requested size
+        if constexpr (IsHeaderless && (SizeTrackingIsEnabled || ThreadTrackingIsEnabled))
+        {
+            size = Internal::GetMallocSize(ptr);
+        }
 
-        free(ptr);
+        if constexpr (ThreadTrackingIsEnabled)
+        {
+            MemoryTracker::AddThreadDeallocation(size);
+        }
+
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            SampleDeallocation(ptr);
+        }
+
+        MEMARENA_PROBE(deallocate, this, ptr);
+
+        Internal::FreeAligned(ptr);
 
         {
             LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
@@ -285,4 +392,30 @@ class Mallocator : public Allocator
 
     ThreadPolicy m_MultithreadedPolicy;
 };
+
+constexpr MallocatorSettings defaultAllocatorSettings = {.policy = MallocatorPolicy::Default};
+
+// The concrete type of `Allocator::GetDefaultAllocator()`
+using DefaultMallocator = Mallocator<defaultAllocatorSettings>;
+
+/**
+ * @brief The default base allocator of the arenas. The blocks come from the default allocator, so they count towards its stats and
+ * `MemoryTracker::GetTotalAllocatedSize`, but it is stateless and calls the concrete type of the default allocator, so with
+ * `[[no_unique_address]]` it takes up no space in the arena and growing the arena is a direct call
+ */
+struct MallocBase
+{
+    static constexpr bool FreesInAnyOrder = true;
+
+    NO_DISCARD void* AllocateBase(const Size size) const { return GetDefaultMallocator().AllocateBase(size); }
+    void             DeallocateBase(void* ptr, const Size size) const { GetDefaultMallocator().DeallocateBase(ptr, size); }
+
+    [[nodiscard]] const Allocator* GetAllocator() const { return &GetDefaultMallocator(); }
+
+  private:
+    [[nodiscard]] static DefaultMallocator& GetDefaultMallocator()
+    {
+        return static_cast<DefaultMallocator&>(*Allocator::GetDefaultAllocator());
+    }
+};
 } // namespace Memarena
\ No newline at end of file
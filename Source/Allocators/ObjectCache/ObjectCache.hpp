@@ -0,0 +1,168 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Source/Allocators/PoolAllocator/PoolAllocator.hpp"
+#include "Source/Macros.hpp"
+#include "Source/Policies/MultithreadedPolicy.hpp"
+#include "Source/Traits.hpp"
+#include "Source/Utility/Math.hpp"
+
+namespace Memarena
+{
+
+/**
+ * @brief Resets objects that have a `Reset()` member function when they are returned to an ObjectCache and leaves all other objects
+ * untouched
+ */
+struct DefaultObjectResetter
+{
+    template <typename Object>
+    void operator()(Object& object) const
+    {
+        if constexpr (requires { object.Reset(); })
+        {
+            object.Reset();
+        }
+    }
+};
+
+/**
+ * @brief A slab-style cache for objects that are expensive to construct. Objects returned with `Release` stay constructed and are
+ * only passed to `Resetter`, so the next `Acquire` hands them out without running a constructor. Objects are destroyed and their
+ * memory returned to the pool only by `Trim` or when the cache is destroyed, so construction becomes a one-time cost per slot
+ *
+ * @tparam Resetter Called with every released object to bring it back to a reusable state
+ */
+template <Allocatable Object, PoolAllocatorSettings Settings = poolAllocatorDefaultSettings, typename Resetter = DefaultObjectResetter,
+          BaseAllocatorType BaseAllocator = MallocBase>
+class ObjectCache
+{
+  private:
+    static_assert(alignof(Object) <= alignof(std::max_align_t), "Over-aligned types are not supported by ObjectCache");
+
+    static constexpr bool IsMultithreaded = PolicyContains(Settings.policy, PoolAllocatorPolicy::Multithreaded);
+
+    using ThreadPolicy = MultithreadedPolicy<IsMultithreaded>;
+
+    template <typename SyncPrimitive>
+    using LockGuard = typename ThreadPolicy::template LockGuard<SyncPrimitive>;
+    using Mutex     = typename ThreadPolicy::Mutex;
+
+    // Chunks hold the free list link while they are free and every chunk must stay aligned for `Object`
+    static inline const Size ObjectSize = RoundUpToMultiple(std::max(sizeof(Object), sizeof(void*)), alignof(Object));
+
+  public:
+    // Prohibit default construction, moving and assignment
+    ObjectCache()                   = delete;
+    ObjectCache(const ObjectCache&) = delete;
+    ObjectCache(ObjectCache&)       = delete;
+    ObjectCache(ObjectCache&&)      = delete;
+    ObjectCache& operator=(const ObjectCache&) = delete;
+    ObjectCache& operator=(ObjectCache&&) = delete;
+
+    explicit ObjectCache(const Size objectsPerBlock, const std::string& debugName = "ObjectCache", Resetter resetter = Resetter(),
+                         BaseAllocator baseAllocator = BaseAllocator())
+        : m_PoolAllocator(ObjectSize, objectsPerBlock, debugName, std::move(baseAllocator)), m_Resetter(std::move(resetter))
+    {
+    }
+
+    /**
+     * @brief Destroys the cached objects. Objects that are still acquired are not destroyed, but their memory is freed with the pool
+     */
+    ~ObjectCache() { Trim(0); }
+
+    /**
+     * @brief Returns a cached object if there is one, otherwise constructs a new object from `argList`. The arguments are ignored for
+     * cached objects, which keep the state they had when they were released and reset
+     */
+    template <typename... Args>
+    NO_DISCARD Object* Acquire(Args&&... argList)
+    {
+        {
+            LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+            if (!m_CachedObjects.empty())
+            {
+                Object* object = m_CachedObjects.back();
+                m_CachedObjects.pop_back();
+                m_AcquiredCount++;
+                return object;
+            }
+        }
+
+        void* voidPtr = m_PoolAllocator.Allocate(ObjectSize);
+        RETURN_IF_NULLPTR(voidPtr);
+        Object* object = std::construct_at(static_cast<Object*>(voidPtr), std::forward<Args>(argList)...);
+
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        m_ConstructedCount++;
+        m_AcquiredCount++;
+
+        return object;
+    }
+
+    /**
+     * @brief Resets the object and keeps it constructed in the cache for the next `Acquire`
+     */
+    void Release(Object*& object)
+    {
+        MEMARENA_ASSERT_RETURN(object != nullptr, void(), "Error: Cannot release nullptr in the cache '%s'!\n", GetDebugName().c_str());
+
+        m_Resetter(*object);
+
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        m_CachedObjects.push_back(object);
+        m_AcquiredCount--;
+        object = nullptr;
+    }
+
+    /**
+     * @brief Destroys cached objects until at most `keepCount` are left and returns their memory to the pool. With block-local free
+     * lists, pool blocks that become empty are freed as well
+     */
+    void Trim(const Size keepCount = 0)
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        while (m_CachedObjects.size() > keepCount)
+        {
+            Object* object = m_CachedObjects.back();
+            m_CachedObjects.pop_back();
+
+            std::destroy_at(object);
+            void* voidPtr = object;
+            m_PoolAllocator.Deallocate(voidPtr);
+            m_ConstructedCount--;
+        }
+
+        if constexpr (requires { m_PoolAllocator.ReleaseEmptyBlocks(); })
+        {
+            m_PoolAllocator.ReleaseEmptyBlocks();
+        }
+    }
+
+    [[nodiscard]] bool Owns(Object* object) const { return m_PoolAllocator.Owns(object); }
+
+    [[nodiscard]] Size GetCachedCount() const { return m_CachedObjects.size(); }
+    [[nodiscard]] Size GetAcquiredCount() const { return m_AcquiredCount; }
+    [[nodiscard]] Size GetConstructedCount() const { return m_ConstructedCount; }
+
+    [[nodiscard]] Size        GetUsedSize() const { return m_PoolAllocator.GetUsedSize(); }
+    [[nodiscard]] Size        GetTotalSize() const { return m_PoolAllocator.GetTotalSize(); }
+    [[nodiscard]] std::string GetDebugName() const { return m_PoolAllocator.GetDebugName(); }
+
+  private:
+    PoolAllocator<Settings, BaseAllocator> m_PoolAllocator;
+    Resetter                               m_Resetter;
+
+    ThreadPolicy m_MultithreadedPolicy;
+
+    std::vector<Object*> m_CachedObjects;
+    Size                 m_AcquiredCount    = 0;
+    Size                 m_ConstructedCount = 0; // Objects that are constructed, both acquired and cached
+};
+} // namespace Memarena
@@ -1,17 +1,25 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <numeric>
 #include <vector>
 
 #include "Source/Allocator.hpp"
 #include "Source/AllocatorData.hpp"
 #include "Source/AllocatorSettings.hpp"
 #include "Source/AllocatorUtils.hpp"
+#include "Source/Allocators/Mallocator/Mallocator.hpp"
 #include "Source/Assert.hpp"
 #include "Source/Macros.hpp"
+#include "Source/Policies/AdaptiveBlockSizePolicy.hpp"
+#include "Source/Policies/ThreadTrackingPolicy.hpp"
 #include "Source/Policies/BoundsCheckPolicy.hpp"
 #include "Source/Policies/MultithreadedPolicy.hpp"
 #include "Source/Policies/Policies.hpp"
+#include "Source/Probes.hpp"
 #include "Source/Traits.hpp"
 #include "Source/Utility/Alignment/Alignment.hpp"
 
@@ -33,7 +41,7 @@ template <typename T>
 class PoolPtr : public Ptr<T>
 {
     // Allow only StackAllocator to create a StackPtr by making constructors private
-    template <PoolAllocatorSettings Settings>
+    template <PoolAllocatorSettings Settings, BaseAllocatorType BaseAllocator>
     friend class PoolAllocator;
 
   private:
@@ -44,7 +52,7 @@ template <typename T>
 class PoolArrayPtr : public ArrayPtr<T>
 {
     // Allow only StackAllocator to create a StackPtr by making constructors private
-    template <PoolAllocatorSettings Settings>
+    template <PoolAllocatorSettings Settings, BaseAllocatorType BaseAllocator>
     friend class PoolAllocator;
 
   private:
@@ -61,9 +69,20 @@ struct Chunk
 {
     Chunk* nextChunk;
 };
+
+struct PoolBlock
+{
+    static constexpr Size None = std::numeric_limits<Size>::max();
+
+    void* freeList      = nullptr;
+    Size  freeCount     = 0;
+    Size  bin           = None;
+    Size  previousInBin = None;
+    Size  nextInBin     = None;
+};
 } // namespace Internal
 
-template <PoolAllocatorSettings Settings = poolAllocatorDefaultSettings>
+template <PoolAllocatorSettings Settings = poolAllocatorDefaultSettings, BaseAllocatorType BaseAllocator = MallocBase>
 class PoolAllocator : public Allocator
 {
     template <PoolAllocatorSettings PMRSettings>
@@ -80,9 +99,24 @@ class PoolAllocator : public Allocator
     static constexpr bool IsGrowable                    = PolicyContains(Policy, PoolAllocatorPolicy::Growable);
     static constexpr bool IsMultithreaded               = PolicyContains(Policy, PoolAllocatorPolicy::Multithreaded);
     static constexpr bool AllocationTrackingIsEnabled   = PolicyContains(Policy, PoolAllocatorPolicy::AllocationTracking);
+    static constexpr bool IsAddressOrdered              = PolicyContains(Policy, PoolAllocatorPolicy::AddressOrdered);
+    static constexpr bool HasBlockLocalFreeLists        = PolicyContains(Policy, PoolAllocatorPolicy::BlockLocalFreeLists);
+    static constexpr bool HasAdaptiveBlockSize          = PolicyContains(Policy, PoolAllocatorPolicy::AdaptiveBlockSize);
+    static constexpr bool HeapProfilingIsEnabled        = PolicyContains(Policy, PoolAllocatorPolicy::HeapProfiling);
+    static constexpr bool ThreadTrackingIsEnabled       = PolicyContains(Policy, PoolAllocatorPolicy::ThreadTracking);
+    static constexpr bool BlocksAreFreedInAnyOrder      = BaseFreesInAnyOrder<BaseAllocator>;
+
+    static_assert(!HasAdaptiveBlockSize || IsGrowable, "The adaptive block size policy requires the growable policy");
 
-    using ThreadPolicy = MultithreadedPolicy<IsMultithreaded, IsGrowable>;
-    using Chunk        = Internal::Chunk;
+    static constexpr Size NoBlock     = Internal::PoolBlock::None;
+    static constexpr Size NoBin       = Internal::PoolBlock::None;
+    static constexpr Size BinCount    = 8;
+    static constexpr Size BitsPerWord = 64;
+
+    using ThreadPolicy         = MultithreadedPolicy<IsMultithreaded, IsGrowable>;
+    using BlockSizePolicy      = AdaptiveBlockSizePolicy<HasAdaptiveBlockSize>;
+    using ThreadTrackingPolicy = Memarena::ThreadTrackingPolicy<ThreadTrackingIsEnabled>;
+    using Chunk                = Internal::Chunk;
 
     template <typename SyncPrimitive>
     using LockGuard = typename ThreadPolicy::template LockGuard<SyncPrimitive>;
@@ -98,22 +132,42 @@ class PoolAllocator : public Allocator
     PoolAllocator& operator=(PoolAllocator&&) = delete;
 
     explicit PoolAllocator(const Size objectSize, const Size objectsPerBlock, const std::string& debugName = "PoolAllocator",
-                           std::shared_ptr<Allocator> baseAllocator = Allocator::GetDefaultAllocator())
-        : Allocator(0, debugName), m_ObjectSize(objectSize), m_ObjectsPerBlock(objectsPerBlock), m_BlockSize(objectSize * objectsPerBlock),
-          m_BaseAllocator(std::move(baseAllocator))
+                           BaseAllocator baseAllocator = BaseAllocator())
+        : PoolAllocator(objectSize, objectsPerBlock, BlockSizeBounds{}, debugName, std::move(baseAllocator))
+    {
+    }
+
+    /**
+     * @brief With the adaptive block size policy, the number of objects in new blocks follows the observed demand within
+     * `objectsPerBlockBounds`, starting from `objectsPerBlock`. Without it the bounds are ignored
+     */
+    PoolAllocator(const Size objectSize, const Size objectsPerBlock, const BlockSizeBounds& objectsPerBlockBounds,
+                  const std::string& debugName = "PoolAllocator", BaseAllocator baseAllocator = BaseAllocator())
+        : Allocator(0, debugName), m_BaseAllocator(std::move(baseAllocator)), m_ObjectSize(objectSize),
+          m_BlockSizePolicy(objectsPerBlock, objectsPerBlockBounds)
     {
         MEMARENA_ASSERT(objectSize >= sizeof(Chunk), "Error: Object size must be >= to the pointer size (%u) for the allocator '%s'\n",
                         sizeof(void*), GetDebugName().c_str());
         MEMARENA_ASSERT(objectsPerBlock > 0, "Error: Objects per block must be greater than 0 for the allocator '%s'\n",
                         GetDebugName().c_str());
-        AllocateBlock();
+        RecordBaseAllocator(GetTrackedAllocator(m_BaseAllocator));
+        m_BinHeads.fill(NoBlock);
+        AllocateBlock(m_BlockSizePolicy.GetInitialBlockSize());
     }
 
     ~PoolAllocator()
     {
-        for (void* ptr : m_BlockPtrs)
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            ReleaseSamples();
+        }
+
+        m_ThreadTrackingPolicy.RecordRelease();
+
+        // Blocks are freed in reverse order, so that a StackAllocator can be the base allocator
+        for (Size blockIndex = m_BlockPtrs.size(); blockIndex-- > 0;)
         {
-            m_BaseAllocator->DeallocateBase(ptr);
+            m_BaseAllocator.DeallocateBase(m_BlockPtrs[blockIndex], m_BlockChunkCounts[blockIndex] * m_ObjectSize);
         };
     }
 
@@ -181,15 +235,76 @@ class PoolAllocator : public Allocator
 
     void Deallocate(void*& ptr) { DeallocateInternal(ptr); }
 
+    /**
+     * @brief Hands out `size` bytes as consecutive chunks, so child arenas can carve their blocks out of the pool. Every block of a
+     * child has to fit into a block of the pool
+     */
+    NO_DISCARD void* AllocateBase(const Size size) final
+    {
+        const Size chunkCount = GetChunkCount(size);
+        return chunkCount == 1 ? AllocateInternal() : AllocateArrayInternal(chunkCount);
+    }
+
+    void DeallocateBase(void* ptr, const Size size) final { DeallocateArrayInternal(ptr, GetChunkCount(size)); }
+
+    /**
+     * @brief Rebuilds the free list so that free chunks are handed out in ascending address order, block by block. After heavy
+     * churn the LIFO free list is scattered across all blocks; sorting it makes subsequent allocations dense and sequential and
+     * lets array allocations find consecutive chunks again.
+     *
+     * Complexity: O(F log B + C) where F is the number of free chunks, B the number of blocks and C the total number of chunks
+     */
+    void SortFreeList()
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        SortFreeListInternal();
+    }
+
+    /**
+     * @brief Frees every block that has no live objects, keeping at least one block. If the base allocator doesn't free in any order,
+     * blocks are freed in reverse order of their allocation, so an empty block stays until every block after it is empty too. Only
+     * available with block-local free lists, since only then blocks drain completely instead of sharing their free chunks with the
+     * other blocks
+     */
+    void ReleaseEmptyBlocks() requires HasBlockLocalFreeLists
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        ReleaseEmptyBlocksInternal();
+    }
+
+    /**
+     * @brief Frees all objects at once and returns the allocator to a single block. Destructors are not called. With the adaptive block
+     * size policy, the kept block is resized to fit the peak number of live objects since the last release
+     */
+    void Release()
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        MEMARENA_PROBE(release, this);
+        ReleaseInternal();
+        m_ThreadTrackingPolicy.RecordRelease();
+
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            ReleaseSamples();
+        }
+    }
+
     [[nodiscard]] Size GetObjectSize() const { return m_ObjectSize; }
+    [[nodiscard]] Size GetBlockCount() const { return m_BlockPtrs.size(); }
+    [[nodiscard]] Size GetObjectsPerBlock(const Size blockIndex) const { return m_BlockChunkCounts[blockIndex]; }
 
     [[nodiscard]] bool Owns(UIntPtr address) const
     {
-        return std::ranges::any_of(m_BlockPtrs, [&](void* blockPtr) {
-            const UIntPtr startAddress = std::bit_cast<UIntPtr>(blockPtr);
-            const UIntPtr endAddress   = startAddress + m_BlockSize;
-            return address >= startAddress && address <= endAddress;
-        });
+        for (Size blockIndex = 0; blockIndex < m_BlockPtrs.size(); blockIndex++)
+        {
+            const UIntPtr startAddress = std::bit_cast<UIntPtr>(m_BlockPtrs[blockIndex]);
+            const UIntPtr endAddress   = startAddress + m_BlockChunkCounts[blockIndex] * m_ObjectSize;
+            if (address >= startAddress && address < endAddress)
+            {
+                return true;
+            }
+        }
+        return false;
     }
     [[nodiscard]] bool Owns(void* ptr) const { return Owns(std::bit_cast<UIntPtr>(ptr)); }
 
@@ -227,19 +342,45 @@ class PoolAllocator : public Allocator
 
         LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
 
-        if constexpr (IsGrowable)
+        void* freePtr = nullptr;
+
+        if constexpr (HasBlockLocalFreeLists)
         {
-            if (m_CurrentPtr == nullptr)
+            Size blockIndex = GetFullestBlock();
+
+            if constexpr (IsGrowable)
             {
-                AllocateBlock();
+                if (blockIndex == NoBlock && AllocateBlock(m_BlockSizePolicy.GetGrowthBlockSize()))
+                {
+                    blockIndex = GetFullestBlock();
+                }
             }
+
+            MEMARENA_ASSERT_RETURN(blockIndex != NoBlock, nullptr, "Error: The allocator '%s' is out of memory!\n", GetDebugName().c_str());
+
+            Internal::PoolBlock& block = m_Blocks[blockIndex];
+            freePtr                    = PopChunk(block.freeList);
+            block.freeCount--;
+            UpdateBin(blockIndex);
         }
+        else
+        {
+            if constexpr (IsGrowable)
+            {
+                if (m_CurrentPtr == nullptr)
+                {
+                    AllocateBlock(m_BlockSizePolicy.GetGrowthBlockSize());
+                }
+            }
 
-        MEMARENA_ASSERT_RETURN(m_CurrentPtr != nullptr, nullptr, "Error: The allocator '%s' is out of memory!\n", GetDebugName().c_str());
+            MEMARENA_ASSERT_RETURN(m_CurrentPtr != nullptr, nullptr, "Error: The allocator '%s' is out of memory!\n",
+                                   GetDebugName().c_str());
+
+            freePtr = PopChunk(m_CurrentPtr);
+        }
 
-        void*  freePtr      = m_CurrentPtr;
-        Chunk* currentChunk = std::bit_cast<Chunk*>(m_CurrentPtr);
-        m_CurrentPtr        = currentChunk->nextChunk;
+        m_BlockSizePolicy.RecordAllocation(1);
+        m_ThreadTrackingPolicy.RecordAllocation(m_ObjectSize);
 
         if constexpr (AllocationTrackingIsEnabled)
         {
@@ -251,6 +392,13 @@ class PoolAllocator : public Allocator
             IncreaseUsedSize(m_ObjectSize);
         }
 
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            SampleAllocation(freePtr, m_ObjectSize);
+        }
+
+        MEMARENA_PROBE(allocate, this, freePtr, m_ObjectSize);
+
         return freePtr;
     }
 
@@ -258,36 +406,103 @@ class PoolAllocator : public Allocator
                                            const SourceLocation& sourceLocation = SourceLocation::current())
     {
 
-        MEMARENA_ASSERT_RETURN(objectCount <= m_ObjectsPerBlock, nullptr,
-                               "Error: Allocation object count (%u) must be <= to objects per block (%u) for allocator '%s'!\n",
-                               objectCount, m_BlockSize, GetDebugName().c_str());
+        const Size maxObjectsPerBlock = m_BlockSizePolicy.GetMaxBlockSize();
+        MEMARENA_ASSERT_RETURN(objectCount <= maxObjectsPerBlock, nullptr,
+                               "Error: Allocation object count (%zu) must be <= to objects per block (%zu) for allocator '%s'!\n",
+                               objectCount, maxObjectsPerBlock, GetDebugName().c_str());
 
         LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
 
-        // To allocate an array, all the chunks must be consecutive. So we search the blocks and try to find such a sequence
-        Chunk* currentChunk           = std::bit_cast<Chunk*>(m_CurrentPtr);
-        Chunk* startingChunk          = currentChunk;
-        Size   consecutiveChunksFound = 1;
+        if constexpr (IsAddressOrdered)
+        {
+            if (!m_FreeListIsSorted)
+            {
+                SortFreeListInternal();
+            }
+        }
 
-        while (consecutiveChunksFound < objectCount)
+        // To allocate an array, all the chunks must be consecutive. So we search the free list and try to find such a sequence
+        void* arrayPtr = TakeConsecutiveChunks(objectCount);
+
+        if constexpr (IsGrowable)
         {
+            if (arrayPtr == nullptr && AllocateBlock(std::max(m_BlockSizePolicy.GetGrowthBlockSize(), objectCount)))
+            {
+                // We know for sure that the newly allocated block has the required number of consecutive chunks
+                arrayPtr = TakeConsecutiveChunks(objectCount);
+            }
+        }
 
-            if constexpr (IsGrowable)
+        MEMARENA_ASSERT_RETURN(arrayPtr != nullptr, nullptr, "Error: The allocator '%s' is out of memory!\n", GetDebugName().c_str());
+
+        m_BlockSizePolicy.RecordAllocation(objectCount);
+        m_ThreadTrackingPolicy.RecordAllocation(m_ObjectSize * objectCount);
+
+        if constexpr (AllocationTrackingIsEnabled)
+        {
+            AddAllocation(m_ObjectSize * objectCount, category, sourceLocation);
+        }
+
+        if constexpr (UsageTrackingIsEnabled)
+        {
+            IncreaseUsedSize(m_ObjectSize * objectCount);
+        }
+
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            SampleAllocation(arrayPtr, m_ObjectSize * objectCount);
+        }
+
+        MEMARENA_PROBE(allocate, this, arrayPtr, m_ObjectSize * objectCount);
+
+        return arrayPtr;
+    }
+
+    NO_DISCARD void* TakeConsecutiveChunks(const Size objectCount)
+    {
+        if constexpr (HasBlockLocalFreeLists)
+        {
+            // Search the blocks from the fullest to the emptiest, so that arrays also concentrate in the blocks that are already in use
+            for (Size bin = BinCount; bin-- > 0;)
             {
-                if (currentChunk == nullptr)
+                for (Size blockIndex = m_BinHeads[bin]; blockIndex != NoBlock; blockIndex = m_Blocks[blockIndex].nextInBin)
                 {
-                    AllocateBlock();
-                    // We know for sure that the newly allocated block has the required number of consecutive chunks
-                    // So we can just return the starting pointer of the new block
-                    startingChunk = std::bit_cast<Chunk*>(m_CurrentPtr);
-                    break;
+                    void* arrayPtr = TakeConsecutiveChunks(m_Blocks[blockIndex].freeList, objectCount);
+                    if (arrayPtr != nullptr)
+                    {
+                        m_Blocks[blockIndex].freeCount -= objectCount;
+                        UpdateBin(blockIndex);
+                        return arrayPtr;
+                    }
                 }
             }
 
-            MEMARENA_ASSERT_RETURN(m_CurrentPtr != nullptr, nullptr, "Error: The allocator '%s' is out of memory!\n",
-                                   GetDebugName().c_str());
+            return nullptr;
+        }
+        else
+        {
+            return TakeConsecutiveChunks(m_CurrentPtr, objectCount);
+        }
+    }
 
-            const UIntPtr nextChunkAddress       = std::bit_cast<UIntPtr>(currentChunk->nextChunk);
+    // Finds `objectCount` chunks that are both consecutive in memory and in the free list, and unlinks them from the free list
+    NO_DISCARD void* TakeConsecutiveChunks(void*& freeList, const Size objectCount)
+    {
+        Chunk* currentChunk = std::bit_cast<Chunk*>(freeList);
+
+        RETURN_IF_NULLPTR(currentChunk);
+
+        Chunk* previousChunk          = nullptr; // The chunk linking to the start of the current sequence
+        Chunk* startingChunk          = currentChunk;
+        Size   consecutiveChunksFound = 1;
+
+        while (consecutiveChunksFound < objectCount)
+        {
+            Chunk* nextChunk = currentChunk->nextChunk;
+
+            RETURN_IF_NULLPTR(nextChunk);
+
+            const UIntPtr nextChunkAddress       = std::bit_cast<UIntPtr>(nextChunk);
             const UIntPtr proceedingChunkAddress = std::bit_cast<UIntPtr>(currentChunk) + m_ObjectSize;
             if (nextChunkAddress == proceedingChunkAddress)
             {
@@ -295,30 +510,24 @@ class PoolAllocator : public Allocator
             }
             else
             {
-                startingChunk          = currentChunk->nextChunk;
+                previousChunk          = currentChunk;
+                startingChunk          = nextChunk;
                 consecutiveChunksFound = 1;
             }
-            currentChunk = currentChunk->nextChunk;
+            currentChunk = nextChunk;
         }
 
-        if constexpr (AllocationTrackingIsEnabled)
+        // `currentChunk` is now the last chunk of the sequence
+        if (previousChunk == nullptr)
         {
-            AddAllocation(m_ObjectSize * objectCount, category, sourceLocation);
+            freeList = currentChunk->nextChunk;
         }
-
-        if constexpr (UsageTrackingIsEnabled)
+        else
         {
-            IncreaseUsedSize(m_ObjectSize * objectCount);
+            previousChunk->nextChunk = currentChunk->nextChunk;
         }
 
-        const UIntPtr startingAddress = std::bit_cast<UIntPtr>(startingChunk);
-        if (startingAddress == std::bit_cast<UIntPtr>(m_CurrentPtr))
-        {
-            const UIntPtr endAddress = startingAddress + m_ObjectSize * objectCount;
-            m_CurrentPtr             = std::bit_cast<void*>(endAddress);
-        }
-
-        return std::bit_cast<void*>(startingChunk);
+        return startingChunk;
     }
 
     void DeallocateVoidInternal(void* ptr)
@@ -330,9 +539,9 @@ class PoolAllocator : public Allocator
             return;
         }
 
-        Chunk* chunk     = std::bit_cast<Chunk*>(ptr);
-        chunk->nextChunk = std::bit_cast<Chunk*>(m_CurrentPtr);
-        m_CurrentPtr     = ptr;
+        PushChunks(ptr, 1);
+        m_BlockSizePolicy.RecordDeallocation(1);
+        m_ThreadTrackingPolicy.RecordDeallocation(m_ObjectSize);
 
         if constexpr (AllocationTrackingIsEnabled)
         {
@@ -343,6 +552,13 @@ class PoolAllocator : public Allocator
         {
             DecreaseUsedSize(m_ObjectSize);
         }
+
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            SampleDeallocation(ptr);
+        }
+
+        MEMARENA_PROBE(deallocate, this, ptr);
     }
 
     void DeallocateArrayInternal(void* ptr, Size objectCount)
@@ -354,12 +570,9 @@ class PoolAllocator : public Allocator
             return;
         }
 
-        const UIntPtr startAddress = std::bit_cast<UIntPtr>(ptr);
-        const UIntPtr lastAddress  = startAddress + m_ObjectSize * (objectCount - 1);
-
-        Chunk* lastChunk     = std::bit_cast<Chunk*>(lastAddress);
-        lastChunk->nextChunk = std::bit_cast<Chunk*>(m_CurrentPtr);
-        m_CurrentPtr         = ptr;
+        PushChunks(ptr, objectCount);
+        m_BlockSizePolicy.RecordDeallocation(objectCount);
+        m_ThreadTrackingPolicy.RecordDeallocation(m_ObjectSize * objectCount);
 
         if constexpr (AllocationTrackingIsEnabled)
         {
@@ -370,48 +583,426 @@ class PoolAllocator : public Allocator
         {
             DecreaseUsedSize(m_ObjectSize * objectCount);
         }
+
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            SampleDeallocation(ptr);
+        }
+
+        MEMARENA_PROBE(deallocate, this, ptr);
+    }
+
+    void* PopChunk(void*& freeList)
+    {
+        void*  freePtr = freeList;
+        Chunk* chunk   = std::bit_cast<Chunk*>(freeList);
+        freeList       = chunk->nextChunk;
+        return freePtr;
+    }
+
+    // Pushes `chunkCount` consecutive chunks starting at `ptr` on the free list they belong to
+    void PushChunks(void* ptr, const Size chunkCount)
+    {
+        // Objects overwrite the links between the chunks, so we chain them again before pushing them on the free list
+        Chunk* lastChunk = LinkChunks(ptr, chunkCount);
+
+        if constexpr (HasBlockLocalFreeLists)
+        {
+            const Size           blockIndex = FindBlock(std::bit_cast<UIntPtr>(ptr));
+            Internal::PoolBlock& block      = m_Blocks[blockIndex];
+
+            lastChunk->nextChunk = std::bit_cast<Chunk*>(block.freeList);
+            block.freeList       = ptr;
+            block.freeCount += chunkCount;
+
+            UpdateBin(blockIndex);
+        }
+        else
+        {
+            lastChunk->nextChunk = std::bit_cast<Chunk*>(m_CurrentPtr);
+            m_CurrentPtr         = ptr;
+        }
+
+        if constexpr (IsAddressOrdered)
+        {
+            m_FreeListIsSorted = false;
+        }
     }
 
-    void AllocateBlock()
+    // Returns false if the base allocator is out of memory
+    bool AllocateBlock(const Size chunkCount)
     {
         // The first chunk of the new block
-        void* newBlockPtr = m_BaseAllocator->AllocateBase(m_BlockSize);
+        void* newBlockPtr = m_BaseAllocator.AllocateBase(chunkCount * m_ObjectSize);
+        RETURN_VAL_IF_NULLPTR(newBlockPtr, false);
+        MEMARENA_PROBE(block_grow, this, newBlockPtr, chunkCount * m_ObjectSize);
+
+        AddBlock(newBlockPtr, chunkCount);
+        return true;
+    }
+
+    void AddBlock(void* newBlockPtr, const Size chunkCount)
+    {
+        // Once the block is allocated, we need to chain all the chunks in this block
+        Chunk* lastChunk = LinkChunks(newBlockPtr, chunkCount);
+
+        m_BlockPtrs.push_back(newBlockPtr);
+        m_BlockChunkCounts.push_back(chunkCount);
+
+        if constexpr (HasBlockLocalFreeLists)
+        {
+            lastChunk->nextChunk = nullptr;
+
+            m_Blocks.push_back({.freeList = newBlockPtr, .freeCount = chunkCount});
+            UpdateBin(m_Blocks.size() - 1);
+            UpdateBlockLookup();
+        }
+        else
+        {
+            // The chunks of the new block go in front of the chunks that are still free in the other blocks
+            lastChunk->nextChunk = std::bit_cast<Chunk*>(m_CurrentPtr);
+            m_CurrentPtr         = newBlockPtr;
+
+            if constexpr (IsAddressOrdered)
+            {
+                m_FreeListIsSorted = lastChunk->nextChunk == nullptr;
+            }
+        }
+
+        UpdateTotalSize();
+    }
 
-        // Once the block is allocated, we need to chain all the chunks in this block:
-        Chunk* currentChunk = std::bit_cast<Chunk*>(newBlockPtr);
+    // Chains `chunkCount` consecutive chunks starting at `ptr` and returns the last one
+    Chunk* LinkChunks(void* ptr, const Size chunkCount)
+    {
+        Chunk* currentChunk = std::bit_cast<Chunk*>(ptr);
 
-        for (int i = 0; i < m_ObjectsPerBlock - 1; ++i)
+        for (Size i = 0; i < chunkCount - 1; ++i)
         {
             currentChunk->nextChunk = std::bit_cast<Chunk*>(std::bit_cast<UIntPtr>(currentChunk) + m_ObjectSize);
             currentChunk            = currentChunk->nextChunk;
         }
 
-        currentChunk->nextChunk = nullptr;
+        return currentChunk;
+    }
 
-        m_BlockPtrs.push_back(newBlockPtr);
+    // Bucket (single digit radix) sort of the free chunks: every free chunk sets a bit for its index inside its block, then the
+    // list is rebuilt by walking the blocks in address order and the set bits in index order
+    void SortFreeListInternal()
+    {
+        if constexpr (HasBlockLocalFreeLists)
+        {
+            std::vector<UInt64> freeChunkBits;
 
-        if constexpr (UsageTrackingIsEnabled)
+            for (Size blockIndex = 0; blockIndex < m_Blocks.size(); ++blockIndex)
+            {
+                const UIntPtr blockAddress  = std::bit_cast<UIntPtr>(m_BlockPtrs[blockIndex]);
+                const Size    wordsPerBlock = GetWordCount(m_BlockChunkCounts[blockIndex]);
+                void*&        freeList      = m_Blocks[blockIndex].freeList;
+
+                freeChunkBits.assign(wordsPerBlock, 0);
+                MarkFreeChunks(freeList, freeChunkBits.data(), [&](UIntPtr /*chunkAddress*/) { return std::pair{blockAddress, Size(0)}; });
+
+                Chunk*  firstChunk = nullptr;
+                Chunk** lastLink   = AppendMarkedChunks(freeChunkBits.data(), wordsPerBlock, blockAddress, &firstChunk);
+                *lastLink          = nullptr;
+                freeList           = firstChunk;
+            }
+        }
+        else
         {
-            SetUsedSize((m_BlockPtrs.size() - 1) * m_BlockSize);
+            // The blocks in address order and the offset of the words of each of them in `freeChunkBits`
+            std::vector<Size> blockOrder(m_BlockPtrs.size());
+            std::iota(blockOrder.begin(), blockOrder.end(), 0);
+            std::ranges::sort(blockOrder, {}, [&](const Size blockIndex) { return std::bit_cast<UIntPtr>(m_BlockPtrs[blockIndex]); });
+
+            std::vector<UIntPtr> blockAddresses(blockOrder.size());
+            std::vector<Size>    wordOffsets(blockOrder.size() + 1, 0);
+
+            for (Size i = 0; i < blockOrder.size(); ++i)
+            {
+                blockAddresses[i]  = std::bit_cast<UIntPtr>(m_BlockPtrs[blockOrder[i]]);
+                wordOffsets[i + 1] = wordOffsets[i] + GetWordCount(m_BlockChunkCounts[blockOrder[i]]);
+            }
+
+            std::vector<UInt64> freeChunkBits(wordOffsets.back(), 0);
+
+            MarkFreeChunks(m_CurrentPtr, freeChunkBits.data(), [&](const UIntPtr chunkAddress) {
+                const Size i = std::ranges::upper_bound(blockAddresses, chunkAddress) - blockAddresses.begin() - 1;
+                return std::pair{blockAddresses[i], wordOffsets[i]};
+            });
+
+            Chunk*  firstChunk = nullptr;
+            Chunk** lastLink   = &firstChunk;
+
+            for (Size i = 0; i < blockAddresses.size(); ++i)
+            {
+                lastLink = AppendMarkedChunks(freeChunkBits.data() + wordOffsets[i], wordOffsets[i + 1] - wordOffsets[i], blockAddresses[i],
+                                              lastLink);
+            }
+
+            *lastLink    = nullptr;
+            m_CurrentPtr = firstChunk;
         }
 
-        UpdateTotalSize();
+        if constexpr (IsAddressOrdered)
+        {
+            m_FreeListIsSorted = true;
+        }
+    }
 
-        m_CurrentPtr = newBlockPtr;
+    // Sets the bit of every chunk in `freeList`. `getBlock` maps a chunk address to its block address and the word offset of the
+    // block in `freeChunkBits`
+    template <typename BlockGetter>
+    void MarkFreeChunks(void* freeList, UInt64* freeChunkBits, BlockGetter getBlock)
+    {
+        for (Chunk* chunk = std::bit_cast<Chunk*>(freeList); chunk != nullptr; chunk = chunk->nextChunk)
+        {
+            const UIntPtr chunkAddress            = std::bit_cast<UIntPtr>(chunk);
+            const auto [blockAddress, wordOffset] = getBlock(chunkAddress);
+
+            const Size chunkIndex = (chunkAddress - blockAddress) / m_ObjectSize;
+            freeChunkBits[wordOffset + chunkIndex / BitsPerWord] |= UInt64(1) << (chunkIndex % BitsPerWord);
+        }
     }
 
-    inline void DeallocateBlocks()
+    // Links the chunks whose bits are set after `nextLink` in address order and returns the link of the last one
+    Chunk** AppendMarkedChunks(const UInt64* freeChunkBits, const Size wordCount, const UIntPtr blockAddress, Chunk** nextLink)
     {
-        if constexpr (IsGrowable)
+        for (Size wordIndex = 0; wordIndex < wordCount; ++wordIndex)
         {
-            while (m_BlockPtrs.size() > 1)
+            UInt64 word = freeChunkBits[wordIndex];
+
+            while (word != 0)
             {
+                const Size chunkIndex = wordIndex * BitsPerWord + std::countr_zero(word);
+                Chunk*     chunk      = std::bit_cast<Chunk*>(blockAddress + chunkIndex * m_ObjectSize);
+
+                *nextLink = chunk;
+                nextLink  = &chunk->nextChunk;
+                word &= word - 1;
+            }
+        }
+
+        return nextLink;
+    }
+
+    // Block-local free lists: every block keeps its own free list and blocks that still have free chunks are kept in bins by
+    // occupancy. Allocation always takes a chunk from a block in the fullest non-empty bin, so live objects concentrate in few
+    // blocks and the others drain until they can be released
+
+    [[nodiscard]] Size GetBin(const Size blockIndex) const
+    {
+        const Internal::PoolBlock& block = m_Blocks[blockIndex];
+
+        if (block.freeCount == 0)
+        {
+            return NoBin;
+        }
+
+        const Size chunkCount = m_BlockChunkCounts[blockIndex];
+        const Size usedCount  = chunkCount - block.freeCount;
+        return usedCount * BinCount / chunkCount;
+    }
+
+    [[nodiscard]] Size GetFullestBlock() const
+    {
+        if (m_NonEmptyBins == 0)
+        {
+            return NoBlock;
+        }
+
+        const Size fullestBin = std::bit_width(m_NonEmptyBins) - 1;
+        return m_BinHeads[fullestBin];
+    }
+
+    // Moves the block to the bin matching its occupancy. Full blocks are not in any bin
+    void UpdateBin(const Size blockIndex)
+    {
+        const Size newBin = GetBin(blockIndex);
+
+        if (newBin == m_Blocks[blockIndex].bin)
+        {
+            return;
+        }
+
+        RemoveFromBin(blockIndex);
+
+        if (newBin == NoBin)
+        {
+            return;
+        }
+
+        Internal::PoolBlock& block = m_Blocks[blockIndex];
+        block.bin                  = newBin;
+        block.previousInBin        = NoBlock;
+        block.nextInBin            = m_BinHeads[newBin];
+
+        if (block.nextInBin != NoBlock)
+        {
+            m_Blocks[block.nextInBin].previousInBin = blockIndex;
+        }
+
+        m_BinHeads[newBin] = blockIndex;
+        m_NonEmptyBins |= UInt32(1) << newBin;
+    }
+
+    void RemoveFromBin(const Size blockIndex)
+    {
+        Internal::PoolBlock& block = m_Blocks[blockIndex];
+
+        if (block.bin == NoBin)
+        {
+            return;
+        }
+
+        if (block.previousInBin != NoBlock)
+        {
+            m_Blocks[block.previousInBin].nextInBin = block.nextInBin;
+        }
+        else
+        {
+            m_BinHeads[block.bin] = block.nextInBin;
+        }
+
+        if (block.nextInBin != NoBlock)
+        {
+            m_Blocks[block.nextInBin].previousInBin = block.previousInBin;
+        }
+
+        if (m_BinHeads[block.bin] == NoBlock)
+        {
+            m_NonEmptyBins &= ~(UInt32(1) << block.bin);
+        }
+
+        block.bin           = NoBin;
+        block.previousInBin = NoBlock;
+        block.nextInBin     = NoBlock;
+    }
+
+    [[nodiscard]] Size FindBlock(const UIntPtr address) const
+    {
+        const auto it = std::ranges::upper_bound(m_BlockLookup, address, {},
+                                                 [&](const Size blockIndex) { return std::bit_cast<UIntPtr>(m_BlockPtrs[blockIndex]); });
+        return *(it - 1);
+    }
+
+    void UpdateBlockLookup()
+    {
+        m_BlockLookup.resize(m_BlockPtrs.size());
+        std::iota(m_BlockLookup.begin(), m_BlockLookup.end(), 0);
+        std::ranges::sort(m_BlockLookup, {}, [&](const Size blockIndex) { return std::bit_cast<UIntPtr>(m_BlockPtrs[blockIndex]); });
+    }
+
+    // Without a base allocator that frees in any order, only the trailing empty blocks are freed, from the last one, so that a
+    // StackAllocator can be the base allocator
+    void ReleaseEmptyBlocksInternal()
+    {
+        if constexpr (BlocksAreFreedInAnyOrder)
+        {
+            for (Size blockIndex = m_Blocks.size(); blockIndex-- > 0 && m_Blocks.size() > 1;)
+            {
+                if (m_Blocks[blockIndex].freeCount == m_BlockChunkCounts[blockIndex])
+                {
+                    FreeBlock(blockIndex);
+                }
+            }
+        }
+        else
+        {
+            while (m_Blocks.size() > 1 && m_Blocks.back().freeCount == m_BlockChunkCounts.back())
+            {
+                RemoveFromBin(m_Blocks.size() - 1);
                 FreeLastBlock();
+                m_Blocks.pop_back();
             }
+        }
+
+        UpdateBlockLookup();
+        UpdateTotalSize();
+    }
+
+    // Frees the block and moves the last block in its place
+    void FreeBlock(const Size blockIndex) requires BlocksAreFreedInAnyOrder
+    {
+        RemoveFromBin(blockIndex);
+
+        m_BaseAllocator.DeallocateBase(m_BlockPtrs[blockIndex], m_BlockChunkCounts[blockIndex] * m_ObjectSize);
+
+        const Size lastIndex = m_Blocks.size() - 1;
+
+        if (blockIndex != lastIndex)
+        {
+            const Size lastBin = m_Blocks[lastIndex].bin;
+            RemoveFromBin(lastIndex);
+
+            m_BlockPtrs[blockIndex]        = m_BlockPtrs[lastIndex];
+            m_BlockChunkCounts[blockIndex] = m_BlockChunkCounts[lastIndex];
+            m_Blocks[blockIndex]           = m_Blocks[lastIndex];
+
+            if (lastBin != NoBin)
+            {
+                UpdateBin(blockIndex);
+            }
+        }
+
+        m_BlockPtrs.pop_back();
+        m_BlockChunkCounts.pop_back();
+        m_Blocks.pop_back();
+    }
+
+    // Frees all but the first block, which is replaced if the block size policy asks for a different size, and makes every chunk free
+    void ReleaseInternal()
+    {
+        while (m_BlockPtrs.size() > 1)
+        {
+            FreeLastBlock();
+        }
+
+        // The pool has no block if the base allocator was out of memory, so it tries to get one again
+        void* blockPtr   = m_BlockPtrs.empty() ? nullptr : m_BlockPtrs[0];
+        Size  chunkCount = m_BlockPtrs.empty() ? 0 : m_BlockChunkCounts[0];
+
+        const Size releaseChunkCount = m_BlockSizePolicy.GetReleaseBlockSize();
+        if (blockPtr == nullptr || BlockSizePolicy::ShouldReplaceBlock(chunkCount, releaseChunkCount))
+        {
+            if (blockPtr != nullptr)
+            {
+                m_BaseAllocator.DeallocateBase(blockPtr, chunkCount * m_ObjectSize);
+            }
+            chunkCount = releaseChunkCount;
+            blockPtr   = m_BaseAllocator.AllocateBase(chunkCount * m_ObjectSize);
+
+            if (blockPtr != nullptr)
+            {
+                MEMARENA_PROBE(block_grow, this, blockPtr, chunkCount * m_ObjectSize);
+            }
+        }
+
+        m_BlockPtrs.clear();
+        m_BlockChunkCounts.clear();
+        m_CurrentPtr = nullptr;
+
+        if constexpr (HasBlockLocalFreeLists)
+        {
+            m_Blocks.clear();
+            m_BinHeads.fill(NoBlock);
+            m_NonEmptyBins = 0;
+        }
+
+        if (blockPtr != nullptr)
+        {
+            AddBlock(blockPtr, chunkCount);
+        }
+        else
+        {
             UpdateTotalSize();
         }
 
-        m_CurrentPtr = m_BlockPtrs[0];
+        if constexpr (UsageTrackingIsEnabled)
+        {
+            SetUsedSize(0);
+        }
     }
 
     inline bool CheckPtr(void* ptr)
@@ -432,20 +1023,25 @@ class PoolAllocator : public Allocator
         return true;
     }
 
+    [[nodiscard]] Size GetChunkCount(const Size size) const { return std::max<Size>((size + m_ObjectSize - 1) / m_ObjectSize, 1); }
+
     inline void FreeLastBlock()
     {
-        m_BaseAllocator->DeallocateBase(m_BlockPtrs.back());
+        m_BaseAllocator.DeallocateBase(m_BlockPtrs.back(), m_BlockChunkCounts.back() * m_ObjectSize);
         m_BlockPtrs.pop_back();
+        m_BlockChunkCounts.pop_back();
     }
 
     inline void UpdateTotalSize()
     {
         if constexpr (UsageTrackingIsEnabled)
         {
-            SetTotalSize(m_BlockPtrs.size() * m_BlockSize);
+            SetTotalSize(std::reduce(m_BlockChunkCounts.begin(), m_BlockChunkCounts.end(), Size(0)) * m_ObjectSize);
         }
     }
 
+    [[nodiscard]] static Size GetWordCount(const Size chunkCount) { return (chunkCount + BitsPerWord - 1) / BitsPerWord; }
+
     template <typename T>
     inline void CheckDoubleFree(T*& ptr)
     {
@@ -473,16 +1069,25 @@ class PoolAllocator : public Allocator
         }
     }
 
-    std::shared_ptr<Allocator> m_BaseAllocator;
-    std::vector<void*>         m_BlockPtrs;
+    NO_UNIQUE_ADDRESS BaseAllocator m_BaseAllocator;
+    std::vector<void*>              m_BlockPtrs;
+    std::vector<Size>               m_BlockChunkCounts;
 
     ThreadPolicy m_MultithreadedPolicy;
 
     void* m_CurrentPtr = nullptr;
 
-    Size m_ObjectsPerBlock;
-    Size m_ObjectSize;
-    Size m_BlockSize;
+    bool m_FreeListIsSorted = true;
+
+    std::vector<Internal::PoolBlock> m_Blocks;
+    std::vector<Size>                m_BlockLookup; // Block indices sorted by block address
+    std::array<Size, BinCount>       m_BinHeads{};
+    UInt32                           m_NonEmptyBins = 0;
+
+    Size            m_ObjectSize;
+    BlockSizePolicy m_BlockSizePolicy;
+
+    NO_UNIQUE_ADDRESS ThreadTrackingPolicy m_ThreadTrackingPolicy;
 };
 
 // template <PoolAllocatorPolicy policy>
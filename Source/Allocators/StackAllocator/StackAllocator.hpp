@@ -7,11 +7,14 @@
 #include "Source/AllocatorData.hpp"
 #include "Source/AllocatorSettings.hpp"
 #include "Source/AllocatorUtils.hpp"
+#include "Source/Allocators/Mallocator/Mallocator.hpp"
 #include "Source/Assert.hpp"
 #include "Source/Macros.hpp"
 #include "Source/Policies/BoundsCheckPolicy.hpp"
 #include "Source/Policies/MultithreadedPolicy.hpp"
 #include "Source/Policies/Policies.hpp"
+#include "Source/Policies/ThreadTrackingPolicy.hpp"
+#include "Source/Probes.hpp"
 #include "Source/Traits.hpp"
 #include "Source/Utility/Alignment/Alignment.hpp"
 
@@ -23,62 +26,66 @@ constexpr StackAllocatorSettings stackAllocatorDefaultSettings{};
 namespace Internal
 {
 
+// The headers are as wide as the offsets of the allocator, so a stack with compact offsets has 2 and 4 byte headers
+template <typename OffsetType = Offset>
 struct StackHeaderLite
 {
-    Offset startOffset;
+    OffsetType startOffset;
 
-    StackHeaderLite(Offset _startOffset, Offset /*_endOffset*/) : startOffset(_startOffset) {}
+    StackHeaderLite(OffsetType _startOffset, OffsetType /*_endOffset*/) : startOffset(_startOffset) {}
 };
 
+template <typename OffsetType = Offset>
 struct StackHeader
 {
-    Offset startOffset;
-    Offset endOffset;
+    OffsetType startOffset;
+    OffsetType endOffset;
 
-    StackHeader(Offset _startOffset, Offset _endOffset) : startOffset(_startOffset), endOffset(_endOffset) {}
+    StackHeader(OffsetType _startOffset, OffsetType _endOffset) : startOffset(_startOffset), endOffset(_endOffset) {}
 };
 
+template <typename OffsetType = Offset>
 struct StackArrayHeader
 {
-    Offset startOffset;
-    Offset count;
+    OffsetType startOffset;
+    OffsetType count;
 
-    StackArrayHeader(Offset _startOffset, Offset _count) : startOffset(_startOffset), count(_count) {}
+    StackArrayHeader(OffsetType _startOffset, OffsetType _count) : startOffset(_startOffset), count(_count) {}
 };
 } // namespace Internal
 
-template <typename T>
+template <typename T, typename OffsetType = Offset>
 class StackPtr : public Ptr<T>
 {
     // Allow only StackAllocator to create a StackPtr by making constructors private
-    template <StackAllocatorSettings Settings>
+    template <StackAllocatorSettings Settings, BaseAllocatorType BaseAllocator>
     friend class StackAllocator;
 
   public:
-    [[nodiscard]] inline const Internal::StackHeader& GetHeader() const { return m_Header; }
+    [[nodiscard]] inline const Internal::StackHeader<OffsetType>& GetHeader() const { return m_Header; }
 
   private:
-    inline StackPtr(T* ptr, const Internal::StackHeader& header) : Ptr<T>(ptr), m_Header(header) {}
-    inline StackPtr(T* ptr, Offset startOffset, Offset endOffset) : Ptr<T>(ptr), m_Header(startOffset, endOffset) {}
-    Internal::StackHeader m_Header;
+    inline StackPtr(T* ptr, const Internal::StackHeader<OffsetType>& header) : Ptr<T>(ptr), m_Header(header) {}
+    inline StackPtr(T* ptr, OffsetType startOffset, OffsetType endOffset) : Ptr<T>(ptr), m_Header(startOffset, endOffset) {}
+    Internal::StackHeader<OffsetType> m_Header;
 };
 
-template <typename T>
+template <typename T, typename OffsetType = Offset>
 class StackArrayPtr : public ArrayPtr<T>
 {
     // Allow only StackAllocator to create a StackArrayPtr by making constructors private
-    template <StackAllocatorSettings Settings>
+    template <StackAllocatorSettings Settings, BaseAllocatorType BaseAllocator>
     friend class StackAllocator;
 
   public:
-    [[nodiscard]] inline Size                              GetCount() const { return m_Header.count; }
-    [[nodiscard]] inline const Internal::StackArrayHeader& GetHeader() const { return m_Header; }
+    [[nodiscard]] inline Size                                          GetCount() const { return m_Header.count; }
+    [[nodiscard]] inline const Internal::StackArrayHeader<OffsetType>& GetHeader() const { return m_Header; }
 
   private:
-    StackArrayPtr(T* ptr, const Internal::StackArrayHeader& header) : ArrayPtr<T>(ptr, header.count), m_Header(header) {}
-    StackArrayPtr(T* ptr, Offset startOffset, Offset count) : ArrayPtr<T>(ptr, count), m_Header(startOffset, count) {}
+    StackArrayPtr(T* ptr, const Internal::StackArrayHeader<OffsetType>& header) : ArrayPtr<T>(ptr, header.count), m_Header(header) {}
+    StackArrayPtr(T* ptr, OffsetType startOffset, OffsetType count) : ArrayPtr<T>(ptr, count), m_Header(startOffset, count) {}
 
-    Internal::StackArrayHeader m_Header;
+    Internal::StackArrayHeader<OffsetType> m_Header;
 };
 
 /**
@@ -95,9 +102,16 @@ class StackArrayPtr : public ArrayPtr<T>
  * Space complexity is O(N*H) --> O(N) where H is the Header size and N is the number of allocations
  * Allocation and deallocation complexity: O(1)
  *
+ * With `StackAllocatorPolicy::BumpDown` the stack grows from the end of the memory towards the start, which is cheapest for the
+ * headerless `New` and `NewArray`. Headers of raw allocations are placed below the allocation.
+ *
+ * Offsets, and with them the headers, are 32-bit by default. `StackAllocatorPolicy::CompactOffsets` makes them 16-bit for stacks
+ * smaller than 64 KiB and `StackAllocatorPolicy::WideOffsets` makes them 64-bit for stacks larger than 4 GiB.
+ *
  * @tparam policy The `StackAllocatorPolicy`mjn object to define the behaviour of this allocator
+ * @tparam BaseAllocator Where the memory of the stack comes from
  */
-template <StackAllocatorSettings Settings = stackAllocatorDefaultSettings>
+template <StackAllocatorSettings Settings = stackAllocatorDefaultSettings, BaseAllocatorType BaseAllocator = MallocBase>
 class StackAllocator : public Allocator
 {
   private:
@@ -112,13 +126,31 @@ class StackAllocator : public Allocator
     static constexpr bool AllocationTrackingIsEnabled   = PolicyContains(Policy, StackAllocatorPolicy::AllocationTracking);
     static constexpr bool IsResizable                   = PolicyContains(Policy, StackAllocatorPolicy::Resizable);
     static constexpr bool DoubleFreePreventionIsEnabled = PolicyContains(Policy, StackAllocatorPolicy::DoubleFreePrevention);
+    static constexpr bool IsBumpDown                    = PolicyContains(Policy, StackAllocatorPolicy::BumpDown);
+    static constexpr bool HasCompactOffsets             = PolicyContains(Policy, StackAllocatorPolicy::CompactOffsets);
+    static constexpr bool HasWideOffsets                = PolicyContains(Policy, StackAllocatorPolicy::WideOffsets);
+    static constexpr bool HeapProfilingIsEnabled        = PolicyContains(Policy, StackAllocatorPolicy::HeapProfiling);
+    static constexpr bool ThreadTrackingIsEnabled       = PolicyContains(Policy, StackAllocatorPolicy::ThreadTracking);
+
+    static_assert(!IsBumpDown || !BoundsCheckIsEnabled, "The bump down policy can't be combined with the bounds check policy");
+    static_assert(!HasCompactOffsets || !HasWideOffsets, "The compact and wide offsets policies can't be combined");
+
+  public:
+    using OffsetType = std::conditional_t<HasCompactOffsets, UInt16, std::conditional_t<HasWideOffsets, UInt64, Offset>>;
+
+    template <typename T>
+    using PtrType = StackPtr<T, OffsetType>;
+    template <typename T>
+    using ArrayPtrType = StackArrayPtr<T, OffsetType>;
 
-    using InplaceHeader      = typename std::conditional<StackCheckIsEnabled, Internal::StackHeader, Internal::StackHeaderLite>::type;
-    using Header             = Internal::StackHeader;
-    using InplaceArrayHeader = Internal::StackArrayHeader;
-    using ArrayHeader        = Internal::StackArrayHeader;
+  private:
+    using Header             = Internal::StackHeader<OffsetType>;
+    using InplaceHeader      = std::conditional_t<StackCheckIsEnabled, Header, Internal::StackHeaderLite<OffsetType>>;
+    using InplaceArrayHeader = Internal::StackArrayHeader<OffsetType>;
+    using ArrayHeader        = Internal::StackArrayHeader<OffsetType>;
 
-    using ThreadPolicy = MultithreadedPolicy<IsMultithreaded>;
+    using ThreadPolicy         = MultithreadedPolicy<IsMultithreaded>;
+    using ThreadTrackingPolicy = Memarena::ThreadTrackingPolicy<ThreadTrackingIsEnabled>;
 
     template <typename SyncPrimitive>
     using LockGuard = typename ThreadPolicy::template LockGuard<SyncPrimitive>;
@@ -136,25 +168,46 @@ class StackAllocator : public Allocator
     StackAllocator& operator=(StackAllocator&&) = delete;
 
     explicit StackAllocator(const Size totalSize, const std::string& debugName = "StackAllocator",
-                            std::shared_ptr<Allocator> baseAllocator = Allocator::GetDefaultAllocator())
-        : Allocator(totalSize, debugName), m_StartPtr(baseAllocator->AllocateBase(totalSize)),
-          m_StartAddress(std::bit_cast<UIntPtr>(m_StartPtr)), m_EndAddress(m_StartAddress + totalSize),
-          m_BaseAllocator(std::move(baseAllocator))
+                            BaseAllocator baseAllocator = BaseAllocator())
+        : Allocator(totalSize, debugName, false, std::numeric_limits<OffsetType>::max()),
+          m_StartPtr(baseAllocator.AllocateBase(totalSize)), m_StartAddress(std::bit_cast<UIntPtr>(m_StartPtr)),
+          m_EndAddress(m_StartAddress + totalSize), m_BaseAllocator(std::move(baseAllocator))
     {
+        RecordBaseAllocator(GetTrackedAllocator(m_BaseAllocator));
+
+        // Without memory from the base allocator the stack has no room, so every allocation fails
+        if (m_StartPtr == nullptr)
+        {
+            m_EndAddress = m_StartAddress;
+            SetTotalSize(0);
+        }
     }
 
-    ~StackAllocator() { m_BaseAllocator->DeallocateBase(m_StartPtr); };
+    ~StackAllocator()
+    {
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            ReleaseSamples();
+        }
+
+        m_ThreadTrackingPolicy.RecordRelease();
+
+        if (m_StartPtr != nullptr)
+        {
+            m_BaseAllocator.DeallocateBase(m_StartPtr, GetTotalSize());
+        }
+    };
 
     friend bool operator==(const StackAllocator& s1, const StackAllocator& s2) { return s1.m_StartAddress == s2.m_StartAddress; }
 
     template <Allocatable Object, typename... Args>
-    NO_DISCARD StackPtr<Object> New(Args&&... argList)
+    NO_DISCARD PtrType<Object> New(Args&&... argList)
     {
         auto [voidPtr, startOffset, endOffset] = AllocateInternal(sizeof(Object), alignof(Object));
-        RETURN_VAL_IF_NULLPTR(voidPtr, StackPtr<Object>(nullptr, 0, 0));
+        RETURN_VAL_IF_NULLPTR(voidPtr, PtrType<Object>(nullptr, 0, 0));
         Object* ptr = static_cast<Object*>(voidPtr);
         ptr         = std::construct_at(ptr, std::forward<Args>(argList)...);
-        return StackPtr<Object>(ptr, startOffset, endOffset);
+        return PtrType<Object>(ptr, startOffset, endOffset);
     }
 
     template <Allocatable Object, typename... Args>
@@ -167,12 +220,12 @@ class StackAllocator : public Allocator
     }
 
     template <Allocatable Object, typename... Args>
-    NO_DISCARD StackArrayPtr<Object> NewArray(const Size objectCount, Args&&... argList)
+    NO_DISCARD ArrayPtrType<Object> NewArray(const Size objectCount, Args&&... argList)
     {
         auto [voidPtr, startOffset, endOffset] = AllocateInternal(objectCount * sizeof(Object), alignof(Object));
-        RETURN_VAL_IF_NULLPTR(voidPtr, StackArrayPtr<Object>(nullptr, 0, 0));
+        RETURN_VAL_IF_NULLPTR(voidPtr, ArrayPtrType<Object>(nullptr, 0, 0));
         Object* ptr = Internal::ConstructArray<Object>(voidPtr, objectCount, std::forward<Args>(argList)...);
-        return StackArrayPtr<Object>(ptr, startOffset, objectCount);
+        return ArrayPtrType<Object>(ptr, startOffset, objectCount);
     }
 
     template <Allocatable Object, typename... Args>
@@ -184,7 +237,7 @@ class StackAllocator : public Allocator
     }
 
     template <Allocatable Object>
-    void Delete(StackPtr<Object>& ptr)
+    void Delete(PtrType<Object>& ptr)
     {
         DeallocateInternal(ptr);
         ptr->~Object();
@@ -205,7 +258,7 @@ class StackAllocator : public Allocator
     }
 
     template <Allocatable Object>
-    void DeleteArray(StackArrayPtr<Object>& ptr)
+    void DeleteArray(ArrayPtrType<Object>& ptr)
     {
         const Size objectCount = DeallocateArrayInternal(ptr, sizeof(Object));
         std::destroy_n(ptr.GetPtr(), objectCount);
@@ -246,11 +299,23 @@ class StackAllocator : public Allocator
 
     void Deallocate(void*& ptr) { DeallocateInternal(ptr); }
 
-    void Deallocate(StackPtr<void>& ptr) { DeallocateInternal(ptr); }
+    void Deallocate(PtrType<void>& ptr) { DeallocateInternal(ptr); }
 
     Size DeallocateArray(void*& ptr, const Size objectSize) { return DeallocateArrayInternal(ptr, objectSize); }
 
-    Size DeallocateArray(StackArrayPtr<void>& ptr, const Size objectSize) { return DeallocateArrayInternal(ptr, objectSize); }
+    Size DeallocateArray(ArrayPtrType<void>& ptr, const Size objectSize) { return DeallocateArrayInternal(ptr, objectSize); }
+
+    /**
+     * @brief Lets child arenas allocate their blocks from this allocator. Children have to be destroyed in the reverse order of their
+     * creation, like any other allocation on the stack
+     */
+    NO_DISCARD void* AllocateBase(const Size size) final { return Allocate(size); }
+
+    void DeallocateBase(void* ptr, const Size /*size*/) final
+    {
+        void* voidPtr = ptr;
+        Deallocate(voidPtr);
+    }
 
     /**
      * @brief Releases the allocator to its initial state. Any further allocations
@@ -262,7 +327,14 @@ class StackAllocator : public Allocator
     inline void Release()
     {
         LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        MEMARENA_PROBE(release, this);
         SetCurrentOffset(0);
+        m_ThreadTrackingPolicy.RecordRelease();
+
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            ReleaseSamples();
+        }
     };
 
     [[nodiscard]] bool Owns(UIntPtr address) const { return address >= m_StartAddress && address <= m_EndAddress; }
@@ -284,7 +356,7 @@ class StackAllocator : public Allocator
     }
 
     template <typename T>
-    void DeallocateInternal(StackPtr<T>& ptr)
+    void DeallocateInternal(PtrType<T>& ptr)
     {
         const void*   voidPtr        = ptr.GetPtr();
         const UIntPtr currentAddress = GetAddressFromPtr(voidPtr);
@@ -298,53 +370,65 @@ class StackAllocator : public Allocator
         const UIntPtr currentAddress = GetAddressFromPtr(ptr);
         auto [header, headerAddress] = Internal::GetHeaderFromAddress<InplaceArrayHeader>(currentAddress);
         DeallocateInternal(currentAddress, headerAddress,
-                           Header(header.startOffset,
-                                  Internal::GetArrayEndOffset(currentAddress, m_StartAddress, header.count, objectSize, BackGuardSize)));
+                           Header(header.startOffset, GetArrayEndOffset(currentAddress, headerAddress, header.count, objectSize)));
         CheckDoubleFree(ptr);
         return header.count;
     }
 
     template <typename T>
-    Size DeallocateArrayInternal(StackArrayPtr<T>& ptr, const Size objectSize)
+    Size DeallocateArrayInternal(ArrayPtrType<T>& ptr, const Size objectSize)
     {
         const void*   voidPtr        = ptr.GetPtr();
         const UIntPtr currentAddress = GetAddressFromPtr(voidPtr);
 
-        const Internal::StackArrayHeader header = ptr.GetHeader();
+        const ArrayHeader header = ptr.GetHeader();
         DeallocateInternal(currentAddress, currentAddress,
-                           Header(header.startOffset,
-                                  Internal::GetArrayEndOffset(currentAddress, m_StartAddress, header.count, objectSize, BackGuardSize)));
+                           Header(header.startOffset, GetArrayEndOffset(currentAddress, currentAddress, header.count, objectSize)));
         CheckDoubleFree(ptr);
         return header.count;
     }
 
     template <Size HeaderSize = 0>
-    std::tuple<void*, Offset, Offset> AllocateInternal(const Size size, const Alignment& alignment, const std::string& category = "",
-                                                       const SourceLocation& sourceLocation = SourceLocation::current())
+    std::tuple<void*, OffsetType, OffsetType> AllocateInternal(const Size size, const Alignment& alignment,
+                                                               const std::string&    category       = "",
+                                                               const SourceLocation& sourceLocation = SourceLocation::current())
     {
         LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
 
-        const Offset  startOffset = m_CurrentOffset;
-        const UIntPtr baseAddress = m_StartAddress + m_CurrentOffset;
+        const OffsetType startOffset = m_CurrentOffset;
 
-        Padding padding{0};
         UIntPtr alignedAddress{0};
+        Size    totalSizeAfterAllocation{0};
 
         constexpr Size totalHeaderSize = GetTotalHeaderSize<HeaderSize>();
 
-        if constexpr (totalHeaderSize > 0)
+        if constexpr (IsBumpDown)
         {
-            padding        = CalculateAlignedPaddingWithHeader(baseAddress, alignment, totalHeaderSize);
-            alignedAddress = baseAddress + padding;
+            // Only the start of the allocation has to be aligned, the header goes below it
+            const UIntPtr topAddress = m_EndAddress - m_CurrentOffset;
+            alignedAddress           = CalculateAlignedDownAddress(topAddress - size, alignment);
+            totalSizeAfterAllocation = m_CurrentOffset + (topAddress - alignedAddress) + totalHeaderSize;
         }
         else
         {
-            alignedAddress = CalculateAlignedAddress(baseAddress, alignment);
-            padding        = alignedAddress - baseAddress;
+            const UIntPtr baseAddress = m_StartAddress + m_CurrentOffset;
+
+            Padding padding{0};
+
+            if constexpr (totalHeaderSize > 0)
+            {
+                padding        = CalculateAlignedPaddingWithHeader(baseAddress, alignment, totalHeaderSize);
+                alignedAddress = baseAddress + padding;
+            }
+            else
+            {
+                alignedAddress = CalculateAlignedAddress(baseAddress, alignment);
+                padding        = alignedAddress - baseAddress;
+            }
+
+            totalSizeAfterAllocation = m_CurrentOffset + padding + size;
         }
 
-        Size totalSizeAfterAllocation = m_CurrentOffset + padding + size;
-
         MEMARENA_ASSERT_RETURN(totalSizeAfterAllocation <= GetTotalSize(), (std::tuple(nullptr, 0, 0)),
                                "Error: The allocator '%s' is out of memory!\n", GetDebugName().c_str());
 
@@ -361,15 +445,25 @@ class StackAllocator : public Allocator
 
         SetCurrentOffset(totalSizeAfterAllocation);
 
-        const Offset endOffset = m_CurrentOffset;
+        const OffsetType endOffset = m_CurrentOffset;
 
         void* allocatedPtr = std::bit_cast<void*>(alignedAddress);
 
+        // Headers, guards and padding count too, they are freed with the allocation
+        m_ThreadTrackingPolicy.RecordAllocation(endOffset - startOffset);
+
         if constexpr (AllocationTrackingIsEnabled)
         {
             AddAllocation(size, category, sourceLocation);
         }
 
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            SampleAllocation(allocatedPtr, size);
+        }
+
+        MEMARENA_PROBE(allocate, this, allocatedPtr, size);
+
         return {allocatedPtr, startOffset, endOffset};
     }
 
@@ -378,7 +472,7 @@ class StackAllocator : public Allocator
     {
         LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
 
-        const Offset newOffset = header.startOffset;
+        const OffsetType newOffset = header.startOffset;
 
         if constexpr (StackCheckIsEnabled)
         {
@@ -394,7 +488,9 @@ class StackAllocator : public Allocator
             const UIntPtr         backGuardAddress = address + frontGuard->allocationSize;
             const BoundGuardBack* backGuard        = std::bit_cast<BoundGuardBack*>(backGuardAddress);
 
-            MEMARENA_ASSERT_RETURN(frontGuard->offset == newOffset && backGuard->offset == newOffset, void(),
+            // The guards keep 32-bit offsets, which is enough to tell them apart from the bytes of a neighbouring allocation
+            const Offset guardOffset = static_cast<Offset>(newOffset);
+            MEMARENA_ASSERT_RETURN(frontGuard->offset == guardOffset && backGuard->offset == guardOffset, void(),
                                    "Error: Memory stomping detected in allocator '%s' at offset %d and address %d!\n",
                                    GetDebugName().c_str(), newOffset, address);
         }
@@ -404,6 +500,15 @@ class StackAllocator : public Allocator
             AddDeallocation();
         }
 
+        if constexpr (HeapProfilingIsEnabled)
+        {
+            SampleDeallocation(std::bit_cast<void*>(address));
+        }
+
+        MEMARENA_PROBE(deallocate, this, address);
+
+        // Without the stack check an allocation below the top frees everything above it as well
+        m_ThreadTrackingPolicy.RecordDeallocation(m_CurrentOffset > newOffset ? m_CurrentOffset - newOffset : 0);
         SetCurrentOffset(newOffset);
     }
 
@@ -425,6 +530,19 @@ class StackAllocator : public Allocator
         return address;
     }
 
+    // `lowestAddress` is the address of the in-place header if there is one, otherwise it is the address of the array
+    OffsetType GetArrayEndOffset(const UIntPtr address, const UIntPtr lowestAddress, const Size objectCount, const Size objectSize) const
+    {
+        if constexpr (IsBumpDown)
+        {
+            return m_EndAddress - lowestAddress;
+        }
+        else
+        {
+            return (address - m_StartAddress) + objectCount * objectSize + BackGuardSize;
+        }
+    }
+
     template <Size headerSize>
     static consteval Size GetTotalHeaderSize()
     {
@@ -438,7 +556,7 @@ class StackAllocator : public Allocator
         }
     }
 
-    void SetCurrentOffset(const Offset offset)
+    void SetCurrentOffset(const OffsetType offset)
     {
         m_CurrentOffset = offset;
 
@@ -458,7 +576,7 @@ class StackAllocator : public Allocator
     }
 
     template <typename T>
-    inline void CheckDoubleFree(StackPtr<T>& ptr)
+    inline void CheckDoubleFree(PtrType<T>& ptr)
     {
         if constexpr (DoubleFreePreventionIsEnabled)
         {
@@ -467,7 +585,7 @@ class StackAllocator : public Allocator
     }
 
     template <typename T>
-    inline void CheckDoubleFree(StackArrayPtr<T>& ptr)
+    inline void CheckDoubleFree(ArrayPtrType<T>& ptr)
     {
         if constexpr (DoubleFreePreventionIsEnabled)
         {
@@ -483,9 +601,10 @@ class StackAllocator : public Allocator
     UIntPtr m_EndAddress;
     // -------------------
 
-    Offset m_CurrentOffset = 0;
+    OffsetType m_CurrentOffset = 0;
 
-    std::shared_ptr<Allocator> m_BaseAllocator;
+    NO_UNIQUE_ADDRESS ThreadTrackingPolicy m_ThreadTrackingPolicy;
+    NO_UNIQUE_ADDRESS BaseAllocator        m_BaseAllocator;
 };
 
 // template <StackAllocatorPolicy policy>
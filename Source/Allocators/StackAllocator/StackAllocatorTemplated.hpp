@@ -7,6 +7,11 @@ namespace Memarena
 template <Allocatable Object, auto Settings = StackAllocatorSettings()>
 class StackAllocatorTemplated
 {
+    template <typename T>
+    using StackPtrType = typename StackAllocator<Settings>::template PtrType<T>;
+    template <typename T>
+    using StackArrayPtrType = typename StackAllocator<Settings>::template ArrayPtrType<T>;
+
   public:
     StackAllocatorTemplated()                               = delete;
     StackAllocatorTemplated(StackAllocatorTemplated&)       = delete;
@@ -23,7 +28,7 @@ class StackAllocatorTemplated
     ~StackAllocatorTemplated() = default;
 
     template <typename... Args>
-    NO_DISCARD StackPtr<Object> New(Args&&... argList)
+    NO_DISCARD StackPtrType<Object> New(Args&&... argList)
     {
         return m_StackAllocator.template New<Object>(std::forward<Args>(argList)...);
     }
@@ -34,12 +39,12 @@ class StackAllocatorTemplated
         return m_StackAllocator.template NewRaw<Object>(std::forward<Args>(argList)...);
     }
 
-    void Delete(StackPtr<Object> ptr) { m_StackAllocator.Delete(ptr); }
+    void Delete(StackPtrType<Object> ptr) { m_StackAllocator.Delete(ptr); }
 
     void Delete(Object* ptr) { m_StackAllocator.Delete(ptr); }
 
     template <typename... Args>
-    NO_DISCARD StackArrayPtr<Object> NewArray(const Size objectCount, Args&&... argList)
+    NO_DISCARD StackArrayPtrType<Object> NewArray(const Size objectCount, Args&&... argList)
     {
         return m_StackAllocator.template NewArray<Object>(objectCount, std::forward<Args>(argList)...);
     }
@@ -52,7 +57,7 @@ class StackAllocatorTemplated
 
     void DeleteArray(Object* ptr) { m_StackAllocator.DeleteArray(ptr); }
 
-    void DeleteArray(StackArrayPtr<Object> ptr) { m_StackAllocator.DeleteArray(ptr); }
+    void DeleteArray(StackArrayPtrType<Object> ptr) { m_StackAllocator.DeleteArray(ptr); }
 
     NO_DISCARD void* Allocate(const Size size, const Alignment& alignment = defaultAlignment, const std::string& category = "",
                               const SourceLocation& sourceLocation = SourceLocation::current())
@@ -67,7 +72,7 @@ class StackAllocatorTemplated
 
     void Deallocate(void* ptr) { m_StackAllocator.Deallocate(ptr); }
 
-    void Deallocate(const StackPtr<void>& ptr) { m_StackAllocator.Deallocate(ptr); }
+    void Deallocate(const StackPtrType<void>& ptr) { m_StackAllocator.Deallocate(ptr); }
 
     NO_DISCARD void* AllocateArray(const Size objectCount, const Size objectSize, const Alignment& alignment,
                                    const std::string& category = "", const SourceLocation& sourceLocation = SourceLocation::current())
@@ -83,7 +88,7 @@ class StackAllocatorTemplated
 
     Size DeallocateArray(void* ptr, const Size objectSize) { return m_StackAllocator.DeallocateArray(ptr, objectSize); }
 
-    Size DeallocateArray(const StackArrayPtr<void>& ptr, const Size objectSize)
+    Size DeallocateArray(const StackArrayPtrType<void>& ptr, const Size objectSize)
     {
         return m_StackAllocator.DeallocateArray(ptr, objectSize);
     }
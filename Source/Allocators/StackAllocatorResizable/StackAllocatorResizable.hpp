@@ -11,6 +11,7 @@
 #include "Source/Policies/BoundsCheckPolicy.hpp"
 #include "Source/Policies/MultithreadedPolicy.hpp"
 #include "Source/Policies/Policies.hpp"
+#include "Source/Probes.hpp"
 #include "Source/Traits.hpp"
 #include "Source/Utility/Alignment/Alignment.hpp"
 
@@ -108,7 +109,7 @@ class StackAllocator : public Allocator
     {
     }
 
-    ~StackAllocator() { m_BaseAllocator->DeallocateBase(m_StartPtr); };
+    ~StackAllocator() { m_BaseAllocator->DeallocateBase(m_StartPtr, GetTotalSize()); };
 
     friend bool operator==(const StackAllocator& s1, const StackAllocator& s2) { return s1.m_StartAddress == s2.m_StartAddress; }
 
@@ -249,6 +250,7 @@ class StackAllocator : public Allocator
     inline void Release()
     {
         LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+        MEMARENA_PROBE(release, this);
         SetCurrentOffset(0);
     };
 
@@ -308,6 +310,8 @@ class StackAllocator : public Allocator
             AddAllocation(size, category, sourceLocation);
         }
 
+        MEMARENA_PROBE(allocate, this, allocatedPtr, size);
+
         return {allocatedPtr, startOffset, endOffset};
     }
 
@@ -342,6 +346,8 @@ class StackAllocator : public Allocator
             AddDeallocation();
         }
 
+        MEMARENA_PROBE(deallocate, this, address);
+
         SetCurrentOffset(newOffset);
     }
 
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Source/Allocators/PoolAllocator/PoolAllocator.hpp"
+#include "Source/Macros.hpp"
+#include "Source/Policies/MultithreadedPolicy.hpp"
+#include "Source/Traits.hpp"
+#include "Source/Utility/Math.hpp"
+#include "Source/Utility/TypeName.hpp"
+
+namespace Memarena
+{
+
+namespace Internal
+{
+inline Size NextTypeIndex()
+{
+    static std::atomic<Size> typeCount = 0;
+    return typeCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief A dense index for every type, assigned on first use. Every instantiation has its own index, so no hashing is involved
+ */
+template <typename T>
+Size GetTypeIndex()
+{
+    static const Size typeIndex = NextTypeIndex();
+    return typeIndex;
+}
+} // namespace Internal
+
+struct TypedPoolStats
+{
+    Size   objectSize        = 0;
+    Size   blockCount        = 0;
+    Size   usedSize          = 0;
+    Size   totalSize         = 0;
+    UInt32 allocationCount   = 0;
+    UInt32 deallocationCount = 0;
+};
+
+constexpr PoolAllocatorSettings typedPoolsDefaultSettings = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::Growable |
+                                                                       PoolAllocatorPolicy::AdaptiveBlockSize};
+
+/**
+ * @brief A registry of pools with one PoolAllocator per type. `New<T>` routes to the pool for `T`, which is created on first use and
+ * found through a dense per-type index instead of a hash lookup. Every pool grows on its own, so with the adaptive block size policy
+ * busy types get large blocks while rarely used ones stay small
+ */
+template <PoolAllocatorSettings Settings = typedPoolsDefaultSettings, BaseAllocatorType BaseAllocator = MallocBase>
+class TypedPools
+{
+  private:
+    static constexpr bool IsMultithreaded = PolicyContains(Settings.policy, PoolAllocatorPolicy::Multithreaded);
+
+    using ThreadPolicy = MultithreadedPolicy<IsMultithreaded>;
+
+    template <typename SyncPrimitive>
+    using LockGuard = typename ThreadPolicy::template LockGuard<SyncPrimitive>;
+    using Mutex     = typename ThreadPolicy::Mutex;
+
+    using Pool = PoolAllocator<Settings, BaseAllocator>;
+
+  public:
+    // Prohibit default construction, moving and assignment
+    TypedPools()                  = delete;
+    TypedPools(const TypedPools&) = delete;
+    TypedPools(TypedPools&)       = delete;
+    TypedPools(TypedPools&&)      = delete;
+    TypedPools& operator=(const TypedPools&) = delete;
+    TypedPools& operator=(TypedPools&&) = delete;
+
+    /**
+     * @param objectsPerBlock The number of objects in the first block of every pool that is created on first use
+     */
+    explicit TypedPools(const Size objectsPerBlock, const std::string& debugName = "TypedPools",
+                        BaseAllocator baseAllocator = BaseAllocator())
+        : m_ObjectsPerBlock(objectsPerBlock), m_DebugName(debugName), m_BaseAllocator(std::move(baseAllocator))
+    {
+    }
+
+    ~TypedPools() = default;
+
+    template <Allocatable Object, typename... Args>
+    NO_DISCARD Object* New(Args&&... argList)
+    {
+        void* voidPtr = GetPool<Object>().Allocate();
+        RETURN_IF_NULLPTR(voidPtr);
+        return std::construct_at(static_cast<Object*>(voidPtr), std::forward<Args>(argList)...);
+    }
+
+    template <Allocatable Object>
+    void Delete(Object*& ptr)
+    {
+        MEMARENA_ASSERT_RETURN(ptr != nullptr, void(), "Error: Cannot delete nullptr in '%s'!\n", m_DebugName.c_str());
+
+        Pool* pool = FindPool(Internal::GetTypeIndex<Object>());
+
+        MEMARENA_ASSERT_RETURN(pool != nullptr, void(), "Error: There is no pool for '%s' in '%s'!\n",
+                               std::string(Internal::GetTypeName<Object>()).c_str(), m_DebugName.c_str());
+
+        std::destroy_at(ptr);
+        void* voidPtr = ptr;
+        pool->Deallocate(voidPtr);
+        ptr = nullptr;
+    }
+
+    /**
+     * @brief Creates the pool for `Object` with its own block size. Has to be called before the first `New<Object>`, afterwards the pool
+     * exists already and is returned unchanged
+     */
+    template <Allocatable Object>
+    Pool& CreatePool(const Size objectsPerBlock, const BlockSizeBounds& objectsPerBlockBounds = {})
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        const Size typeIndex = Internal::GetTypeIndex<Object>();
+
+        MEMARENA_ASSERT_RETURN(!HasPoolInternal(typeIndex), *m_Pools[typeIndex], "Error: The pool for '%s' already exists in '%s'!\n",
+                               std::string(Internal::GetTypeName<Object>()).c_str(), m_DebugName.c_str());
+
+        return CreatePoolInternal<Object>(typeIndex, objectsPerBlock, objectsPerBlockBounds);
+    }
+
+    /**
+     * @brief Returns the pool for `Object`, creating it if it doesn't exist yet. Existing pools are found without taking the lock
+     */
+    template <Allocatable Object>
+    Pool& GetPool()
+    {
+        const Size typeIndex = Internal::GetTypeIndex<Object>();
+
+        if (Pool* pool = FindPool(typeIndex); pool != nullptr) [[likely]]
+        {
+            return *pool;
+        }
+
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        // Another thread could have created the pool since the lookup
+        if (!HasPoolInternal(typeIndex))
+        {
+            return CreatePoolInternal<Object>(typeIndex, m_ObjectsPerBlock, {});
+        }
+
+        return *m_Pools[typeIndex];
+    }
+
+    template <Allocatable Object>
+    [[nodiscard]] bool HasPool() const
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        return HasPoolInternal(Internal::GetTypeIndex<Object>());
+    }
+
+    template <Allocatable Object>
+    [[nodiscard]] TypedPoolStats GetStats() const
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        const Size typeIndex = Internal::GetTypeIndex<Object>();
+
+        if (!HasPoolInternal(typeIndex))
+        {
+            return {};
+        }
+
+        const Pool& pool = *m_Pools[typeIndex];
+
+        return {.objectSize        = pool.GetObjectSize(),
+                .blockCount        = pool.GetBlockCount(),
+                .usedSize          = pool.GetUsedSize(),
+                .totalSize         = pool.GetTotalSize(),
+                .allocationCount   = pool.GetAllocationCount(),
+                .deallocationCount = pool.GetDeallocationCount()};
+    }
+
+    /**
+     * @brief Frees all objects of all types at once, returning every pool to a single block. Destructors are not called
+     */
+    void ReleaseAll()
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        for (std::unique_ptr<Pool>& pool : m_Pools)
+        {
+            if (pool != nullptr)
+            {
+                pool->Release();
+            }
+        }
+    }
+
+    [[nodiscard]] Size GetPoolCount() const
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        return std::ranges::count_if(m_Pools, [](const std::unique_ptr<Pool>& pool) { return pool != nullptr; });
+    }
+
+    [[nodiscard]] Size GetUsedSize() const
+    {
+        return Accumulate([](const Pool& pool) { return pool.GetUsedSize(); });
+    }
+
+    [[nodiscard]] Size GetTotalSize() const
+    {
+        return Accumulate([](const Pool& pool) { return pool.GetTotalSize(); });
+    }
+
+    [[nodiscard]] const std::string& GetDebugName() const { return m_DebugName; }
+
+  private:
+    // The published pool pointers, indexed like `m_Pools`. A full table is replaced by a larger copy instead of growing in place, so
+    // lookups can read it without the lock
+    struct PoolTable
+    {
+        explicit PoolTable(const Size capacity) : pools(capacity) {}
+
+        std::vector<std::atomic<Pool*>> pools;
+    };
+
+    [[nodiscard]] Pool* FindPool(const Size typeIndex) const
+    {
+        const PoolTable* table = m_PoolTable.load(std::memory_order_acquire);
+
+        if (table == nullptr || typeIndex >= table->pools.size())
+        {
+            return nullptr;
+        }
+
+        return table->pools[typeIndex].load(std::memory_order_acquire);
+    }
+
+    // Must be called with the lock held, after the pool is fully constructed
+    void PublishPool(const Size typeIndex, Pool& pool)
+    {
+        PoolTable* table = m_PoolTable.load(std::memory_order_relaxed);
+
+        if (table != nullptr && typeIndex < table->pools.size())
+        {
+            table->pools[typeIndex].store(&pool, std::memory_order_release);
+            return;
+        }
+
+        const Size capacity = table == nullptr ? typeIndex + 1 : std::max(typeIndex + 1, 2 * table->pools.size());
+        auto       newTable = std::make_unique<PoolTable>(capacity);
+
+        for (Size index = 0; index < m_Pools.size(); index++)
+        {
+            newTable->pools[index].store(m_Pools[index].get(), std::memory_order_relaxed);
+        }
+
+        m_PoolTable.store(newTable.get(), std::memory_order_release);
+        m_PoolTables.push_back(std::move(newTable));
+    }
+
+    [[nodiscard]] bool HasPoolInternal(const Size typeIndex) const { return typeIndex < m_Pools.size() && m_Pools[typeIndex] != nullptr; }
+
+    template <Allocatable Object>
+    Pool& CreatePoolInternal(const Size typeIndex, const Size objectsPerBlock, const BlockSizeBounds& objectsPerBlockBounds)
+    {
+        static_assert(alignof(Object) <= alignof(std::max_align_t), "Over-aligned types are not supported by TypedPools");
+
+        // Chunks hold the free list link while they are free and every chunk must stay aligned for `Object`
+        const Size objectSize = RoundUpToMultiple(std::max(sizeof(Object), sizeof(void*)), alignof(Object));
+
+        if (typeIndex >= m_Pools.size())
+        {
+            m_Pools.resize(typeIndex + 1);
+        }
+
+        const std::string debugName = m_DebugName + "/" + std::string(Internal::GetTypeName<Object>());
+        m_Pools[typeIndex] = std::make_unique<Pool>(objectSize, objectsPerBlock, objectsPerBlockBounds, debugName, m_BaseAllocator);
+
+        PublishPool(typeIndex, *m_Pools[typeIndex]);
+
+        return *m_Pools[typeIndex];
+    }
+
+    template <typename Getter>
+    [[nodiscard]] Size Accumulate(Getter getter) const
+    {
+        LockGuard<Mutex> guard(m_MultithreadedPolicy.m_Mutex);
+
+        Size total = 0;
+        for (const std::unique_ptr<Pool>& pool : m_Pools)
+        {
+            if (pool != nullptr)
+            {
+                total += getter(*pool);
+            }
+        }
+        return total;
+    }
+
+    mutable ThreadPolicy m_MultithreadedPolicy;
+
+    // Indexed by `Internal::GetTypeIndex`, types without a pool in this registry are null
+    std::vector<std::unique_ptr<Pool>> m_Pools;
+
+    // Replaced tables are kept until destruction, since a lookup on another thread could still read them
+    std::atomic<PoolTable*>                 m_PoolTable = nullptr;
+    std::vector<std::unique_ptr<PoolTable>> m_PoolTables;
+
+    Size                            m_ObjectsPerBlock;
+    std::string                     m_DebugName;
+    NO_UNIQUE_ADDRESS BaseAllocator m_BaseAllocator;
+};
+} // namespace Memarena
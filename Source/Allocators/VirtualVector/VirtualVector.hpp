@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+
+#include "Source/AllocatorSettings.hpp"
+#include "Source/Assert.hpp"
+#include "Source/Macros.hpp"
+#include "Source/Policies/Policies.hpp"
+#include "Source/Utility/Math.hpp"
+#include "Source/Utility/VirtualMemory.hpp"
+
+namespace Memarena
+{
+
+using VirtualVectorSettings = AllocatorSettings<VirtualVectorPolicy>;
+
+constexpr VirtualVectorSettings virtualVectorDefaultSettings = {};
+
+/**
+ * @brief An append-only friendly vector that reserves the address space for its maximum count up front and commits pages as it grows.
+ * Growing never reallocates or copies, so element addresses stay stable for the lifetime of the vector and there is no moment where
+ * the old and the new storage are both alive. Reserving address space is cheap, only the committed pages count towards the memory of
+ * the process
+ *
+ * Pages are committed in steps of `commitStepSize` and are only returned by `ShrinkToFit`. Like std::vector it isn't thread-safe
+ */
+template <typename Object, VirtualVectorSettings Settings = virtualVectorDefaultSettings>
+class VirtualVector
+{
+    static_assert(alignof(Object) <= 4096, "Objects can't be aligned beyond the smallest page size");
+
+  private:
+    static constexpr bool UsesHugePages        = PolicyContains(Settings.policy, VirtualVectorPolicy::HugePages);
+    static constexpr bool IsBoundsCheckEnabled = PolicyContains(Settings.policy, VirtualVectorPolicy::BoundsCheck);
+
+  public:
+    using value_type     = Object;
+    using iterator       = Object*;
+    using const_iterator = const Object*;
+
+    // Prohibit default construction, moving and assignment, the elements live at the reserved addresses
+    VirtualVector()                     = delete;
+    VirtualVector(const VirtualVector&) = delete;
+    VirtualVector(VirtualVector&)       = delete;
+    VirtualVector(VirtualVector&&)      = delete;
+    VirtualVector& operator=(const VirtualVector&) = delete;
+    VirtualVector& operator=(VirtualVector&&) = delete;
+
+    /**
+     * @param maxCount The most elements the vector can ever hold, its address space is reserved on construction
+     * @param commitStepSize The granularity in which pages are committed, rounded up to a multiple of the page size
+     */
+    explicit VirtualVector(const Size maxCount, const Size commitStepSize = defaultCommitStepSize,
+                           const std::string& debugName = "VirtualVector")
+        : m_ReservedSize(maxCount <= GetMaxCountLimit() ? RoundUpToPageSize(maxCount * sizeof(Object)) : 0),
+          m_CommitStepSize(RoundUpToPageSize(std::max<Size>(commitStepSize, 1))),
+          m_DebugName(debugName)
+    {
+        MEMARENA_ASSERT(maxCount > 0, "Error: The max count must be greater than 0 for the virtual vector '%s'\n", m_DebugName.c_str());
+
+        if (maxCount > GetMaxCountLimit())
+        {
+            MEMARENA_ERROR("Error: The max count %zu of the virtual vector '%s' is larger than the address space!\n", maxCount,
+                           m_DebugName.c_str());
+            return;
+        }
+
+        void* region = ReserveVirtualMemory(m_ReservedSize);
+        if (region == nullptr)
+        {
+            MEMARENA_ERROR("Error: Failed to reserve %zu bytes for the virtual vector '%s'!\n", m_ReservedSize, m_DebugName.c_str());
+            m_ReservedSize = 0;
+            return;
+        }
+
+        m_Data     = static_cast<Object*>(region);
+        m_MaxCount = maxCount;
+
+        // Huge pages have to be requested before the pages are faulted in
+        if constexpr (UsesHugePages)
+        {
+            m_HasHugePages = AdviseHugePages(region, m_ReservedSize);
+        }
+    }
+
+    ~VirtualVector()
+    {
+        std::destroy_n(m_Data, m_Count);
+        if (m_Data != nullptr)
+        {
+            FreeVirtualMemory(m_Data, m_ReservedSize);
+        }
+    }
+
+    /**
+     * @brief Constructs an element at the end and returns it, or nullptr if the vector is full or the pages couldn't be committed
+     */
+    template <typename... Args>
+    Object* EmplaceBack(Args&&... argList)
+    {
+        if (m_Count == m_CommittedCount && !Commit(m_Count + 1))
+        {
+            return nullptr;
+        }
+
+        Object* object = new (m_Data + m_Count) Object(std::forward<Args>(argList)...);
+        m_Count++;
+        return object;
+    }
+
+    Object* PushBack(const Object& object) { return EmplaceBack(object); }
+    Object* PushBack(Object&& object) { return EmplaceBack(std::move(object)); }
+
+    void PopBack()
+    {
+        if constexpr (IsBoundsCheckEnabled)
+        {
+            MEMARENA_ASSERT_RETURN(m_Count > 0, void(), "Error: Popping from the empty virtual vector '%s'!\n", m_DebugName.c_str());
+        }
+
+        m_Count--;
+        std::destroy_at(m_Data + m_Count);
+    }
+
+    /**
+     * @brief Commits the pages for `count` elements up front. Returns false if `count` exceeds the max count or committing failed
+     */
+    bool Reserve(const Size count) { return count <= m_CommittedCount || Commit(count); }
+
+    /**
+     * @brief Value-initializes new elements or destroys the ones past `count`. Returns false if the pages couldn't be committed
+     */
+    bool Resize(const Size count)
+    {
+        if (count < m_Count)
+        {
+            std::destroy(m_Data + count, m_Data + m_Count);
+            m_Count = count;
+            return true;
+        }
+
+        if (!Reserve(count))
+        {
+            return false;
+        }
+
+        std::uninitialized_value_construct(m_Data + m_Count, m_Data + count);
+        m_Count = count;
+        return true;
+    }
+
+    /**
+     * @brief Destroys all elements. The pages stay committed for reuse
+     */
+    void Clear()
+    {
+        std::destroy_n(m_Data, m_Count);
+        m_Count = 0;
+    }
+
+    /**
+     * @brief Returns the committed pages past the commit step of the last element to the OS
+     */
+    void ShrinkToFit()
+    {
+        const Size requiredSize = std::min(RoundUpToMultiple(m_Count * sizeof(Object), m_CommitStepSize), m_ReservedSize);
+        if (requiredSize < m_CommittedSize)
+        {
+            DecommitVirtualMemory(reinterpret_cast<Byte*>(m_Data) + requiredSize, m_CommittedSize - requiredSize);
+            SetCommittedSize(requiredSize);
+        }
+    }
+
+    [[nodiscard]] Object& operator[](const Size index)
+    {
+        CheckIndex(index);
+        return m_Data[index];
+    }
+
+    [[nodiscard]] const Object& operator[](const Size index) const
+    {
+        CheckIndex(index);
+        return m_Data[index];
+    }
+
+    [[nodiscard]] Object&       Front() { return (*this)[0]; }
+    [[nodiscard]] const Object& Front() const { return (*this)[0]; }
+    [[nodiscard]] Object&       Back() { return (*this)[m_Count - 1]; }
+    [[nodiscard]] const Object& Back() const { return (*this)[m_Count - 1]; }
+
+    [[nodiscard]] Object*       GetData() { return m_Data; }
+    [[nodiscard]] const Object* GetData() const { return m_Data; }
+
+    [[nodiscard]] iterator       begin() { return m_Data; }
+    [[nodiscard]] iterator       end() { return m_Data + m_Count; }
+    [[nodiscard]] const_iterator begin() const { return m_Data; }
+    [[nodiscard]] const_iterator end() const { return m_Data + m_Count; }
+
+    [[nodiscard]] Size               GetCount() const { return m_Count; }
+    [[nodiscard]] Size               GetMaxCount() const { return m_MaxCount; }
+    [[nodiscard]] bool               IsEmpty() const { return m_Count == 0; }
+    [[nodiscard]] Size               GetReservedSize() const { return m_ReservedSize; }
+    [[nodiscard]] Size               GetCommittedSize() const { return m_CommittedSize; }
+    [[nodiscard]] bool               HasHugePages() const { return m_HasHugePages; }
+    [[nodiscard]] const std::string& GetDebugName() const { return m_DebugName; }
+
+  private:
+    static constexpr Size defaultCommitStepSize = 1024 * 1024;
+
+    [[nodiscard]] static Size RoundUpToPageSize(const Size size) { return RoundUpToMultiple(size, GetPageSize()); }
+
+    // The reserved size has to fit into a Size after it is rounded up to the page size
+    [[nodiscard]] static Size GetMaxCountLimit() { return (std::numeric_limits<Size>::max() - GetPageSize()) / sizeof(Object); }
+
+    bool Commit(const Size count)
+    {
+        MEMARENA_ASSERT_RETURN(count <= m_MaxCount, false, "Error: The virtual vector '%s' is full, it has room for %zu elements!\n",
+                               m_DebugName.c_str(), m_MaxCount);
+
+        // The last step is cut at the end of the reservation
+        const Size requiredSize = std::min(RoundUpToMultiple(count * sizeof(Object), m_CommitStepSize), m_ReservedSize);
+        if (!CommitVirtualMemory(reinterpret_cast<Byte*>(m_Data) + m_CommittedSize, requiredSize - m_CommittedSize))
+        {
+            MEMARENA_ERROR("Error: Failed to commit %zu bytes for the virtual vector '%s'!\n", requiredSize - m_CommittedSize,
+                           m_DebugName.c_str());
+            return false;
+        }
+
+        SetCommittedSize(requiredSize);
+        return true;
+    }
+
+    // The pages past the last element that fits into the reservation can't hold elements, so the committed count stops at the max count
+    void SetCommittedSize(const Size committedSize)
+    {
+        m_CommittedSize  = committedSize;
+        m_CommittedCount = std::min(committedSize / sizeof(Object), m_MaxCount);
+    }
+
+    void CheckIndex([[maybe_unused]] const Size index) const
+    {
+        if constexpr (IsBoundsCheckEnabled)
+        {
+            MEMARENA_ASSERT(index < m_Count, "Error: The index %zu is out of bounds of the virtual vector '%s' with %zu elements!\n", index,
+                            m_DebugName.c_str(), m_Count);
+        }
+    }
+
+    Object*     m_Data           = nullptr;
+    Size        m_Count          = 0;
+    Size        m_MaxCount       = 0;
+    Size        m_ReservedSize   = 0;
+    Size        m_CommittedSize  = 0;
+    Size        m_CommittedCount = 0; // The elements that fit into the committed pages
+    Size        m_CommitStepSize;
+    bool        m_HasHugePages   = false;
+    std::string m_DebugName;
+};
+} // namespace Memarena
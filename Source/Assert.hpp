@@ -4,8 +4,10 @@
 
 #include "Aliases.hpp"
 #include "DebugBreak.hpp"
+#include "Probes.hpp"
 
 #define MEMARENA_HANDLE_ASSERT_FAILURE(breakOnFailureIsEnabled, failureLoggingIsEnabled, ...) \
+    MEMARENA_PROBE(assert_failure, __FILE__, __LINE__);                                       \
     if constexpr (failureLoggingIsEnabled)                                                    \
     {                                                                                         \
         fprintf(stderr, __VA_ARGS__);                                                         \
@@ -0,0 +1,232 @@
+#include "PCH.hpp"
+
+#include "HeapProfiler.hpp"
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+
+#if __has_include(<execinfo.h>)
+    #include <execinfo.h>
+    #define MEMARENA_HAS_BACKTRACE
+#endif
+
+namespace Memarena
+{
+
+std::mutex                  HeapProfiler::m_Mutex;
+HeapProfiler::StackMap      HeapProfiler::m_Stacks;
+HeapProfiler::LiveSampleMap HeapProfiler::m_LiveSamples;
+std::atomic<Size>           HeapProfiler::m_SamplingInterval = DefaultSamplingInterval;
+std::atomic<Size>           HeapProfiler::m_LiveSampleCount  = 0;
+
+std::array<std::atomic<UInt32>, HeapProfiler::SampleFilterSize> HeapProfiler::m_SampleFilter;
+
+void HeapProfiler::SetSamplingInterval(const Size samplingInterval)
+{
+    m_SamplingInterval.store(samplingInterval, std::memory_order_relaxed);
+    m_IsSamplingStarted = true;
+    m_BytesUntilSample  = DrawSamplingDistance();
+}
+
+bool HeapProfiler::PickNextSample(const Size size)
+{
+    if (!m_IsSamplingStarted)
+    {
+        // The first allocation of a thread only picks the first sample, so it counts towards it
+        m_IsSamplingStarted = true;
+        m_BytesUntilSample  = DrawSamplingDistance() - static_cast<Int64>(size);
+        if (m_BytesUntilSample > 0)
+        {
+            return false;
+        }
+    }
+
+    m_BytesUntilSample = DrawSamplingDistance();
+    return GetSamplingInterval() > 0;
+}
+
+Int64 HeapProfiler::DrawSamplingDistance()
+{
+    const Size samplingInterval = GetSamplingInterval();
+    if (samplingInterval == 0)
+    {
+        // The thread checks again after a while, so it notices when another thread starts the sampling again
+        return static_cast<Int64>(DefaultSamplingInterval);
+    }
+
+    if (m_RandomState == 0)
+    {
+        // Every thread gets its own sequence, the address of a thread local variable differs between threads
+        m_RandomState = std::bit_cast<UIntPtr>(&m_RandomState) | 1;
+    }
+
+    // xorshift64*, a uniform value in (0, 1] and the inverse of the exponential distribution
+    m_RandomState ^= m_RandomState >> 12;
+    m_RandomState ^= m_RandomState << 25;
+    m_RandomState ^= m_RandomState >> 27;
+    const UInt64 random  = m_RandomState * 0x2545F4914F6CDD1DULL;
+    const double uniform = static_cast<double>((random >> 11) + 1) / static_cast<double>(1ULL << 53);
+
+    const double distance = -std::log(uniform) * static_cast<double>(samplingInterval);
+    return static_cast<Int64>(std::min(distance, static_cast<double>(std::numeric_limits<Int64>::max() / 2))) + 1;
+}
+
+void HeapProfiler::RecordAllocation(const void* owner, const void* ptr, const Size size)
+{
+    std::vector<void*> stack;
+#ifdef MEMARENA_HAS_BACKTRACE
+    stack.resize(MaxStackDepth);
+    stack.resize(static_cast<Size>(std::max(backtrace(stack.data(), static_cast<int>(MaxStackDepth)), 0)));
+
+    // Skip this function, so the stacks start in the allocator
+    if (!stack.empty())
+    {
+        stack.erase(stack.begin());
+    }
+#endif
+
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    StackStats& stats = m_Stacks[std::move(stack)];
+    stats.allocatedCount++;
+    stats.allocatedSize += size;
+    stats.inUseCount++;
+    stats.inUseSize += size;
+
+    auto [it, isInserted] = m_LiveSamples.try_emplace({owner, ptr}, LiveSample{.size = size, .stats = &stats});
+    if (isInserted)
+    {
+        m_SampleFilter[GetSampleFilterIndex(ptr)].fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        // A sample that was freed without being reported, e.g. an allocation overwritten by a StackAllocator without the stack check
+        it->second.stats->inUseCount--;
+        it->second.stats->inUseSize -= it->second.size;
+        it->second = LiveSample{.size = size, .stats = &stats};
+    }
+
+    m_LiveSampleCount.store(m_LiveSamples.size(), std::memory_order_relaxed);
+}
+
+void HeapProfiler::RemoveSample(const void* owner, const void* ptr)
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    const auto it = m_LiveSamples.find({owner, ptr});
+    if (it == m_LiveSamples.end())
+    {
+        return;
+    }
+
+    it->second.stats->inUseCount--;
+    it->second.stats->inUseSize -= it->second.size;
+    m_SampleFilter[GetSampleFilterIndex(ptr)].fetch_sub(1, std::memory_order_relaxed);
+    m_LiveSamples.erase(it);
+
+    m_LiveSampleCount.store(m_LiveSamples.size(), std::memory_order_relaxed);
+}
+
+void HeapProfiler::RecordRelease(const void* owner)
+{
+    if (GetLiveSampleCount() == 0)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    std::erase_if(m_LiveSamples, [owner](const auto& entry) {
+        if (entry.first.first != owner)
+        {
+            return false;
+        }
+
+        entry.second.stats->inUseCount--;
+        entry.second.stats->inUseSize -= entry.second.size;
+        m_SampleFilter[GetSampleFilterIndex(entry.first.second)].fetch_sub(1, std::memory_order_relaxed);
+        return true;
+    });
+
+    m_LiveSampleCount.store(m_LiveSamples.size(), std::memory_order_relaxed);
+}
+
+void HeapProfiler::WriteProfile(std::ostream& stream)
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    StackStats totalStats;
+    for (const auto& [stack, stats] : m_Stacks)
+    {
+        totalStats.allocatedCount += stats.allocatedCount;
+        totalStats.allocatedSize += stats.allocatedSize;
+        totalStats.inUseCount += stats.inUseCount;
+        totalStats.inUseSize += stats.inUseSize;
+    }
+
+    // pprof scales the samples back to the whole heap with the sampling interval in the header
+    const auto writeStats = [&stream](const StackStats& stats) {
+        stream << std::setw(6) << stats.inUseCount << ": " << std::setw(8) << stats.inUseSize << " [" << std::setw(6)
+               << stats.allocatedCount << ": " << std::setw(8) << stats.allocatedSize << "] @";
+    };
+
+    stream << "heap profile: ";
+    writeStats(totalStats);
+    stream << " heap_v2/" << GetSamplingInterval() << '\n';
+
+    for (const auto& [stack, stats] : m_Stacks)
+    {
+        writeStats(stats);
+        for (const void* address : stack)
+        {
+            stream << " 0x" << std::hex << std::bit_cast<UIntPtr>(address) << std::dec;
+        }
+        stream << '\n';
+    }
+
+    // The mappings let pprof symbolize the addresses of shared libraries and position independent executables
+    std::ifstream maps("/proc/self/maps");
+    if (maps.is_open())
+    {
+        stream << "\nMAPPED_LIBRARIES:\n" << maps.rdbuf();
+    }
+}
+
+bool HeapProfiler::WriteProfile(const std::string& filePath)
+{
+    std::ofstream file(filePath, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    WriteProfile(file);
+    return file.good();
+}
+
+Size HeapProfiler::GetSampleCount()
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    Size sampleCount = 0;
+    for (const auto& [stack, stats] : m_Stacks)
+    {
+        sampleCount += stats.allocatedCount;
+    }
+    return sampleCount;
+}
+
+void HeapProfiler::Reset()
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    m_LiveSamples.clear();
+    m_Stacks.clear();
+    m_LiveSampleCount.store(0, std::memory_order_relaxed);
+    for (std::atomic<UInt32>& count : m_SampleFilter)
+    {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+} // namespace Memarena
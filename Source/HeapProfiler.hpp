@@ -0,0 +1,135 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Aliases.hpp"
+
+namespace Memarena
+{
+
+/**
+ * @brief Samples the allocations of every allocator with the `HeapProfiling` policy and writes the sampled allocations as a heap
+ * profile that pprof can read.
+ *
+ * Allocations are sampled by the bytes allocated, on average once every `GetSamplingInterval()` bytes per thread. The distance to the
+ * next sample is drawn from an exponential distribution, which makes the sampling a Poisson process, so a large allocation is more
+ * likely to be sampled than a small one and pprof can scale the samples back to an estimate of the whole heap. Allocations that are not
+ * sampled cost a thread local subtraction, only sampled allocations capture a stack trace and take the lock. Deallocations check a
+ * table of live sample counts by hashed address first and only take the lock if a live sample hashes to the same entry
+ */
+class HeapProfiler
+{
+  public:
+    static constexpr Size DefaultSamplingInterval = 512 * 1024;
+    static constexpr Size MaxStackDepth           = 64;
+
+    HeapProfiler() = default;
+
+    /**
+     * @brief Sets the average amount of bytes between two samples. An interval of 0 stops the sampling. The calling thread picks its
+     * next sample right away, other threads after their next sample. While the sampling is stopped, threads check the interval again
+     * every `DefaultSamplingInterval` bytes
+     */
+    static void               SetSamplingInterval(Size samplingInterval);
+    [[nodiscard]] static Size GetSamplingInterval() { return m_SamplingInterval.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Counts `size` bytes towards the next sample of the calling thread and returns true if the allocation has to be sampled
+     */
+    [[nodiscard]] static inline bool ShouldSample(const Size size)
+    {
+        m_BytesUntilSample -= static_cast<Int64>(size);
+        return m_BytesUntilSample <= 0 && PickNextSample(size);
+    }
+
+    // `owner` is the allocator of `ptr`. A child arena can hand out the address of its block, which is also an allocation of the parent,
+    // so samples are looked up by both. Releasing an arena drops all of its samples at once
+    static void RecordAllocation(const void* owner, const void* ptr, Size size);
+    static void RecordRelease(const void* owner);
+
+    static inline void RecordDeallocation(const void* owner, const void* ptr)
+    {
+        if (m_SampleFilter[GetSampleFilterIndex(ptr)].load(std::memory_order_relaxed) != 0)
+        {
+            RemoveSample(owner, ptr);
+        }
+    }
+
+    /**
+     * @brief Writes the sampled allocations in the legacy heap profile format of gperftools, e.g. for `pprof -top binary profile`. The
+     * in-use columns hold the live sampled allocations and the allocated columns every sampled allocation since the last `Reset`
+     */
+    static void WriteProfile(std::ostream& stream);
+    static bool WriteProfile(const std::string& filePath);
+
+    [[nodiscard]] static Size GetSampleCount();
+    [[nodiscard]] static Size GetLiveSampleCount() { return m_LiveSampleCount.load(std::memory_order_relaxed); }
+
+    static void Reset();
+
+  private:
+    struct StackStats
+    {
+        UInt64 allocatedCount = 0;
+        UInt64 allocatedSize  = 0;
+        UInt64 inUseCount     = 0;
+        UInt64 inUseSize      = 0;
+    };
+
+    struct LiveSample
+    {
+        Size        size  = 0;
+        StackStats* stats = nullptr;
+    };
+
+    using SampleKey = std::pair<const void*, const void*>; // The owner and the address
+
+    struct SampleKeyHash
+    {
+        Size operator()(const SampleKey& key) const
+        {
+            return std::hash<const void*>{}(key.first) ^ (std::hash<const void*>{}(key.second) * 31);
+        }
+    };
+
+    using StackMap      = std::map<std::vector<void*>, StackStats>; // Node based, so the stats of a stack never move
+    using LiveSampleMap = std::unordered_map<SampleKey, LiveSample, SampleKeyHash>;
+
+    static bool  PickNextSample(Size size);
+    static Int64 DrawSamplingDistance();
+    static void  RemoveSample(const void* owner, const void* ptr);
+
+    // The live samples per hashed address, with few live samples almost every entry is 0. Guarded by `m_Mutex` for writes, the
+    // deallocations read it without the lock. A sample is counted before its allocation is returned, so a deallocation of it that
+    // happens after the allocation sees the count
+    static constexpr Size SampleFilterSize = 4096;
+
+    [[nodiscard]] static Size GetSampleFilterIndex(const void* ptr)
+    {
+        // Fibonacci hashing, which spreads the aligned addresses of neighbouring allocations over the table
+        return static_cast<Size>((std::bit_cast<UIntPtr>(ptr) * 0x9E3779B97F4A7C15ULL) >> (64 - std::countr_zero(SampleFilterSize)));
+    }
+
+    static std::mutex        m_Mutex;
+    static StackMap          m_Stacks;
+    static LiveSampleMap     m_LiveSamples;
+    static std::atomic<Size> m_SamplingInterval;
+    static std::atomic<Size> m_LiveSampleCount;
+
+    static std::array<std::atomic<UInt32>, SampleFilterSize> m_SampleFilter;
+
+    static inline thread_local Int64  m_BytesUntilSample  = 0;
+    static inline thread_local bool   m_IsSamplingStarted = false;
+    static inline thread_local UInt64 m_RandomState       = 0;
+};
+} // namespace Memarena
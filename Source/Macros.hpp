@@ -8,6 +8,13 @@
 
 #define NO_DISCARD [[nodiscard(NO_DISCARD_ALLOC_INFO)]]
 
+// MSVC ignores the standard attribute and only honours its own spelling
+#if defined(_MSC_VER)
+    #define NO_UNIQUE_ADDRESS [[msvc::no_unique_address]]
+#else
+    #define NO_UNIQUE_ADDRESS [[no_unique_address]]
+#endif
+
 #define RETURN_IF_NULLPTR(ptr) \
     {                          \
         if (ptr == nullptr)    \
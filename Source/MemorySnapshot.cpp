@@ -0,0 +1,165 @@
+#include "PCH.hpp"
+
+#include "MemorySnapshot.hpp"
+
+#include <cstdio>
+
+namespace Memarena
+{
+
+namespace
+{
+Int64 ToMicroseconds(const std::chrono::steady_clock::duration duration)
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+}
+
+void WriteJsonString(std::ostream& stream, const std::string& text)
+{
+    stream << '"';
+    for (const char character : text)
+    {
+        switch (character)
+        {
+        case '"':
+            stream << "\\\"";
+            break;
+        case '\\':
+            stream << "\\\\";
+            break;
+        case '\n':
+            stream << "\\n";
+            break;
+        case '\r':
+            stream << "\\r";
+            break;
+        case '\t':
+            stream << "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(character) < 0x20)
+            {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(character));
+                stream << escaped;
+            }
+            else
+            {
+                stream << character;
+            }
+        }
+    }
+    stream << '"';
+}
+
+// Quotes fields that contain a separator, a quote or a line break and doubles the quotes in them
+void WriteCsvString(std::ostream& stream, const std::string& text)
+{
+    if (text.find_first_of(",\"\r\n") == std::string::npos)
+    {
+        stream << text;
+        return;
+    }
+
+    stream << '"';
+    for (const char character : text)
+    {
+        stream << (character == '"' ? "\"\"" : std::string(1, character));
+    }
+    stream << '"';
+}
+
+const char* ToString(const AllocatorDiffStatus status)
+{
+    switch (status)
+    {
+    case AllocatorDiffStatus::Added:
+        return "added";
+    case AllocatorDiffStatus::Removed:
+        return "removed";
+    default:
+        return "changed";
+    }
+}
+} // namespace
+
+void WriteJson(std::ostream& stream, const MemorySnapshot& snapshot)
+{
+    stream << "{\"time\":" << ToMicroseconds(snapshot.time.time_since_epoch()) << ",\"allocators\":[";
+    for (Size i = 0; i < snapshot.allocators.size(); i++)
+    {
+        const AllocatorSnapshot& allocator = snapshot.allocators[i];
+
+        stream << (i > 0 ? "," : "") << "{\"id\":" << allocator.id << ",\"name\":";
+        WriteJsonString(stream, allocator.debugName);
+        stream << ",\"baseAllocator\":" << (allocator.isBaseAllocator ? "true" : "false") << ",\"totalSize\":" << allocator.totalSize
+               << ",\"usedSize\":" << allocator.usedSize << ",\"peakUsage\":" << allocator.peakUsage
+               << ",\"allocationCount\":" << allocator.allocationCount << ",\"deallocationCount\":" << allocator.deallocationCount << '}';
+    }
+    stream << "]}\n";
+}
+
+void WriteJson(std::ostream& stream, const MemorySnapshotDiff& diff)
+{
+    stream << "{\"duration\":" << ToMicroseconds(diff.duration) << ",\"allocators\":[";
+    for (Size i = 0; i < diff.allocators.size(); i++)
+    {
+        const AllocatorDiff& allocator = diff.allocators[i];
+
+        stream << (i > 0 ? "," : "") << "{\"id\":" << allocator.id << ",\"name\":";
+        WriteJsonString(stream, allocator.debugName);
+        stream << ",\"status\":\"" << ToString(allocator.status) << "\",\"totalSize\":" << allocator.totalSize
+               << ",\"usedSize\":" << allocator.usedSize << ",\"peakUsage\":" << allocator.peakUsage
+               << ",\"allocationCount\":" << allocator.allocationCount << ",\"deallocationCount\":" << allocator.deallocationCount << '}';
+    }
+    stream << "]}\n";
+}
+
+void WriteCsv(std::ostream& stream, const MemorySnapshot& snapshot)
+{
+    stream << "id,name,baseAllocator,totalSize,usedSize,peakUsage,allocationCount,deallocationCount\n";
+    for (const AllocatorSnapshot& allocator : snapshot.allocators)
+    {
+        stream << allocator.id << ',';
+        WriteCsvString(stream, allocator.debugName);
+        stream << ',' << (allocator.isBaseAllocator ? 1 : 0) << ',' << allocator.totalSize << ',' << allocator.usedSize << ','
+               << allocator.peakUsage << ',' << allocator.allocationCount << ',' << allocator.deallocationCount << '\n';
+    }
+}
+
+void WriteCsv(std::ostream& stream, const MemorySnapshotDiff& diff)
+{
+    stream << "id,name,status,totalSize,usedSize,peakUsage,allocationCount,deallocationCount\n";
+    for (const AllocatorDiff& allocator : diff.allocators)
+    {
+        stream << allocator.id << ',';
+        WriteCsvString(stream, allocator.debugName);
+        stream << ',' << ToString(allocator.status) << ',' << allocator.totalSize << ',' << allocator.usedSize << ','
+               << allocator.peakUsage << ',' << allocator.allocationCount << ',' << allocator.deallocationCount << '\n';
+    }
+}
+
+void WriteChromeTrace(std::ostream& stream, const std::span<const MemorySnapshot> snapshots)
+{
+    stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool isFirstEvent = true;
+    for (const MemorySnapshot& snapshot : snapshots)
+    {
+        const Int64 timestamp = ToMicroseconds(snapshot.time.time_since_epoch());
+
+        // Counter events with the same name and ID form one track, so every allocator gets its own track even if names repeat
+        for (const AllocatorSnapshot& allocator : snapshot.allocators)
+        {
+            stream << (isFirstEvent ? "" : ",") << "{\"name\":";
+            WriteJsonString(stream, allocator.debugName);
+            stream << ",\"cat\":\"Memarena\",\"ph\":\"C\",\"ts\":" << timestamp << ",\"pid\":1,\"tid\":1,\"id\":\"" << allocator.id
+                   << "\",\"args\":{\"usedSize\":" << allocator.usedSize << ",\"totalSize\":" << allocator.totalSize << "}}";
+            isFirstEvent = false;
+        }
+    }
+
+    stream << "]}\n";
+}
+
+} // namespace Memarena
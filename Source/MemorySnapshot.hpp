@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Aliases.hpp"
+
+namespace Memarena
+{
+
+/**
+ * @brief A copy of the stats of one allocator, see `MemoryTracker::TakeSnapshot`
+ */
+struct AllocatorSnapshot
+{
+    UInt64      id = 0; // Unique for the lifetime of the process, so allocators with the same debug name can be told apart
+    std::string debugName;
+    Size        totalSize         = 0;
+    Size        usedSize          = 0;
+    Size        peakUsage         = 0;
+    UInt32      allocationCount   = 0;
+    UInt32      deallocationCount = 0;
+    bool        isBaseAllocator   = false;
+};
+
+struct MemorySnapshot
+{
+    std::chrono::steady_clock::time_point time;
+    std::vector<AllocatorSnapshot>        allocators; // Sorted by ID
+};
+
+enum class AllocatorDiffStatus : UInt8
+{
+    Changed, // The allocator is in both snapshots, even if none of its stats changed
+    Added,   // The allocator was created after the first snapshot
+    Removed, // The allocator was destroyed before the second snapshot
+};
+
+/**
+ * @brief The change of the stats of one allocator between two snapshots. An allocator that is missing from one of the snapshots
+ * counts as all zeros in it
+ */
+struct AllocatorDiff
+{
+    UInt64              id = 0;
+    std::string         debugName;
+    AllocatorDiffStatus status            = AllocatorDiffStatus::Changed;
+    Int64               totalSize         = 0;
+    Int64               usedSize          = 0;
+    Int64               peakUsage         = 0;
+    Int64               allocationCount   = 0;
+    Int64               deallocationCount = 0;
+};
+
+struct MemorySnapshotDiff
+{
+    std::chrono::steady_clock::duration duration{0};
+    std::vector<AllocatorDiff>          allocators; // Sorted by ID
+};
+
+/**
+ * @brief The rates of one allocator between two samples of the stats sampler, see `MemoryTracker::GetRates`. The byte rates are the
+ * net change of the sizes, so they are negative while the allocator shrinks
+ */
+struct AllocatorRates
+{
+    UInt64      id = 0;
+    std::string debugName;
+    double      allocationsPerSecond   = 0.0;
+    double      deallocationsPerSecond = 0.0;
+    double      usedBytesPerSecond     = 0.0;
+    double      totalBytesPerSecond    = 0.0;
+};
+
+void WriteJson(std::ostream& stream, const MemorySnapshot& snapshot);
+void WriteJson(std::ostream& stream, const MemorySnapshotDiff& diff);
+
+// One row per allocator after a header row
+void WriteCsv(std::ostream& stream, const MemorySnapshot& snapshot);
+void WriteCsv(std::ostream& stream, const MemorySnapshotDiff& diff);
+
+/**
+ * @brief Writes the snapshots in the Chrome trace event format, with a counter track of the used and total size per allocator, for
+ * `chrome://tracing` or Perfetto. The snapshots have to be in the order they were taken
+ */
+void WriteChromeTrace(std::ostream& stream, std::span<const MemorySnapshot> snapshots);
+
+} // namespace Memarena
@@ -3,7 +3,12 @@
 #include "MemoryTracker.hpp"
 
 #include "AllocatorData.hpp"
+#include "Allocators/Mallocator/Mallocator.hpp"
+#include "StatsSampler.hpp"
+#include <algorithm>
+#include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace Memarena
 {
@@ -12,11 +17,23 @@ std::mutex      MemoryTracker::m_Mutex;
 AllocatorVector MemoryTracker::m_Allocators;
 AllocatorVector MemoryTracker::m_BaseAllocators;
 Cache<Size>     MemoryTracker::m_TotalAllocatedSize = {0, false};
+UInt64          MemoryTracker::m_NextAllocatorId    = 1;
+
+std::mutex                    MemoryTracker::m_SamplerMutex;
+std::unique_ptr<StatsSampler> MemoryTracker::m_StatsSampler;
+
+std::vector<std::unique_ptr<MemoryTracker::ThreadAllocationCounters>> MemoryTracker::m_ThreadCounters;
+std::map<std::string, MemoryTracker::ThreadCounts>                    MemoryTracker::m_ExitedThreadCounts;
+
+// Defined after the state of the tracker, so it is destroyed before the allocator lists it unregisters from
+const std::shared_ptr<Allocator> Allocator::m_DefaultAllocator = std::make_shared<DefaultMallocator>("DefaultMallocator");
 
 void MemoryTracker::RegisterAllocator(const std::shared_ptr<AllocatorData>& allocatorData)
 {
     std::lock_guard<std::mutex> guard(m_Mutex);
 
+    allocatorData->id = m_NextAllocatorId++;
+
     if (allocatorData->isBaseAllocator)
     {
         m_BaseAllocators.push_back(allocatorData);
@@ -41,6 +58,18 @@ void MemoryTracker::UnRegisterAllocator(const std::shared_ptr<AllocatorData>& al
     }
 }
 
+void MemoryTracker::SetParent(const std::shared_ptr<AllocatorData>& child, const std::shared_ptr<AllocatorData>& parent,
+                              const AllocatorRelation relation)
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    if (child->parentRelation == AllocatorRelation::None && child != parent)
+    {
+        child->parentId       = parent->id;
+        child->parentRelation = relation;
+    }
+}
+
 Size MemoryTracker::GetTotalAllocatedSize()
 {
     if (m_TotalAllocatedSize.invalidated)
@@ -48,7 +77,7 @@ Size MemoryTracker::GetTotalAllocatedSize()
         Size totalSize = 0;
         for (const auto& it : m_BaseAllocators)
         {
-            totalSize += it->totalSize;
+            totalSize += it->totalSize.load(std::memory_order_relaxed);
         }
 
         m_TotalAllocatedSize.value = totalSize;
@@ -56,6 +85,300 @@ Size MemoryTracker::GetTotalAllocatedSize()
 
     return m_TotalAllocatedSize.value;
 }
+MemorySnapshot MemoryTracker::TakeSnapshot()
+{
+    MemorySnapshot snapshot;
+    TakeSnapshot(snapshot);
+    return snapshot;
+}
+
+void MemoryTracker::TakeSnapshot(MemorySnapshot& snapshot)
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    snapshot.time = std::chrono::steady_clock::now();
+    snapshot.allocators.resize(m_Allocators.size() + m_BaseAllocators.size());
+
+    Size index = 0;
+    for (const AllocatorVector* allocators : {&m_BaseAllocators, &m_Allocators})
+    {
+        for (const auto& it : *allocators)
+        {
+            AllocatorSnapshot& allocator = snapshot.allocators[index++];
+            allocator.id                 = it->id;
+            allocator.debugName.assign(it->debugName);
+            allocator.totalSize         = it->totalSize.load(std::memory_order_relaxed);
+            allocator.usedSize          = it->usedSize.load(std::memory_order_relaxed);
+            allocator.peakUsage         = it->peakUsage.load(std::memory_order_relaxed);
+            allocator.allocationCount   = it->allocationCount.load(std::memory_order_relaxed);
+            allocator.deallocationCount = it->deallocationCount.load(std::memory_order_relaxed);
+            allocator.isBaseAllocator   = it->isBaseAllocator;
+        }
+    }
+
+    std::sort(snapshot.allocators.begin(), snapshot.allocators.end(), [](const auto& a, const auto& b) { return a.id < b.id; });
+}
+
+void MemoryTracker::StartSampling(const std::chrono::steady_clock::duration interval, const Size capacity)
+{
+    std::lock_guard<std::mutex> guard(m_SamplerMutex);
+
+    m_StatsSampler.reset();
+    m_StatsSampler = std::make_unique<StatsSampler>(interval, capacity);
+}
+
+void MemoryTracker::StopSampling()
+{
+    std::lock_guard<std::mutex> guard(m_SamplerMutex);
+    m_StatsSampler.reset();
+}
+
+bool MemoryTracker::IsSampling()
+{
+    std::lock_guard<std::mutex> guard(m_SamplerMutex);
+    return m_StatsSampler != nullptr;
+}
+
+void MemoryTracker::SampleStats()
+{
+    std::lock_guard<std::mutex> guard(m_SamplerMutex);
+    if (m_StatsSampler != nullptr)
+    {
+        m_StatsSampler->Sample();
+    }
+}
+
+std::vector<MemorySnapshot> MemoryTracker::GetSampleHistory()
+{
+    std::lock_guard<std::mutex> guard(m_SamplerMutex);
+    return m_StatsSampler != nullptr ? m_StatsSampler->GetSamples() : std::vector<MemorySnapshot>{};
+}
+
+std::vector<AllocatorRates> MemoryTracker::GetRates(const Size sampleCount)
+{
+    std::lock_guard<std::mutex> guard(m_SamplerMutex);
+    return m_StatsSampler != nullptr ? m_StatsSampler->GetRates(sampleCount) : std::vector<AllocatorRates>{};
+}
+
+MemorySnapshotDiff MemoryTracker::Diff(const MemorySnapshot& before, const MemorySnapshot& after)
+{
+    MemorySnapshotDiff diff{.duration = after.time - before.time, .allocators = {}};
+
+    const AllocatorSnapshot empty;
+
+    const auto addDiff = [&diff](const AllocatorSnapshot& a, const AllocatorSnapshot& b, const AllocatorDiffStatus status) {
+        const AllocatorSnapshot& allocator = status == AllocatorDiffStatus::Removed ? a : b;
+        diff.allocators.push_back(AllocatorDiff{.id                = allocator.id,
+                                                .debugName         = allocator.debugName,
+                                                .status            = status,
+                                                .totalSize         = static_cast<Int64>(b.totalSize - a.totalSize),
+                                                .usedSize          = static_cast<Int64>(b.usedSize - a.usedSize),
+                                                .peakUsage         = static_cast<Int64>(b.peakUsage - a.peakUsage),
+                                                .allocationCount   = Int64(b.allocationCount) - Int64(a.allocationCount),
+                                                .deallocationCount = Int64(b.deallocationCount) - Int64(a.deallocationCount)});
+    };
+
+    // Both snapshots are sorted by ID, so they are merged like two sorted ranges
+    Size beforeIndex = 0;
+    Size afterIndex  = 0;
+    while (beforeIndex < before.allocators.size() || afterIndex < after.allocators.size())
+    {
+        const bool hasBefore = beforeIndex < before.allocators.size();
+        const bool hasAfter  = afterIndex < after.allocators.size();
+
+        if (hasBefore && hasAfter && before.allocators[beforeIndex].id == after.allocators[afterIndex].id)
+        {
+            addDiff(before.allocators[beforeIndex++], after.allocators[afterIndex++], AllocatorDiffStatus::Changed);
+        }
+        else if (hasBefore && (!hasAfter || before.allocators[beforeIndex].id < after.allocators[afterIndex].id))
+        {
+            addDiff(before.allocators[beforeIndex++], empty, AllocatorDiffStatus::Removed);
+        }
+        else
+        {
+            addDiff(empty, after.allocators[afterIndex++], AllocatorDiffStatus::Added);
+        }
+    }
+
+    return diff;
+}
+
+std::vector<AllocatorTreeNode> MemoryTracker::GetAllocatorTree()
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    AllocatorVector allocators = m_BaseAllocators;
+    allocators.insert(allocators.end(), m_Allocators.begin(), m_Allocators.end());
+    std::sort(allocators.begin(), allocators.end(), [](const auto& a, const auto& b) { return a->id < b->id; });
+
+    std::unordered_map<UInt64, Size> indices;
+    for (Size i = 0; i < allocators.size(); i++)
+    {
+        indices[allocators[i]->id] = i;
+    }
+
+    std::vector<std::vector<Size>> childIndices(allocators.size());
+    std::vector<Size>              rootIndices;
+    for (Size i = 0; i < allocators.size(); i++)
+    {
+        const auto parentIt = indices.find(allocators[i]->parentId);
+        if (allocators[i]->parentRelation != AllocatorRelation::None && parentIt != indices.end())
+        {
+            childIndices[parentIt->second].push_back(i);
+        }
+        else
+        {
+            rootIndices.push_back(i);
+        }
+    }
+
+    const std::function<AllocatorTreeNode(Size)> buildNode = [&](const Size index) {
+        AllocatorTreeNode node{.allocator = allocators[index], .children = {}};
+
+        Size externalTotalSize = 0; // Memory of the subtree that doesn't come from this allocator
+        Size childUsedSize     = 0;
+        Size childBlocksSize   = 0; // Memory this allocator handed to children as blocks
+        for (const Size childIndex : childIndices[index])
+        {
+            AllocatorTreeNode child = buildNode(childIndex);
+
+            if (child.allocator->parentRelation == AllocatorRelation::BaseAllocator)
+            {
+                const Size childTotalSize = child.allocator->totalSize.load(std::memory_order_relaxed);
+                childBlocksSize += childTotalSize;
+                externalTotalSize += child.rolledUpTotalSize - std::min(child.rolledUpTotalSize, childTotalSize);
+            }
+            else
+            {
+                externalTotalSize += child.rolledUpTotalSize;
+            }
+            childUsedSize += child.rolledUpUsedSize;
+
+            node.children.push_back(std::move(child));
+        }
+
+        // Without size tracking the used size of this allocator can be smaller than the blocks of its children
+        const Size usedSize    = node.allocator->usedSize.load(std::memory_order_relaxed);
+        node.rolledUpTotalSize = node.allocator->totalSize.load(std::memory_order_relaxed) + externalTotalSize;
+        node.rolledUpUsedSize  = usedSize - std::min(usedSize, childBlocksSize) + childUsedSize;
+        return node;
+    };
+
+    std::vector<AllocatorTreeNode> roots;
+    roots.reserve(rootIndices.size());
+    for (const Size rootIndex : rootIndices)
+    {
+        roots.push_back(buildNode(rootIndex));
+    }
+    return roots;
+}
+
+void MemoryTracker::Traverse(const std::vector<AllocatorTreeNode>&                     roots,
+                             const std::function<void(const AllocatorTreeNode&, Size)>& visitor)
+{
+    const std::function<void(const AllocatorTreeNode&, Size)> visit = [&](const AllocatorTreeNode& node, const Size depth) {
+        visitor(node, depth);
+        for (const AllocatorTreeNode& child : node.children)
+        {
+            visit(child, depth + 1);
+        }
+    };
+
+    for (const AllocatorTreeNode& root : roots)
+    {
+        visit(root, 0);
+    }
+}
+
+MemoryTracker::ThreadExitGuard::~ThreadExitGuard()
+{
+    RetireThread(m_CurrentThreadCounters);
+    m_CurrentThreadCounters = nullptr;
+}
+
+MemoryTracker::ThreadAllocationCounters* MemoryTracker::RegisterThread()
+{
+    // Only constructed on the first call of a thread, so the counting itself reads a plain thread local pointer
+    static thread_local ThreadExitGuard exitGuard;
+
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    auto counters      = std::make_unique<ThreadAllocationCounters>();
+    counters->threadId = std::this_thread::get_id();
+    m_ThreadCounters.push_back(std::move(counters));
+    return m_ThreadCounters.back().get();
+}
+
+void MemoryTracker::RetireThread(ThreadAllocationCounters* counters)
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    m_ExitedThreadCounts[counters->threadName] += LoadCounts(*counters) - counters->baseline;
+
+    const auto isCounters = [counters](const auto& threadCounters) { return threadCounters.get() == counters; };
+    m_ThreadCounters.erase(std::find_if(m_ThreadCounters.begin(), m_ThreadCounters.end(), isCounters));
+}
+
+MemoryTracker::ThreadCounts MemoryTracker::LoadCounts(const ThreadAllocationCounters& counters)
+{
+    return {.allocatedSize     = counters.allocatedSize.load(std::memory_order_relaxed),
+            .freedSize         = counters.freedSize.load(std::memory_order_relaxed),
+            .allocationCount   = counters.allocationCount.load(std::memory_order_relaxed),
+            .deallocationCount = counters.deallocationCount.load(std::memory_order_relaxed)};
+}
+
+ThreadAllocationStats MemoryTracker::ToStats(const std::thread::id threadId, const std::string& threadName, const ThreadCounts& counts)
+{
+    return {.threadId          = threadId,
+            .threadName        = threadName,
+            .allocatedSize     = counts.allocatedSize,
+            .freedSize         = counts.freedSize,
+            .liveSize          = static_cast<Int64>(counts.allocatedSize - counts.freedSize),
+            .allocationCount   = counts.allocationCount,
+            .deallocationCount = counts.deallocationCount};
+}
+
+void MemoryTracker::SetThreadName(const std::string& threadName)
+{
+    ThreadAllocationCounters& counters = GetThreadCounters();
+
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    counters.threadName = threadName;
+}
+
+std::vector<ThreadAllocationStats> MemoryTracker::GetThreadStats()
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    std::vector<ThreadAllocationStats> threadStats;
+    threadStats.reserve(m_ThreadCounters.size() + m_ExitedThreadCounts.size());
+    for (const auto& counters : m_ThreadCounters)
+    {
+        threadStats.push_back(ToStats(counters->threadId, counters->threadName, LoadCounts(*counters) - counters->baseline));
+    }
+    for (const auto& [threadName, counts] : m_ExitedThreadCounts)
+    {
+        threadStats.push_back(ToStats(std::thread::id(), threadName, counts));
+    }
+
+    std::stable_sort(threadStats.begin(), threadStats.end(),
+                     [](const auto& a, const auto& b) { return a.allocatedSize > b.allocatedSize; });
+    return threadStats;
+}
+
+void MemoryTracker::ResetThreadStats()
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    // Only the owner threads write their counters, so a reset can't be lost to a thread that counts at the same time
+    for (const auto& counters : m_ThreadCounters)
+    {
+        counters->baseline = LoadCounts(*counters);
+    }
+
+    m_ExitedThreadCounts.clear();
+}
+
 void MemoryTracker::Reset()
 {
     std::lock_guard<std::mutex> guard(m_Mutex);
@@ -1,16 +1,55 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "Aliases.hpp"
+#include "MemorySnapshot.hpp"
 
 namespace Memarena
 {
 struct AllocatorData;
+enum class AllocatorRelation : UInt8;
+class StatsSampler;
 
 using AllocatorVector = std::vector<std::shared_ptr<AllocatorData>>;
 
+/**
+ * @brief An allocator with the allocators that get their blocks from it or that it wraps. The rolled-up sizes cover the whole subtree
+ * and count every byte once: the blocks of a child with a `BaseAllocator` relation are already part of the parent's size, so only the
+ * memory the subtree got from outside the tree adds to the total, and the used size counts what the leaves actually hand out
+ */
+struct AllocatorTreeNode
+{
+    std::shared_ptr<AllocatorData> allocator;
+    std::vector<AllocatorTreeNode> children; // Sorted by ID
+    Size                           rolledUpTotalSize = 0;
+    Size                           rolledUpUsedSize  = 0;
+};
+
+/**
+ * @brief The bytes one thread allocated and freed across all allocators with the thread tracking policy. The live size is what the
+ * thread allocated minus what it freed, so it is negative for a thread that mostly frees memory that other threads allocated. The
+ * threads that exited are summed up per thread name, those entries have a default `threadId`
+ */
+struct ThreadAllocationStats
+{
+    std::thread::id threadId;
+    std::string     threadName; // Empty unless the thread called `MemoryTracker::SetThreadName`
+    UInt64          allocatedSize     = 0;
+    UInt64          freedSize         = 0;
+    Int64           liveSize          = 0;
+    UInt64          allocationCount   = 0;
+    UInt64          deallocationCount = 0;
+};
+
 template <typename T>
 struct Cache
 {
@@ -28,18 +67,170 @@ class MemoryTracker
 
     static void InvalidateTotalAllocatedSizeCache();
 
+    /**
+     * @brief Records `parent` as the parent of `child` in the allocator tree. An allocator keeps its first parent, so an arena whose
+     * blocks come from another allocator stays under it even when a FallbackAllocator wraps it later
+     */
+    static void SetParent(const std::shared_ptr<AllocatorData>& child, const std::shared_ptr<AllocatorData>& parent,
+                          AllocatorRelation relation);
+
     [[nodiscard]] static Size                   GetTotalAllocatedSize();
     [[nodiscard]] static const AllocatorVector& GetAllocators();
     [[nodiscard]] static const AllocatorVector& GetBaseAllocators();
 
+    /**
+     * @brief Copies the stats of all registered allocators. The set of allocators is consistent, the counters of an allocator that is
+     * used by another thread at the same time are read one by one, so they may come from slightly different points in time
+     */
+    [[nodiscard]] static MemorySnapshot     TakeSnapshot();
+    [[nodiscard]] static MemorySnapshotDiff Diff(const MemorySnapshot& before, const MemorySnapshot& after);
+
+    // Overwrites `snapshot`, reusing the memory of its allocator list and names
+    static void TakeSnapshot(MemorySnapshot& snapshot);
+
+    /**
+     * @brief Starts a background thread that takes a snapshot every `interval` into a ring of the last `capacity` snapshots, replacing
+     * the ring of a previous call. Like `TakeSnapshot`, the sampler reads the atomic counters of the allocators without their locks,
+     * so it never blocks an allocation, and only takes the lock of the tracker
+     */
+    static void StartSampling(std::chrono::steady_clock::duration interval, Size capacity = DefaultSampleCapacity);
+    static void StopSampling();
+    [[nodiscard]] static bool IsSampling();
+
+    // Takes a sample right away, e.g. before reading the history. Does nothing if the sampler isn't running
+    static void SampleStats();
+
+    // The samples in the ring, oldest first. Empty if the sampler isn't running
+    [[nodiscard]] static std::vector<MemorySnapshot> GetSampleHistory();
+
+    /**
+     * @brief The rates of every allocator between the newest sample and the one `sampleCount` samples before it, e.g. over the last
+     * minute with a `sampleCount` of 60 and an interval of a second. Uses the oldest sample if there are fewer samples. Empty if there
+     * are less than two samples
+     */
+    [[nodiscard]] static std::vector<AllocatorRates> GetRates(Size sampleCount = 1);
+
+    static constexpr Size DefaultSampleCapacity = 120;
+
+    /**
+     * @brief Builds the tree of all registered allocators. The sum of the rolled-up total sizes of the roots is the memory of all
+     * tracked allocators. An allocator whose parent is no longer registered becomes a root
+     */
+    [[nodiscard]] static std::vector<AllocatorTreeNode> GetAllocatorTree();
+
+    // Visits the nodes depth first, parents before their children. The roots have a depth of 0
+    static void Traverse(const std::vector<AllocatorTreeNode>& roots, const std::function<void(const AllocatorTreeNode&, Size)>& visitor);
+
+    /**
+     * @brief Counts an allocation or deallocation of the calling thread. The counters of a thread are registered on its first call and
+     * only written by that thread, so this doesn't take a lock after the first call. A release counts its bytes as freed without
+     * counting deallocations
+     */
+    static void AddThreadAllocation(const Size size)
+    {
+        ThreadAllocationCounters& counters = GetThreadCounters();
+        Increment(counters.allocatedSize, size);
+        Increment(counters.allocationCount, 1);
+    }
+    static void AddThreadDeallocation(const Size size, const UInt64 deallocationCount = 1)
+    {
+        ThreadAllocationCounters& counters = GetThreadCounters();
+        Increment(counters.freedSize, size);
+        Increment(counters.deallocationCount, deallocationCount);
+    }
+
+    // Names the calling thread in the thread stats, e.g. after the worker pool it belongs to
+    static void SetThreadName(const std::string& threadName);
+
+    // The stats of every running thread that allocated with thread tracking or was named and one entry per name for the threads that
+    // have exited, sorted by the allocated size
+    [[nodiscard]] static std::vector<ThreadAllocationStats> GetThreadStats();
+
+    // Zeros the counters of all threads and drops the exited threads, the running threads and their names stay registered
+    static void ResetThreadStats();
+
     static void Reset();
     static void ResetAllocators();
     static void ResetBaseAllocators();
 
   private:
+    struct ThreadCounts
+    {
+        UInt64 allocatedSize     = 0;
+        UInt64 freedSize         = 0;
+        UInt64 allocationCount   = 0;
+        UInt64 deallocationCount = 0;
+
+        ThreadCounts& operator+=(const ThreadCounts& other)
+        {
+            allocatedSize += other.allocatedSize;
+            freedSize += other.freedSize;
+            allocationCount += other.allocationCount;
+            deallocationCount += other.deallocationCount;
+            return *this;
+        }
+
+        [[nodiscard]] ThreadCounts operator-(const ThreadCounts& other) const
+        {
+            return {.allocatedSize     = allocatedSize - other.allocatedSize,
+                    .freedSize         = freedSize - other.freedSize,
+                    .allocationCount   = allocationCount - other.allocationCount,
+                    .deallocationCount = deallocationCount - other.deallocationCount};
+        }
+    };
+
+    // Aligned to a cache line, so threads counting at the same time don't write to the same line
+    struct alignas(64) ThreadAllocationCounters
+    {
+        std::atomic<UInt64> allocatedSize     = 0;
+        std::atomic<UInt64> freedSize         = 0;
+        std::atomic<UInt64> allocationCount   = 0;
+        std::atomic<UInt64> deallocationCount = 0;
+        std::thread::id     threadId;
+        std::string         threadName; // Guarded by m_Mutex
+        ThreadCounts        baseline;   // The counts at the last reset, guarded by m_Mutex
+    };
+
+    // A single thread writes the counters, so a relaxed load and store is enough and cheaper than a read-modify-write. A reset doesn't
+    // write them either, it moves the baseline the stats are reported against
+    static void Increment(std::atomic<UInt64>& counter, const UInt64 value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    static ThreadAllocationCounters& GetThreadCounters()
+    {
+        if (m_CurrentThreadCounters == nullptr)
+        {
+            m_CurrentThreadCounters = RegisterThread();
+        }
+        return *m_CurrentThreadCounters;
+    }
+
+    // Retires the counters of its thread when the thread exits
+    struct ThreadExitGuard
+    {
+        ~ThreadExitGuard();
+    };
+
+    static ThreadAllocationCounters* RegisterThread();
+    static void                      RetireThread(ThreadAllocationCounters* counters);
+
+    static ThreadCounts          LoadCounts(const ThreadAllocationCounters& counters);
+    static ThreadAllocationStats ToStats(std::thread::id threadId, const std::string& threadName, const ThreadCounts& counts);
+
     static std::mutex      m_Mutex;
     static AllocatorVector m_Allocators;
     static AllocatorVector m_BaseAllocators;
     static Cache<Size>     m_TotalAllocatedSize;
+    static UInt64          m_NextAllocatorId;
+
+    static std::mutex                    m_SamplerMutex; // Guards m_StatsSampler, the sampler itself only takes m_Mutex
+    static std::unique_ptr<StatsSampler> m_StatsSampler;
+
+    // The counters of the running threads. A thread folds its counts into the ones of its name and frees its counters when it exits
+    static std::vector<std::unique_ptr<ThreadAllocationCounters>> m_ThreadCounters;
+    static std::map<std::string, ThreadCounts>                    m_ExitedThreadCounts;
+    static inline thread_local ThreadAllocationCounters*         m_CurrentThreadCounters = nullptr;
 };
 } // namespace Memarena
\ No newline at end of file
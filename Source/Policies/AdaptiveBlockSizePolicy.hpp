@@ -0,0 +1,155 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <limits>
+
+#include "Source/TypeAliases.hpp"
+
+namespace Memarena
+{
+
+/**
+ * @brief Bounds for the size of the blocks of an allocator with an adaptive block size. The unit is the unit of the block size of
+ * the allocator, i.e. bytes for the LinearAllocator and objects for the PoolAllocator. A bound of 0 is derived from the initial block
+ * size. A maximum below the minimum is raised to the minimum
+ */
+struct BlockSizeBounds
+{
+    Size minSize = 0;
+    Size maxSize = 0;
+};
+
+/**
+ * @tparam Clock Measures the allocation rate, replaceable so that the growth can be tested without depending on the timing
+ */
+template <bool IsAdaptive, typename Clock = std::chrono::steady_clock>
+class AdaptiveBlockSizePolicy
+{
+  private:
+    using TimePoint = typename Clock::time_point;
+    using Duration  = typename Clock::duration;
+
+    // A new block should last at least this long at the observed allocation rate before the allocator has to grow again
+    static constexpr Duration TargetBlockLifetime = std::chrono::milliseconds(10);
+
+    // Default bounds relative to the initial block size
+    static constexpr Size DefaultShrinkFactor = 8;
+    static constexpr Size DefaultGrowthFactor = 64;
+
+  public:
+    // `maxBlockSizeLimit` caps both bounds, e.g. at the largest block the offsets of the allocator can address
+    AdaptiveBlockSizePolicy(const Size initialBlockSize, const BlockSizeBounds& bounds,
+                            const Size maxBlockSizeLimit = std::numeric_limits<Size>::max())
+        : m_MinBlockSize(
+              std::min(bounds.minSize != 0 ? bounds.minSize : std::max<Size>(initialBlockSize / DefaultShrinkFactor, 1), maxBlockSizeLimit)),
+          m_MaxBlockSize(std::max(
+              std::min(bounds.maxSize != 0 ? bounds.maxSize : initialBlockSize * DefaultGrowthFactor, maxBlockSizeLimit), m_MinBlockSize)),
+          m_NextBlockSize(ClampToBounds(initialBlockSize)), m_LastGrowthTime(Clock::now())
+    {
+    }
+
+    void RecordAllocation(const Size size)
+    {
+        m_AllocatedSinceGrowth += size;
+        m_LiveSize += size;
+        m_PeakLiveSize = std::max(m_PeakLiveSize, m_LiveSize);
+    }
+
+    void RecordDeallocation(const Size size) { m_LiveSize -= size; }
+
+    [[nodiscard]] Size GetMinBlockSize() const { return m_MinBlockSize; }
+    [[nodiscard]] Size GetMaxBlockSize() const { return m_MaxBlockSize; }
+    [[nodiscard]] Size GetInitialBlockSize() const { return m_NextBlockSize; }
+
+    /**
+     * @brief Returns the size of the block to allocate because the existing blocks are exhausted. The size is chosen so that the block
+     * lasts about `TargetBlockLifetime` at the allocation rate observed since the last growth, changing at most by a factor of two per
+     * growth so that a single burst or pause does not swing it
+     */
+    [[nodiscard]] Size GetGrowthBlockSize()
+    {
+        const TimePoint now     = Clock::now();
+        const Duration  elapsed = now - m_LastGrowthTime;
+
+        Size desiredSize = m_NextBlockSize * 2;
+        if (elapsed > Duration::zero())
+        {
+            const double allocationRate = static_cast<double>(m_AllocatedSinceGrowth) / static_cast<double>(elapsed.count());
+            desiredSize                 = static_cast<Size>(allocationRate * static_cast<double>(TargetBlockLifetime.count()));
+        }
+
+        desiredSize     = std::clamp(desiredSize, std::max<Size>(m_NextBlockSize / 2, 1), m_NextBlockSize * 2);
+        m_NextBlockSize = ClampToBounds(std::bit_ceil(desiredSize));
+
+        m_LastGrowthTime       = now;
+        m_AllocatedSinceGrowth = 0;
+
+        return m_NextBlockSize;
+    }
+
+    /**
+     * @brief Returns the size of the block to keep when the allocator is released: the smallest size that would have served the peak
+     * usage of the last cycle from a single block. Resets the statistics for the next cycle
+     */
+    [[nodiscard]] Size GetReleaseBlockSize()
+    {
+        m_NextBlockSize = ClampToBounds(std::bit_ceil(m_PeakLiveSize));
+
+        m_LastGrowthTime       = Clock::now();
+        m_AllocatedSinceGrowth = 0;
+        m_LiveSize             = 0;
+        m_PeakLiveSize         = 0;
+
+        return m_NextBlockSize;
+    }
+
+    /**
+     * @brief Whether a block of `blockSize` should be replaced by one of `releaseBlockSize` on release. Blocks that are too small are
+     * always replaced, oversized ones only when they are four times too large, so that the size does not flip between two neighbouring
+     * powers of two every cycle
+     */
+    [[nodiscard]] static bool ShouldReplaceBlock(const Size blockSize, const Size releaseBlockSize)
+    {
+        return blockSize < releaseBlockSize || blockSize / 4 >= releaseBlockSize;
+    }
+
+  private:
+    [[nodiscard]] Size ClampToBounds(const Size blockSize) const { return std::clamp(blockSize, m_MinBlockSize, m_MaxBlockSize); }
+
+    Size m_MinBlockSize;
+    Size m_MaxBlockSize;
+    Size m_NextBlockSize;
+
+    TimePoint m_LastGrowthTime;
+    Size      m_AllocatedSinceGrowth = 0;
+    Size      m_LiveSize             = 0;
+    Size      m_PeakLiveSize         = 0;
+};
+
+template <typename Clock>
+class AdaptiveBlockSizePolicy<false, Clock>
+{
+  public:
+    AdaptiveBlockSizePolicy(const Size initialBlockSize, const BlockSizeBounds& /*bounds*/,
+                            const Size maxBlockSizeLimit = std::numeric_limits<Size>::max())
+        : m_BlockSize(std::min(initialBlockSize, maxBlockSizeLimit))
+    {
+    }
+
+    void RecordAllocation(const Size /*size*/) {}
+    void RecordDeallocation(const Size /*size*/) {}
+
+    [[nodiscard]] Size GetMinBlockSize() const { return m_BlockSize; }
+    [[nodiscard]] Size GetMaxBlockSize() const { return m_BlockSize; }
+    [[nodiscard]] Size GetInitialBlockSize() const { return m_BlockSize; }
+    [[nodiscard]] Size GetGrowthBlockSize() const { return m_BlockSize; }
+    [[nodiscard]] Size GetReleaseBlockSize() const { return m_BlockSize; }
+
+    [[nodiscard]] static bool ShouldReplaceBlock(const Size /*blockSize*/, const Size /*releaseBlockSize*/) { return false; }
+
+  private:
+    Size m_BlockSize;
+};
+} // namespace Memarena
@@ -26,7 +26,10 @@ struct IsPolicy
         SizeTracking  = Bit(28),             /* Track the amount of space used by this allocator */                    \
         Multithreaded = Bit(29)              /* Make allocations thread-safe. This will also make them blocking */
 
-#define ALLOCATOR_POLICIES BASE_ALLOCATOR_POLICIES
+// The LocalAllocator and the VirtualAllocator only take the base policies, since they don't support the rest
+#define ALLOCATOR_POLICIES                                                                                                       \
+    BASE_ALLOCATOR_POLICIES, ThreadTracking = Bit(25), /* Count the bytes allocated and freed per thread in the MemoryTracker */ \
+        HeapProfiling = Bit(26)                        /* Report allocations to the sampling HeapProfiler */
 
 template <typename Policy, typename Value>
 constexpr bool PolicyContains(Policy policy, Value value)
@@ -62,6 +65,9 @@ enum class StackAllocatorPolicy : UInt32
     StackCheck           = Bit(3), // Check is deallocations are performed in LIFO order
     Resizable            = Bit(4), // Allow the allocator to grow when memory is exhausted
     DoubleFreePrevention = Bit(5), // Set the ptr to null on free to prevent double frees
+    BumpDown             = Bit(6), // Allocate from the end of the memory towards the start. Can't be combined with BoundsCheck
+    CompactOffsets       = Bit(7), // Use 16-bit offsets, which halves the headers but limits the allocator to less than 64 KiB
+    WideOffsets          = Bit(8), // Use 64-bit offsets, which allows more than 4 GiB but doubles the headers
 
     Default = NullDeallocCheck | OwnershipCheck | StackCheck | SizeTracking,
     Release = Empty,
@@ -79,6 +85,9 @@ enum class PoolAllocatorPolicy : UInt32
     DoubleFreePrevention = Bit(3), // Set the ptr to null on free to prevent double frees
     Growable             = Bit(4), // Allow the allocator to grow when memory is exhausted
     AllocationSizeCheck  = Bit(5), // Check if the size of object being allocated or deallocated is equal to objectSize
+    AddressOrdered       = Bit(6), // Sort the free list by address before array allocations if it was modified since the last sort
+    BlockLocalFreeLists  = Bit(7), // Keep a free list per block and allocate from the fullest block that is not full
+    AdaptiveBlockSize    = Bit(8), // Size new blocks from the observed demand within bounds. Requires Growable
 
     Default = NullDeallocCheck | OwnershipCheck | SizeTracking | DoubleFreePrevention | AllocationSizeCheck,
     Release = Empty,
@@ -91,8 +100,11 @@ enum class LinearAllocatorPolicy : UInt32
 {
     ALLOCATOR_POLICIES,
 
-    Growable  = Bit(0), // Allow the allocator to grow when memory is exhausted
-    SizeCheck = Bit(1), // Check if the allocator has sufficient space when allocating //
+    Growable          = Bit(0), // Allow the allocator to grow when memory is exhausted
+    SizeCheck         = Bit(1), // Check if the allocator has sufficient space when allocating //
+    AdaptiveBlockSize = Bit(2), // Size new blocks from the observed demand within bounds. Requires Growable
+    BumpDown          = Bit(3), // Allocate from the end of each block towards the start, which needs no padding computation
+    WideOffsets       = Bit(4), // Use a 64-bit offset, which allows blocks of more than 4 GiB
 
     Default = SizeTracking | SizeCheck,
     Release = Empty,
@@ -103,11 +115,12 @@ MARK_AS_POLICY(LinearAllocatorPolicy);
 
 enum class MallocatorPolicy : UInt32
 {
-    BASE_ALLOCATOR_POLICIES,
+    ALLOCATOR_POLICIES,
 
     NullAllocCheck       = Bit(0), // Check if malloc returns null
     NullDeallocCheck     = Bit(1), // Check if the pointer is null when deallocating
     DoubleFreePrevention = Bit(2), // Set the ptr to null on free to prevent double frees
+    Headerless           = Bit(3), // Don't prepend a header to raw allocations, sizes come from the caller or malloc_usable_size
 
     Default = NullDeallocCheck | NullAllocCheck | SizeTracking | DoubleFreePrevention,
     Release = Empty,
@@ -146,6 +159,35 @@ enum class VirtualAllocatorPolicy : UInt32
 
 MARK_AS_POLICY(VirtualAllocatorPolicy);
 
+enum class IOBufferPoolPolicy : UInt32
+{
+    Empty = 0,
+
+    Prefault      = Bit(0), // Fault in all buffer pages up front so the first I/O into a buffer doesn't page fault
+    HugePages     = Bit(1), // Ask the OS to back the buffers with transparent huge pages
+    UsageTracking = Bit(2), // Count the acquired buffers. This adds a shared atomic counter to every acquire and release
+
+    Default = Prefault | UsageTracking,
+    Release = Prefault,
+    Debug   = Prefault | UsageTracking,
+};
+
+MARK_AS_POLICY(IOBufferPoolPolicy);
+
+enum class VirtualVectorPolicy : UInt32
+{
+    Empty = 0,
+
+    HugePages   = Bit(0), // Ask the OS to back the committed pages with transparent huge pages
+    BoundsCheck = Bit(1), // Check the indices of element accesses and pops from an empty vector
+
+    Default = BoundsCheck,
+    Release = Empty,
+    Debug   = BoundsCheck,
+};
+
+MARK_AS_POLICY(VirtualVectorPolicy);
+
 template <typename T>
 concept AllocatorPolicy = requires(T a)
 {
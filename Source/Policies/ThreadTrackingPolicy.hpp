@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Source/MemoryTracker.hpp"
+#include "Source/TypeAliases.hpp"
+
+namespace Memarena
+{
+
+/**
+ * @brief Reports the bytes an allocator hands out and takes back to the per thread counters of the MemoryTracker, on the thread that
+ * calls the allocator. The policy keeps the live size of the allocator, so a release or the destruction of the allocator counts what is
+ * still allocated as freed by the thread that releases it
+ */
+template <bool IsEnabled>
+class ThreadTrackingPolicy
+{
+  public:
+    void RecordAllocation(const Size size)
+    {
+        m_LiveSize += size;
+        MemoryTracker::AddThreadAllocation(size);
+    }
+
+    void RecordDeallocation(const Size size)
+    {
+        m_LiveSize -= size;
+        MemoryTracker::AddThreadDeallocation(size);
+    }
+
+    void RecordRelease()
+    {
+        if (m_LiveSize > 0)
+        {
+            MemoryTracker::AddThreadDeallocation(m_LiveSize, 0);
+            m_LiveSize = 0;
+        }
+    }
+
+  private:
+    Size m_LiveSize = 0;
+};
+
+template <>
+class ThreadTrackingPolicy<false>
+{
+  public:
+    void RecordAllocation(const Size /*size*/) {}
+    void RecordDeallocation(const Size /*size*/) {}
+    void RecordRelease() {}
+};
+} // namespace Memarena
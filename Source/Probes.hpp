@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * USDT probes of the `memarena` provider, for tracers like bpftrace, perf or SystemTap. A probe compiles to a single nop and a note in
+ * the binary, so the allocators keep them in release builds. Tracers find them without any tracking policy, e.g.
+ *
+ *     bpftrace -e 'usdt:./Server:memarena:allocate { @sizes = hist(arg2); }'
+ *
+ * Probes and their arguments:
+ *   allocate(allocator, ptr, size)
+ *   deallocate(allocator, ptr)
+ *   block_grow(allocator, blockPtr, blockSize)
+ *   release(allocator)
+ *   assert_failure(file, line)
+ *
+ * Without <sys/sdt.h>, e.g. on Windows, or with MEMARENA_DISABLE_PROBES defined, the probes compile to nothing and their arguments are
+ * not evaluated.
+ */
+
+#if !defined(MEMARENA_DISABLE_PROBES) && defined(__has_include)
+    #if __has_include(<sys/sdt.h>)
+        #include <sys/sdt.h>
+        #define MEMARENA_HAS_PROBES
+    #endif
+#endif
+
+#ifdef MEMARENA_HAS_PROBES
+    #define MEMARENA_PROBE(name, ...) STAP_PROBEV(memarena, name, __VA_ARGS__)
+#else
+    #define MEMARENA_PROBE(name, ...) ((void)0)
+#endif
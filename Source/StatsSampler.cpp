@@ -0,0 +1,107 @@
+#include "PCH.hpp"
+
+#include "StatsSampler.hpp"
+
+#include "MemoryTracker.hpp"
+
+namespace Memarena
+{
+
+StatsSampler::StatsSampler(const std::chrono::steady_clock::duration interval, const Size capacity)
+    : m_Interval(interval), m_Samples(std::max<Size>(capacity, 2))
+{
+    m_Thread = std::thread(&StatsSampler::Run, this);
+}
+
+StatsSampler::~StatsSampler()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_StopMutex);
+        m_IsStopping = true;
+    }
+    m_StopCondition.notify_one();
+    m_Thread.join();
+}
+
+void StatsSampler::Run()
+{
+    std::unique_lock<std::mutex> lock(m_StopMutex);
+    while (!m_StopCondition.wait_for(lock, m_Interval, [this] { return m_IsStopping; }))
+    {
+        lock.unlock();
+        Sample();
+        lock.lock();
+    }
+}
+
+void StatsSampler::Sample()
+{
+    std::lock_guard<std::mutex> scratchGuard(m_ScratchMutex);
+
+    // The stats are copied without holding the ring, so readers only wait for the swap
+    MemoryTracker::TakeSnapshot(m_Scratch);
+
+    std::lock_guard<std::mutex> guard(m_Mutex);
+    std::swap(m_Samples[m_NextIndex], m_Scratch);
+    m_NextIndex   = (m_NextIndex + 1) % m_Samples.size();
+    m_SampleCount = std::min(m_SampleCount + 1, m_Samples.size());
+}
+
+const MemorySnapshot& StatsSampler::GetSample(const Size age) const
+{
+    return m_Samples[(m_NextIndex + m_Samples.size() - 1 - age) % m_Samples.size()];
+}
+
+std::vector<MemorySnapshot> StatsSampler::GetSamples() const
+{
+    std::lock_guard<std::mutex> guard(m_Mutex);
+
+    std::vector<MemorySnapshot> samples;
+    samples.reserve(m_SampleCount);
+    for (Size age = m_SampleCount; age-- > 0;)
+    {
+        samples.push_back(GetSample(age));
+    }
+    return samples;
+}
+
+std::vector<AllocatorRates> StatsSampler::GetRates(const Size sampleCount) const
+{
+    MemorySnapshotDiff diff;
+    {
+        std::lock_guard<std::mutex> guard(m_Mutex);
+
+        if (m_SampleCount < 2 || sampleCount == 0)
+        {
+            return {};
+        }
+
+        diff = MemoryTracker::Diff(GetSample(std::min(sampleCount, m_SampleCount - 1)), GetSample(0));
+    }
+
+    const double seconds = std::chrono::duration<double>(diff.duration).count();
+    if (seconds <= 0.0)
+    {
+        return {};
+    }
+
+    std::vector<AllocatorRates> rates;
+    rates.reserve(diff.allocators.size());
+    for (const AllocatorDiff& allocator : diff.allocators)
+    {
+        // An allocator that was destroyed in the meantime has no current rate
+        if (allocator.status == AllocatorDiffStatus::Removed)
+        {
+            continue;
+        }
+
+        rates.push_back(AllocatorRates{.id                     = allocator.id,
+                                       .debugName              = allocator.debugName,
+                                       .allocationsPerSecond   = static_cast<double>(allocator.allocationCount) / seconds,
+                                       .deallocationsPerSecond = static_cast<double>(allocator.deallocationCount) / seconds,
+                                       .usedBytesPerSecond     = static_cast<double>(allocator.usedSize) / seconds,
+                                       .totalBytesPerSecond    = static_cast<double>(allocator.totalSize) / seconds});
+    }
+    return rates;
+}
+} // namespace Memarena
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Aliases.hpp"
+#include "MemorySnapshot.hpp"
+
+namespace Memarena
+{
+
+/**
+ * @brief Copies the stats of all registered allocators into a ring of the last `capacity` samples, from a background thread every
+ * `interval`. The copies reuse the memory of the samples they overwrite, so a sampler doesn't allocate once the ring is full and the set
+ * of allocators is stable. See `MemoryTracker::StartSampling`
+ */
+class StatsSampler
+{
+  public:
+    StatsSampler(std::chrono::steady_clock::duration interval, Size capacity);
+    ~StatsSampler();
+
+    StatsSampler(const StatsSampler&)            = delete;
+    StatsSampler& operator=(const StatsSampler&) = delete;
+
+    // Takes a sample right away, in addition to the ones of the background thread
+    void Sample();
+
+    // The samples in the ring, oldest first
+    [[nodiscard]] std::vector<MemorySnapshot> GetSamples() const;
+
+    // The rates between the newest sample and the one `sampleCount` samples before it, or the oldest one if there are fewer
+    [[nodiscard]] std::vector<AllocatorRates> GetRates(Size sampleCount) const;
+
+    [[nodiscard]] std::chrono::steady_clock::duration GetInterval() const { return m_Interval; }
+    [[nodiscard]] Size                                GetCapacity() const { return m_Samples.size(); }
+
+  private:
+    void Run();
+
+    [[nodiscard]] const MemorySnapshot& GetSample(Size age) const; // 0 is the newest sample
+
+    std::chrono::steady_clock::duration m_Interval;
+
+    mutable std::mutex          m_Mutex; // Guards the ring, never held while the stats are copied
+    std::vector<MemorySnapshot> m_Samples;
+    Size                        m_NextIndex   = 0;
+    Size                        m_SampleCount = 0;
+
+    std::mutex     m_ScratchMutex; // Serializes the copies into the scratch sample
+    MemorySnapshot m_Scratch;
+
+    std::mutex              m_StopMutex;
+    std::condition_variable m_StopCondition;
+    bool                    m_IsStopping = false;
+    std::thread             m_Thread;
+};
+} // namespace Memarena
@@ -17,6 +17,8 @@ UIntPtr CalculateAlignedAddress(const UIntPtr baseAddress, const Alignment& alig
     return (baseAddress + (alignment - 1)) & ~(alignment - 1);
 }
 
+UIntPtr CalculateAlignedDownAddress(const UIntPtr baseAddress, const Alignment& alignment) { return baseAddress & ~(alignment - 1); }
+
 Padding CalculateShortestAlignedPadding(const UIntPtr baseAddress, const Alignment& alignment)
 {
     return CalculateAlignedAddress(baseAddress, alignment) - baseAddress;
@@ -22,6 +22,7 @@ class Alignment
 };
 
 UIntPtr CalculateAlignedAddress(UIntPtr baseAddress, const Alignment& alignment);
+UIntPtr CalculateAlignedDownAddress(UIntPtr baseAddress, const Alignment& alignment);
 Padding CalculateShortestAlignedPadding(UIntPtr baseAddress, const Alignment& alignment);
 Padding CalculateAlignedPaddingWithHeader(UIntPtr baseAddress, const Alignment& alignment, Size headerSize);
 Padding ExtendPaddingForHeader(Padding padding, const Alignment& alignment, Size headerSize);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+
+#if defined(_WIN32)
+    #include <malloc.h>
+#elif defined(__APPLE__)
+    #include <malloc/malloc.h>
+#else
+    #include <malloc.h>
+#endif
+
+#include "Source/TypeAliases.hpp"
+
+namespace Memarena::Internal
+{
+/**
+ * @brief Returns the usable size of an allocation made with `MallocAligned`, which can be larger than the requested size
+ */
+inline Size GetMallocSize(void* ptr)
+{
+#if defined(_WIN32)
+    // Over-aligned allocations report the difference to the default alignment on top, which still covers the requested size
+    return _aligned_msize(ptr, alignof(std::max_align_t), 0);
+#elif defined(__APPLE__)
+    return malloc_size(ptr);
+#else
+    return malloc_usable_size(ptr);
+#endif
+}
+
+/**
+ * @brief Allocates `size` bytes aligned to `alignment` that have to be released with `FreeAligned`. Alignments up to the alignment of
+ * `std::max_align_t` are already guaranteed by `malloc`
+ */
+inline void* MallocAligned(const Size size, const Size alignment)
+{
+#if defined(_WIN32)
+    // Memory from `_aligned_malloc` can't be released with `free`, so all allocations go through it to be freed the same way
+    return _aligned_malloc(size, std::max<Size>(alignment, alignof(std::max_align_t)));
+#else
+    if (alignment <= alignof(std::max_align_t))
+    {
+        return malloc(size);
+    }
+
+    void* ptr = nullptr;
+    return posix_memalign(&ptr, alignment, size) == 0 ? ptr : nullptr;
+#endif
+}
+
+inline void FreeAligned(void* ptr)
+{
+#if defined(_WIN32)
+    _aligned_free(ptr);
+#else
+    free(ptr);
+#endif
+}
+} // namespace Memarena::Internal
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string_view>
+
+#include "Source/TypeAliases.hpp"
+
+namespace Memarena::Internal
+{
+/**
+ * @brief Returns the name of `T` as spelled by the compiler, extracted from the signature of this function
+ */
+template <typename T>
+constexpr std::string_view GetTypeName()
+{
+#if defined(_MSC_VER)
+    constexpr std::string_view signature = __FUNCSIG__;
+    const Size                 start     = signature.find("GetTypeName<") + std::string_view("GetTypeName<").size();
+    const Size                 end       = signature.rfind(">(void)");
+#else
+    // GCC ends the name with ';' if there are more template arguments and with ']', Clang always with ']'
+    constexpr std::string_view signature = __PRETTY_FUNCTION__;
+    const Size                 start     = signature.find("T = ") + std::string_view("T = ").size();
+    const Size                 end       = signature.find_first_of(";]", start);
+#endif
+
+    return signature.substr(start, end - start);
+}
+} // namespace Memarena::Internal
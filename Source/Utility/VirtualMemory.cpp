@@ -1,16 +1,90 @@
+#include "PCH.hpp"
 
-// #include <bit>
-// #include <memoryapi.h>
-// #include <minwindef.h>
+#include "VirtualMemory.hpp"
 
-// #include "VirtualMemory.hpp"
+#if defined(_WIN32)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
 
-// namespace Memarena
-// {
-// // TODO: Write asserts
+namespace Memarena
+{
+#if defined(_WIN32)
 
-// NO_DISCARD void* ReserveVirtualMemory(Size size) { return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS); }
-// void CommitVirtualMemory(UIntPtr address, Size size) { VirtualAlloc(std::bit_cast<void*>(address), size, MEM_COMMIT, PAGE_READWRITE); }
-// void FreeVirtualMemory(UIntPtr address, Size size) { VirtualFree(std::bit_cast<void*>(address), size, MEM_RELEASE); }
+NO_DISCARD void* ReserveVirtualMemory(Size size) { return VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS); }
 
-// } // namespace Memarena
+bool CommitVirtualMemory(void* address, Size size) { return VirtualAlloc(address, size, MEM_COMMIT, PAGE_READWRITE) != nullptr; }
+
+void DecommitVirtualMemory(void* address, Size size) { VirtualFree(address, size, MEM_DECOMMIT); }
+
+void FreeVirtualMemory(void* address, Size /*size*/) { VirtualFree(address, 0, MEM_RELEASE); }
+
+bool AdviseHugePages(void* /*address*/, Size /*size*/) { return false; }
+
+Size GetPageSize()
+{
+    static const Size pageSize = []() {
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        return static_cast<Size>(systemInfo.dwPageSize);
+    }();
+    return pageSize;
+}
+
+#else
+
+NO_DISCARD void* ReserveVirtualMemory(Size size)
+{
+    void* address = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return address == MAP_FAILED ? nullptr : address;
+}
+
+bool CommitVirtualMemory(void* address, Size size) { return mprotect(address, size, PROT_READ | PROT_WRITE) == 0; }
+
+void DecommitVirtualMemory(void* address, Size size)
+{
+    // Dropping the pages first returns the physical memory, the protection makes accidental use of decommitted memory fault
+    madvise(address, size, MADV_DONTNEED);
+    mprotect(address, size, PROT_NONE);
+}
+
+void FreeVirtualMemory(void* address, Size size) { munmap(address, size); }
+
+bool AdviseHugePages(void* address, Size size)
+{
+    #if defined(MADV_HUGEPAGE)
+    return madvise(address, size, MADV_HUGEPAGE) == 0;
+    #else
+    return false;
+    #endif
+}
+
+Size GetPageSize()
+{
+    static const Size pageSize = static_cast<Size>(sysconf(_SC_PAGESIZE));
+    return pageSize;
+}
+
+#endif
+
+void PrefaultVirtualMemory(void* address, Size size)
+{
+#if defined(MADV_POPULATE_WRITE)
+    if (madvise(address, size, MADV_POPULATE_WRITE) == 0)
+    {
+        return;
+    }
+#endif
+
+    // Writing one byte per page faults every page in, the volatile pointer keeps the compiler from removing the stores
+    volatile Byte* bytes    = static_cast<Byte*>(address);
+    const Size     pageSize = GetPageSize();
+    for (Size offset = 0; offset < size; offset += pageSize)
+    {
+        bytes[offset] = 0;
+    }
+}
+} // namespace Memarena
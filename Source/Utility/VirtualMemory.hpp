@@ -1,12 +1,27 @@
+#pragma once
 
-// #pragma once
+#include "Source/Aliases.hpp"
+#include "Source/Macros.hpp"
 
-// #include "Source/Aliases.hpp"
-// #include "Source/Macros.hpp"
+namespace Memarena
+{
+/**
+ * @brief Reserves address space without backing it with memory. The pages have to be committed before they are used
+ */
+NO_DISCARD void* ReserveVirtualMemory(Size size);
+bool             CommitVirtualMemory(void* address, Size size);
+void             DecommitVirtualMemory(void* address, Size size);
+void             FreeVirtualMemory(void* address, Size size);
 
-// namespace Memarena
-// {
-// NO_DISCARD void* ReserveVirtualMemory(Size size);
-// void             CommitVirtualMemory(UIntPtr address, Size size);
-// void             FreeVirtualMemory(UIntPtr address, Size size);
-// } // namespace Memarena
\ No newline at end of file
+/**
+ * @brief Touches every page so that the first access to the memory doesn't page fault
+ */
+void PrefaultVirtualMemory(void* address, Size size);
+
+/**
+ * @brief Asks the OS to back the memory with transparent huge pages. Returns false where that is not supported
+ */
+bool AdviseHugePages(void* address, Size size);
+
+Size GetPageSize();
+} // namespace Memarena
@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+
+#include "Source/Policies/AdaptiveBlockSizePolicy.hpp"
+
+using namespace Memarena;
+
+// A clock that only moves when the test advances it, so the allocation rate the policy observes is exact
+struct FakeClock
+{
+    using duration   = std::chrono::nanoseconds;
+    using rep        = duration::rep;
+    using period     = duration::period;
+    using time_point = std::chrono::time_point<FakeClock>;
+
+    static constexpr bool is_steady = true;
+
+    static time_point now() { return currentTime; }
+    static void       Advance(const duration elapsed) { currentTime += elapsed; }
+
+    static inline time_point currentTime{};
+};
+
+using FakeClockBlockSizePolicy = AdaptiveBlockSizePolicy<true, FakeClock>;
+
+TEST(AdaptiveBlockSizePolicyTest, GrowsWithTheAllocationRate)
+{
+    FakeClockBlockSizePolicy policy{1024, BlockSizeBounds{.minSize = 256, .maxSize = 4096}};
+
+    // A block of 1024 bytes lasting 10ms is on target
+    policy.RecordAllocation(1024);
+    FakeClock::Advance(std::chrono::milliseconds(10));
+    EXPECT_EQ(policy.GetGrowthBlockSize(), 1024);
+
+    // Ten times the rate only doubles the block per growth, up to the upper bound
+    for (Size expectedSize : {2048, 4096, 4096})
+    {
+        policy.RecordAllocation(10 * 1024);
+        FakeClock::Advance(std::chrono::milliseconds(10));
+        EXPECT_EQ(policy.GetGrowthBlockSize(), expectedSize);
+    }
+
+    // Without any time passing the rate is unknown and the block doubles
+    policy.RecordAllocation(1);
+    EXPECT_EQ(policy.GetGrowthBlockSize(), 4096);
+}
+
+TEST(AdaptiveBlockSizePolicyTest, ShrinksWhenAllocationsSlowDown)
+{
+    FakeClockBlockSizePolicy policy{1024, BlockSizeBounds{.minSize = 256, .maxSize = 4096}};
+
+    // A hundredth of the target rate only halves the block per growth, down to the lower bound
+    for (Size expectedSize : {512, 256, 256})
+    {
+        policy.RecordAllocation(100);
+        FakeClock::Advance(std::chrono::milliseconds(100));
+        EXPECT_EQ(policy.GetGrowthBlockSize(), expectedSize);
+    }
+}
+
+TEST(AdaptiveBlockSizePolicyTest, ReleaseFitsThePeak)
+{
+    FakeClockBlockSizePolicy policy{1024, BlockSizeBounds{.minSize = 256, .maxSize = 4096}};
+
+    policy.RecordAllocation(1500);
+    policy.RecordAllocation(500);
+    policy.RecordDeallocation(1500);
+    EXPECT_EQ(policy.GetReleaseBlockSize(), 2048);
+
+    // The statistics start over for the next cycle
+    policy.RecordAllocation(10);
+    EXPECT_EQ(policy.GetReleaseBlockSize(), 256);
+
+    EXPECT_TRUE(FakeClockBlockSizePolicy::ShouldReplaceBlock(256, 512));
+    EXPECT_FALSE(FakeClockBlockSizePolicy::ShouldReplaceBlock(1024, 512));
+    EXPECT_TRUE(FakeClockBlockSizePolicy::ShouldReplaceBlock(2048, 512));
+}
+
+TEST(AdaptiveBlockSizePolicyTest, MaxBelowMinIsRaised)
+{
+    // The default maximum of a small initial block is below the explicit minimum
+    FakeClockBlockSizePolicy derivedMax{16, BlockSizeBounds{.minSize = 8192}};
+
+    EXPECT_EQ(derivedMax.GetMaxBlockSize(), 8192);
+    EXPECT_EQ(derivedMax.GetInitialBlockSize(), 8192);
+
+    FakeClockBlockSizePolicy invertedBounds{1024, BlockSizeBounds{.minSize = 4096, .maxSize = 2048}};
+
+    EXPECT_EQ(invertedBounds.GetMaxBlockSize(), 4096);
+    EXPECT_EQ(invertedBounds.GetGrowthBlockSize(), 4096);
+}
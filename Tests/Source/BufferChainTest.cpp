@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <string>
+
+#if !defined(_WIN32)
+    #include <unistd.h>
+#endif
+
+#include <Memarena/Memarena.hpp>
+
+using namespace Memarena;
+
+class BufferChainTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override { MemoryTracker::ResetAllocators(); }
+    void TearDown() override {}
+};
+
+static std::string JoinSegments(const std::span<const iovec> segments)
+{
+    std::string joined;
+    for (const iovec& segment : segments)
+    {
+        joined.append(static_cast<const char*>(segment.iov_base), segment.iov_len);
+    }
+    return joined;
+}
+
+TEST_F(BufferChainTest, ContiguousAppendsShareASegment)
+{
+    BufferChain bufferChain{256};
+
+    bufferChain.Append("HTTP/1.1 200 OK\r\n");
+    bufferChain.Append("Content-Length: 5\r\n\r\n");
+
+    Byte* body = bufferChain.AppendUninitialized(5);
+    std::memcpy(body, "hello", 5);
+
+    EXPECT_EQ(bufferChain.GetSegmentCount(), 1);
+    EXPECT_EQ(bufferChain.GetSize(), 43);
+    EXPECT_EQ(JoinSegments(bufferChain.GetSegments()), "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello");
+}
+
+TEST_F(BufferChainTest, AppendsAreSplitAcrossBlocks)
+{
+    BufferChain bufferChain{64};
+
+    std::string expected;
+    for (int i = 0; i < 20; i++)
+    {
+        const std::string field = "field" + std::to_string(i) + "=value;";
+        bufferChain.Append(field);
+        expected += field;
+    }
+
+    // Every block is filled completely before the next one is started, so no bytes are lost between segments. Blocks that happen to
+    // be adjacent in memory share a segment
+    EXPECT_EQ(bufferChain.GetSize(), expected.size());
+    EXPECT_LE(bufferChain.GetSegmentCount(), bufferChain.GetArena().GetBlockCount());
+    EXPECT_GT(bufferChain.GetArena().GetBlockCount(), 1);
+    EXPECT_EQ(JoinSegments(bufferChain.GetSegments()), expected);
+}
+
+TEST_F(BufferChainTest, ConsumeReleasesTheArena)
+{
+    BufferChain bufferChain{16};
+
+    bufferChain.Append(std::string(40, 'x'));
+    EXPECT_EQ(bufferChain.GetSegmentCount(), 3);
+
+    // A partial write resumes in the middle of a segment
+    bufferChain.Consume(20);
+    EXPECT_EQ(bufferChain.GetSize(), 20);
+    EXPECT_EQ(bufferChain.GetSegmentCount(), 2);
+    EXPECT_EQ(bufferChain.GetSegments().front().iov_len, 12);
+
+    bufferChain.Consume(20);
+    EXPECT_TRUE(bufferChain.IsEmpty());
+    EXPECT_EQ(bufferChain.GetSegmentCount(), 0);
+    EXPECT_EQ(bufferChain.GetArena().GetBlockCount(), 1);
+    EXPECT_EQ(bufferChain.GetArena().GetUsedSize(), 0);
+}
+
+#if !defined(_WIN32)
+TEST_F(BufferChainTest, WriteTo)
+{
+    BufferChain bufferChain{32};
+
+    const std::string message = "A response that is longer than a single segment of the chain";
+    bufferChain.Append(message);
+
+    int fileDescriptors[2];
+    ASSERT_EQ(pipe(fileDescriptors), 0);
+
+    EXPECT_TRUE(bufferChain.WriteTo(fileDescriptors[1]));
+    EXPECT_TRUE(bufferChain.IsEmpty());
+
+    std::string received(message.size(), '\0');
+    EXPECT_EQ(read(fileDescriptors[0], received.data(), received.size()), static_cast<ssize_t>(message.size()));
+    EXPECT_EQ(received, message);
+
+    close(fileDescriptors[0]);
+    close(fileDescriptors[1]);
+}
+#endif
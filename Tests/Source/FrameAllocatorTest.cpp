@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <Memarena/Memarena.hpp>
+
+#include "MemoryTestObjects.hpp"
+
+using namespace Memarena;
+using namespace Memarena::SizeLiterals;
+
+class FrameAllocatorTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override { MemoryTracker::ResetAllocators(); }
+    void TearDown() override {}
+};
+
+TEST_F(FrameAllocatorTest, Initialize)
+{
+    FrameAllocator<2> frameAllocator{1_KB};
+
+    EXPECT_EQ(frameAllocator.GetCurrentFrameIndex(), 0);
+    EXPECT_EQ(frameAllocator.GetFrameNumber(), 0);
+    EXPECT_EQ(frameAllocator.GetFrameCount(), 2);
+    EXPECT_EQ(frameAllocator.GetCurrentAllocator().GetUsedSize(), 0);
+    EXPECT_EQ(MemoryTracker::GetAllocators().size(), 2);
+}
+
+TEST_F(FrameAllocatorTest, MemoryLivesForFrameCountFrames)
+{
+    FrameAllocator<2> frameAllocator{1_KB};
+
+    TestObject* first = frameAllocator.NewRaw<TestObject>(1, 1.5F, 'a', false, 2.5F);
+
+    frameAllocator.BeginFrame();
+    TestObject* second = frameAllocator.NewRaw<TestObject>(2, 1.5F, 'a', false, 2.5F);
+
+    // The first frame is still alive while the second one is in use
+    EXPECT_EQ(*first, TestObject(1, 1.5F, 'a', false, 2.5F));
+    EXPECT_EQ(*second, TestObject(2, 1.5F, 'a', false, 2.5F));
+    EXPECT_NE(first, second);
+    EXPECT_TRUE(frameAllocator.Owns(first));
+
+    // The third frame reuses the memory of the first one
+    frameAllocator.BeginFrame();
+    EXPECT_EQ(frameAllocator.GetCurrentFrameIndex(), 0);
+    EXPECT_EQ(frameAllocator.GetFrameNumber(), 2);
+    EXPECT_EQ(frameAllocator.GetCurrentAllocator().GetUsedSize(), 0);
+
+    TestObject* third = frameAllocator.NewRaw<TestObject>(3, 1.5F, 'a', false, 2.5F);
+    EXPECT_EQ(third, first);
+    EXPECT_EQ(*second, TestObject(2, 1.5F, 'a', false, 2.5F));
+}
+
+TEST_F(FrameAllocatorTest, Fence)
+{
+    FrameAllocator<2> frameAllocator{1_KB};
+    FrameFence        fence;
+
+    int* value = frameAllocator.NewRaw<int>(42);
+    frameAllocator.AttachFence(fence, 1);
+
+    std::atomic<bool> consumed = false;
+    std::thread       consumer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        consumed = *value == 42;
+        fence.Signal(1);
+    });
+
+    frameAllocator.BeginFrame();
+    EXPECT_FALSE(fence.IsSignaled(2));
+
+    // Reusing the first frame has to wait until the consumer is done with it
+    frameAllocator.BeginFrame();
+    EXPECT_TRUE(fence.IsSignaled(1));
+    EXPECT_TRUE(consumed);
+
+    consumer.join();
+}
+
+TEST_F(FrameAllocatorTest, FenceAlreadySignaled)
+{
+    FrameAllocator<1> frameAllocator{1_KB};
+    FrameFence        fence;
+
+    fence.Signal(5);
+
+    frameAllocator.AttachFence(fence, 3);
+    frameAllocator.AttachFence(fence, 5);
+    frameAllocator.BeginFrame();
+
+    EXPECT_EQ(fence.GetValue(), 5);
+    EXPECT_EQ(frameAllocator.GetFrameNumber(), 1);
+}
@@ -0,0 +1,211 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+using namespace Memarena::SizeLiterals;
+
+using namespace Memarena;
+
+class HeapProfilerTest : public ::testing::Test
+{
+  protected:
+    // With an interval of a byte, every allocation of a KiB is sampled
+    void SetUp() override
+    {
+        HeapProfiler::Reset();
+        HeapProfiler::SetSamplingInterval(1);
+    }
+    void TearDown() override
+    {
+        HeapProfiler::SetSamplingInterval(HeapProfiler::DefaultSamplingInterval);
+        HeapProfiler::Reset();
+    }
+};
+
+TEST_F(HeapProfilerTest, StackAllocator)
+{
+    constexpr StackAllocatorSettings settings = {.policy = StackAllocatorPolicy::Default | StackAllocatorPolicy::HeapProfiling};
+
+    StackAllocator<settings> stackAllocator{10_KiB};
+
+    EXPECT_NE(stackAllocator.Allocate(1_KiB), nullptr);
+    EXPECT_NE(stackAllocator.Allocate(1_KiB), nullptr);
+    void* third = stackAllocator.Allocate(1_KiB);
+
+    EXPECT_EQ(HeapProfiler::GetSampleCount(), 3);
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 3);
+
+    stackAllocator.Deallocate(third);
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 2);
+
+    stackAllocator.Release();
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 0);
+    EXPECT_EQ(HeapProfiler::GetSampleCount(), 3);
+}
+
+TEST_F(HeapProfilerTest, PoolAllocatorAndMallocator)
+{
+    constexpr PoolAllocatorSettings poolSettings   = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::HeapProfiling};
+    constexpr MallocatorSettings    mallocSettings = {.policy = MallocatorPolicy::Default | MallocatorPolicy::HeapProfiling};
+
+    PoolAllocator<poolSettings> poolAllocator{1_KiB, 10};
+    Mallocator<mallocSettings>  mallocator;
+
+    void* object = poolAllocator.Allocate();
+    void* array  = poolAllocator.AllocateBase(3_KiB);
+    void* raw    = mallocator.Allocate(2_KiB);
+
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 3);
+
+    poolAllocator.Deallocate(object);
+    mallocator.Deallocate(raw);
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 1);
+
+    poolAllocator.DeallocateBase(array, 3_KiB);
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 0);
+}
+
+TEST_F(HeapProfilerTest, UnsampledDeallocations)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::HeapProfiling};
+
+    PoolAllocator<settings> poolAllocator{64, 100};
+
+    std::vector<void*> sampled;
+    for (int i = 0; i < 4; i++)
+    {
+        sampled.push_back(poolAllocator.Allocate());
+    }
+
+    // Without sampling, the deallocations miss the live samples
+    HeapProfiler::SetSamplingInterval(0);
+    std::vector<void*> unsampled;
+    for (int i = 0; i < 50; i++)
+    {
+        unsampled.push_back(poolAllocator.Allocate());
+    }
+    for (void* ptr : unsampled)
+    {
+        poolAllocator.Deallocate(ptr);
+    }
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 4);
+
+    for (void* ptr : sampled)
+    {
+        poolAllocator.Deallocate(ptr);
+    }
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 0);
+}
+
+TEST_F(HeapProfilerTest, ZeroIntervalStopsSampling)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::HeapProfiling};
+
+    HeapProfiler::SetSamplingInterval(0);
+
+    LinearAllocator<settings> linearAllocator{100_KiB};
+    for (int i = 0; i < 50; i++)
+    {
+        EXPECT_NE(linearAllocator.Allocate(1_KiB), nullptr);
+    }
+
+    EXPECT_EQ(HeapProfiler::GetSampleCount(), 0);
+}
+
+TEST_F(HeapProfilerTest, ResumeSamplingOnOtherThreads)
+{
+    constexpr MallocatorSettings settings = {.policy = MallocatorPolicy::Default | MallocatorPolicy::HeapProfiling};
+
+    Mallocator<settings> mallocator;
+
+    const auto allocate = [&](const Size count) {
+        for (Size i = 0; i < count; i++)
+        {
+            void* ptr = mallocator.Allocate(1_KiB);
+            EXPECT_NE(ptr, nullptr);
+            mallocator.Deallocate(ptr);
+        }
+    };
+
+    HeapProfiler::SetSamplingInterval(0);
+
+    std::atomic<int> phase = 0;
+    std::thread      worker([&] {
+        // The worker draws its next sample while the sampling is stopped
+        allocate(10);
+        phase = 1;
+        phase.notify_one();
+        phase.wait(1);
+
+        // It notices within the default interval that the sampling was started again on the main thread
+        allocate(2 * HeapProfiler::DefaultSamplingInterval / 1_KiB);
+    });
+
+    phase.wait(0);
+    EXPECT_EQ(HeapProfiler::GetSampleCount(), 0);
+
+    HeapProfiler::SetSamplingInterval(1);
+    phase = 2;
+    phase.notify_one();
+    worker.join();
+
+    EXPECT_GT(HeapProfiler::GetSampleCount(), 0);
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 0);
+}
+
+TEST_F(HeapProfilerTest, SamplesByBytesAllocated)
+{
+    constexpr LinearAllocatorSettings settings = {
+        .policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::Growable | LinearAllocatorPolicy::HeapProfiling};
+
+    HeapProfiler::SetSamplingInterval(64_KiB);
+
+    {
+        LinearAllocator<settings> linearAllocator{1_MiB};
+        for (int i = 0; i < 10000; i++)
+        {
+            EXPECT_NE(linearAllocator.Allocate(1_KiB), nullptr);
+        }
+
+        // About 156 samples are expected, the bounds are more than six standard deviations away
+        EXPECT_GT(HeapProfiler::GetSampleCount(), 80);
+        EXPECT_LT(HeapProfiler::GetSampleCount(), 240);
+        EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), HeapProfiler::GetSampleCount());
+    }
+
+    // Destroying the allocator drops its samples
+    EXPECT_EQ(HeapProfiler::GetLiveSampleCount(), 0);
+}
+
+TEST_F(HeapProfilerTest, WriteProfile)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::HeapProfiling};
+
+    LinearAllocator<settings> linearAllocator{10_KiB};
+    EXPECT_NE(linearAllocator.Allocate(1_KiB), nullptr);
+    EXPECT_NE(linearAllocator.Allocate(2_KiB), nullptr);
+
+    std::ostringstream stream;
+    HeapProfiler::WriteProfile(stream);
+
+    std::istringstream lines(stream.str());
+    std::string        header;
+    std::getline(lines, header);
+    EXPECT_EQ(header, "heap profile:      2:     3072 [     2:     3072] @ heap_v2/1");
+
+    linearAllocator.Release();
+
+    const std::string filePath = ::testing::TempDir() + "HeapProfilerTest.heap";
+    ASSERT_TRUE(HeapProfiler::WriteProfile(filePath));
+
+    std::ifstream file(filePath);
+    std::getline(file, header);
+    EXPECT_EQ(header, "heap profile:      0:        0 [     2:     3072] @ heap_v2/1");
+}
@@ -0,0 +1,204 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+using namespace Memarena;
+using namespace Memarena::SizeLiterals;
+
+class IOBufferPoolTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override {}
+    void TearDown() override {}
+};
+
+constexpr IOBufferPoolSettings trackedSettings = {.policy = IOBufferPoolPolicy::Prefault | IOBufferPoolPolicy::UsageTracking};
+
+TEST_F(IOBufferPoolTest, Initialize)
+{
+    IOBufferPool<trackedSettings> pool{5000, 8};
+
+    EXPECT_EQ(pool.GetBufferSize() % ioBufferAlignment, 0);
+    EXPECT_GE(pool.GetBufferSize(), 5000);
+    EXPECT_EQ(pool.GetBufferCount(), 8);
+    EXPECT_EQ(pool.GetTotalSize(), pool.GetBufferSize() * 8);
+    EXPECT_EQ(pool.GetAcquiredCount(), 0);
+}
+
+TEST_F(IOBufferPoolTest, BuffersAreAlignedAndDistinct)
+{
+    IOBufferPool<trackedSettings> pool{4_KiB, 4};
+
+    std::vector<IOBuffer<trackedSettings>> buffers;
+    for (Size i = 0; i < 4; i++)
+    {
+        buffers.push_back(pool.Acquire());
+        ASSERT_FALSE(buffers.back().IsNull());
+        EXPECT_EQ(std::bit_cast<UIntPtr>(buffers.back().GetData()) % ioBufferAlignment, 0);
+        EXPECT_TRUE(pool.Owns(buffers.back().GetData()));
+        std::memset(buffers.back().GetData(), static_cast<int>(i), buffers.back().GetSize());
+    }
+
+    for (Size i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(buffers[i].GetData()[0], static_cast<Byte>(i));
+        EXPECT_EQ(buffers[i].GetData()[buffers[i].GetSize() - 1], static_cast<Byte>(i));
+    }
+    EXPECT_EQ(pool.GetAcquiredCount(), 4);
+
+    // All buffers are in use, so the pool signals backpressure with an empty handle
+    IOBuffer<trackedSettings> exhausted = pool.Acquire();
+    EXPECT_TRUE(exhausted.IsNull());
+    EXPECT_EQ(exhausted.GetData(), nullptr);
+
+    buffers.clear();
+    EXPECT_EQ(pool.GetAcquiredCount(), 0);
+    EXPECT_FALSE(pool.Acquire().IsNull());
+}
+
+TEST_F(IOBufferPoolTest, ReferenceCounting)
+{
+    IOBufferPool<trackedSettings> pool{4_KiB, 1};
+
+    IOBuffer<trackedSettings> buffer = pool.Acquire();
+    EXPECT_EQ(buffer.GetUseCount(), 1);
+
+    IOBuffer<trackedSettings> copy = buffer;
+    EXPECT_EQ(buffer.GetUseCount(), 2);
+    EXPECT_EQ(copy.GetData(), buffer.GetData());
+
+    IOBuffer<trackedSettings> moved = std::move(copy);
+    EXPECT_TRUE(copy.IsNull());
+    EXPECT_EQ(moved.GetUseCount(), 2);
+
+    // The buffer stays acquired until the last handle is gone
+    buffer.Reset();
+    EXPECT_EQ(pool.GetAcquiredCount(), 1);
+    EXPECT_TRUE(pool.Acquire().IsNull());
+
+    moved.Reset();
+    EXPECT_EQ(pool.GetAcquiredCount(), 0);
+    EXPECT_FALSE(pool.Acquire().IsNull());
+}
+
+TEST_F(IOBufferPoolTest, HandoffBetweenThreads)
+{
+    constexpr Size bufferCount    = 64;
+    constexpr Size iterationCount = 10000;
+
+    IOBufferPool<trackedSettings> pool{4_KiB, bufferCount};
+
+    // The I/O thread fills buffers and hands them to the compute thread, which drops the last reference
+    std::vector<IOBuffer<trackedSettings>> queue(iterationCount);
+    std::atomic<Size>                      produced  = 0;
+    std::atomic<bool>                      corrupted = false;
+
+    std::thread compute([&]() {
+        for (Size i = 0; i < iterationCount; i++)
+        {
+            while (produced.load(std::memory_order_acquire) <= i)
+            {
+                std::this_thread::yield();
+            }
+
+            IOBuffer<trackedSettings> buffer = std::move(queue[i]);
+            const Size                size   = buffer.GetSize();
+            if (size == 0 || buffer.GetData()[0] != static_cast<Byte>(i) || buffer.GetData()[size - 1] != static_cast<Byte>(i))
+            {
+                corrupted = true;
+            }
+        }
+    });
+
+    for (Size i = 0; i < iterationCount; i++)
+    {
+        IOBuffer<trackedSettings> buffer = pool.Acquire();
+        while (buffer.IsNull())
+        {
+            std::this_thread::yield();
+            buffer = pool.Acquire();
+        }
+
+        std::memset(buffer.GetData(), static_cast<int>(i), buffer.GetSize());
+        queue[i] = std::move(buffer);
+        produced.store(i + 1, std::memory_order_release);
+    }
+
+    compute.join();
+
+    EXPECT_FALSE(corrupted);
+    EXPECT_EQ(pool.GetAcquiredCount(), 0);
+}
+
+// The compute thread only releases, so with a per-thread cache larger than the pool it would keep all buffers to itself
+TEST_F(IOBufferPoolTest, HandoffBetweenThreadsWithSmallPool)
+{
+    constexpr Size bufferCount    = 8;
+    constexpr Size iterationCount = 10000;
+
+    IOBufferPool<trackedSettings> pool{4_KiB, bufferCount};
+
+    std::vector<IOBuffer<trackedSettings>> queue(iterationCount);
+    std::atomic<Size>                      produced = 0;
+
+    std::thread compute([&]() {
+        for (Size i = 0; i < iterationCount; i++)
+        {
+            while (produced.load(std::memory_order_acquire) <= i)
+            {
+                std::this_thread::yield();
+            }
+            queue[i].Reset();
+        }
+    });
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    for (Size i = 0; i < iterationCount && std::chrono::steady_clock::now() < deadline; i++)
+    {
+        IOBuffer<trackedSettings> buffer = pool.Acquire();
+        while (buffer.IsNull() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::yield();
+            buffer = pool.Acquire();
+        }
+        ASSERT_FALSE(buffer.IsNull()) << "The pool was starved after " << i << " buffers";
+
+        queue[i] = std::move(buffer);
+        produced.store(i + 1, std::memory_order_release);
+    }
+
+    compute.join();
+    EXPECT_EQ(pool.GetAcquiredCount(), 0);
+}
+
+TEST_F(IOBufferPoolTest, ExitingThreadFlushesItsCache)
+{
+    constexpr Size bufferCount = 8;
+
+    IOBufferPool<trackedSettings> pool{4_KiB, bufferCount};
+
+    std::thread worker([&pool]() {
+        std::vector<IOBuffer<trackedSettings>> buffers;
+        for (Size i = 0; i < bufferCount; i++)
+        {
+            buffers.push_back(pool.Acquire());
+        }
+        buffers.clear();
+    });
+    worker.join();
+
+    // The cache of the worker is gone with the worker, so all buffers must be back in the shared free list
+    std::vector<IOBuffer<trackedSettings>> buffers;
+    for (Size i = 0; i < bufferCount; i++)
+    {
+        buffers.push_back(pool.Acquire());
+        EXPECT_FALSE(buffers.back().IsNull());
+    }
+    EXPECT_EQ(pool.GetAcquiredCount(), bufferCount);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+using namespace Memarena;
+using namespace Memarena::SizeLiterals;
+
+class InternTableTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override { MemoryTracker::ResetAllocators(); }
+    void TearDown() override {}
+};
+
+TEST_F(InternTableTest, DeduplicatesStrings)
+{
+    InternTable internTable{1_KiB};
+
+    const InternId first  = internTable.Intern("Testing/InternTable");
+    const InternId second = internTable.Intern(std::string("Testing/") + "InternTable");
+    const InternId other  = internTable.Intern("Testing/Other");
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, other);
+    EXPECT_EQ(internTable.GetCount(), 2);
+    EXPECT_EQ(internTable.Get(first), "Testing/InternTable");
+
+    // Equal contents share their bytes
+    EXPECT_EQ(internTable.InternView("Testing/Other").data(), internTable.Get(other).data());
+    EXPECT_EQ(internTable.GetArena().GetUsedSize(), std::strlen("Testing/InternTable") + std::strlen("Testing/Other"));
+}
+
+TEST_F(InternTableTest, Find)
+{
+    InternTable internTable{1_KiB};
+
+    EXPECT_FALSE(internTable.Find("Key").has_value());
+
+    const InternId id = internTable.Intern("Key");
+    EXPECT_EQ(internTable.Find("Key"), id);
+    EXPECT_FALSE(internTable.Find("Ke").has_value());
+    EXPECT_EQ(internTable.GetCount(), 1);
+
+    const InternId emptyId = internTable.Intern("");
+    EXPECT_EQ(internTable.Find(""), emptyId);
+    EXPECT_TRUE(internTable.Get(emptyId).empty());
+}
+
+TEST_F(InternTableTest, UnknownIds)
+{
+    constexpr LinearAllocatorSettings settings = {.policy                  = internTableDefaultSettings.policy,
+                                                  .breakOnFailureIsEnabled = false};
+
+    InternTable<settings> internTable{1_KiB};
+
+    const InternId id = internTable.Intern("Key");
+
+    EXPECT_TRUE(internTable.Get(id + 1).empty());
+    EXPECT_TRUE(internTable.Get(InternTable<settings>::InvalidId).empty());
+    EXPECT_TRUE(internTable.GetBytes(InternTable<settings>::InvalidId).empty());
+    EXPECT_EQ(internTable.Get(id), "Key");
+}
+
+TEST_F(InternTableTest, Blobs)
+{
+    InternTable internTable{1_KiB};
+
+    const Byte blob[]   = {0x00, 0x01, 0x00, 0xFF};
+    const Byte prefix[] = {0x00, 0x01};
+
+    const InternId blobId   = internTable.Intern(blob, sizeof(blob));
+    const InternId prefixId = internTable.Intern(prefix, sizeof(prefix));
+
+    EXPECT_NE(blobId, prefixId);
+    EXPECT_EQ(internTable.Intern(blob, sizeof(blob)), blobId);
+
+    const std::span<const Byte> bytes = internTable.GetBytes(blobId);
+    ASSERT_EQ(bytes.size(), sizeof(blob));
+    EXPECT_EQ(std::memcmp(bytes.data(), blob, sizeof(blob)), 0);
+
+    // Contents larger than a block get a block of their own
+    const std::string large(4_KiB, 'x');
+    EXPECT_EQ(internTable.Get(internTable.Intern(large)), large);
+}
+
+TEST_F(InternTableTest, ViewsStayValidWhileGrowing)
+{
+    InternTable internTable{256};
+
+    std::vector<std::string_view> views;
+    for (int i = 0; i < 10000; i++)
+    {
+        views.push_back(internTable.InternView("label" + std::to_string(i)));
+    }
+
+    EXPECT_EQ(internTable.GetCount(), 10000);
+    EXPECT_GT(internTable.GetArena().GetBlockCount(), 1);
+
+    for (int i = 0; i < 10000; i++)
+    {
+        const std::string label = "label" + std::to_string(i);
+        EXPECT_EQ(views[i], label);
+        EXPECT_EQ(internTable.Find(label), static_cast<InternId>(i));
+    }
+}
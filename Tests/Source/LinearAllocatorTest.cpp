@@ -177,6 +177,114 @@ TEST_F(LinearAllocatorTest, Growable)
     EXPECT_EQ(linearAllocator2.GetTotalSize(), blockSize * 10);
 }
 
+TEST_F(LinearAllocatorTest, BumpDown)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::BumpDown};
+
+    LinearAllocator<settings> linearAllocator{1_KiB};
+
+    void* first  = linearAllocator.Allocate(24, 8);
+    void* second = linearAllocator.Allocate(1, 1);
+    void* third  = linearAllocator.Allocate(16, 16);
+
+    // Every allocation is placed below the previous one
+    EXPECT_LT(std::bit_cast<UIntPtr>(second), std::bit_cast<UIntPtr>(first));
+    EXPECT_LT(std::bit_cast<UIntPtr>(third), std::bit_cast<UIntPtr>(second));
+    EXPECT_EQ(std::bit_cast<UIntPtr>(first) % 8, 0);
+    EXPECT_EQ(std::bit_cast<UIntPtr>(third) % 16, 0);
+    EXPECT_EQ(std::bit_cast<UIntPtr>(second) + 1, std::bit_cast<UIntPtr>(first));
+
+    // The padding of every allocation is at most its alignment - 1
+    EXPECT_GE(linearAllocator.GetUsedSize(), 24 + 1 + 16);
+    EXPECT_LE(linearAllocator.GetUsedSize(), (24 + 7) + 1 + (16 + 15));
+    EXPECT_TRUE(linearAllocator.Owns(first));
+    EXPECT_TRUE(linearAllocator.Owns(third));
+
+    linearAllocator.Release();
+    EXPECT_EQ(linearAllocator.Allocate(24, 8), first);
+}
+
+TEST_F(LinearAllocatorTest, BumpDownGrowable)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::Growable |
+                                                            LinearAllocatorPolicy::BumpDown};
+
+    LinearAllocator<settings> linearAllocator{sizeof(TestObject) * 2};
+
+    std::vector<TestObject*> objects;
+    for (int i = 0; i < 10; i++)
+    {
+        objects.push_back(linearAllocator.NewRaw<TestObject>(i, 1.5F, 'a', false, 2.5F));
+    }
+
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(*objects[i], TestObject(i, 1.5F, 'a', false, 2.5F));
+        EXPECT_EQ(std::bit_cast<UIntPtr>(objects[i]) % alignof(TestObject), 0);
+    }
+
+    EXPECT_EQ(linearAllocator.GetBlockCount(), 5);
+    EXPECT_EQ(linearAllocator.GetUsedSize(), sizeof(TestObject) * 10);
+}
+
+TEST_F(LinearAllocatorTest, AdaptiveBlockSizeRelease)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::Growable |
+                                                            LinearAllocatorPolicy::AdaptiveBlockSize};
+
+    LinearAllocator<settings> linearAllocator{1_KiB, BlockSizeBounds{.minSize = 256, .maxSize = 1_MiB}};
+
+    for (Size i = 0; i < 1000; i++)
+    {
+        EXPECT_NE(linearAllocator.Allocate(64), nullptr);
+    }
+
+    // The kept block fits the whole cycle, even with the padding between the allocations
+    linearAllocator.Release();
+
+    EXPECT_EQ(linearAllocator.GetBlockCount(), 1);
+    EXPECT_EQ(linearAllocator.GetBlockSize(0), 64_KiB);
+    EXPECT_EQ(linearAllocator.GetTotalSize(), 64_KiB);
+    EXPECT_EQ(linearAllocator.GetUsedSize(), 0);
+
+    for (Size i = 0; i < 1000; i++)
+    {
+        EXPECT_NE(linearAllocator.Allocate(64), nullptr);
+    }
+
+    EXPECT_EQ(linearAllocator.GetBlockCount(), 1);
+
+    // A small cycle shrinks the block down to the lower bound
+    linearAllocator.Release();
+    EXPECT_NE(linearAllocator.Allocate(64), nullptr);
+    linearAllocator.Release();
+
+    EXPECT_EQ(linearAllocator.GetBlockSize(0), 256);
+    EXPECT_EQ(linearAllocator.GetTotalSize(), 256);
+}
+
+TEST_F(LinearAllocatorTest, BlocksFitTheOffsets)
+{
+    constexpr LinearAllocatorSettings adaptiveSettings = {
+        .policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::Growable | LinearAllocatorPolicy::AdaptiveBlockSize,
+        .breakOnFailureIsEnabled = false};
+    constexpr LinearAllocatorSettings growableSettings = {.policy = LinearAllocatorPolicy::SizeTracking | LinearAllocatorPolicy::Growable,
+                                                          .breakOnFailureIsEnabled = false};
+
+    // The default upper bound of 64 initial blocks is past the 32-bit offsets, so it is clamped and the size check rejects the
+    // allocation
+    LinearAllocator<adaptiveSettings> adaptiveAllocator{64_MiB};
+    EXPECT_EQ(adaptiveAllocator.Allocate(4_GiB), nullptr);
+    EXPECT_EQ(adaptiveAllocator.GetBlockCount(), 1);
+
+    // Without the size check, the block for the allocation is rejected before it is allocated
+    LinearAllocator<growableSettings> growableAllocator{1_KiB};
+    EXPECT_EQ(growableAllocator.Allocate(4_GiB), nullptr);
+    EXPECT_EQ(growableAllocator.GetBlockCount(), 1);
+    EXPECT_EQ(growableAllocator.GetUsedSize(), 0);
+    EXPECT_NE(growableAllocator.Allocate(64), nullptr);
+}
+
 TEST_F(LinearAllocatorTest, Templated)
 {
     LinearAllocatorTemplated<TestObject> linearAllocatorTemplated{10_KB};
@@ -243,19 +351,98 @@ ALLOCATOR_DEBUG_TEST(DefaultBaseAllocator, {
     EXPECT_EQ(Allocator::GetDefaultAllocator()->GetTotalSize(), 1_MB);
 })
 
+TEST_F(LinearAllocatorTest, SharedBaseAllocator)
+{
+    constexpr LinearAllocatorSettings     settings = {.policy = LinearAllocatorPolicy::Default};
+    LinearAllocator<settings, SharedBase> linearAllocator{1_MB};
+
+    int* num = static_cast<int*>(linearAllocator.Allocate<int>("Testing/LinearAllocator"));
+    EXPECT_NE(num, nullptr);
+    EXPECT_EQ(Allocator::GetDefaultAllocator()->GetTotalSize(), 1_MB);
+
+    // The stateless default base allocator takes up no space
+    static_assert(sizeof(LinearAllocator<settings>) < sizeof(LinearAllocator<settings, SharedBase>));
+}
+
 TEST_F(LinearAllocatorTest, CustomBaseAllocator)
 {
     constexpr MallocatorSettings mallocatorSettings = {.policy = MallocatorPolicy::Default};
 
     auto baseAllocator = std::make_shared<Mallocator<mallocatorSettings>>("Mallocator");
 
-    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Debug};
-    LinearAllocator<settings>         linearAllocator{1_MB, "TestAllocator", baseAllocator};
+    constexpr LinearAllocatorSettings     settings = {.policy = LinearAllocatorPolicy::Debug};
+    LinearAllocator<settings, SharedBase> linearAllocator{1_MB, "TestAllocator", baseAllocator};
 
     int* num = static_cast<int*>(linearAllocator.Allocate<int>("Testing/LinearAllocator"));
     EXPECT_EQ(baseAllocator->GetTotalSize(), 1_MB);
 }
 
+TEST_F(LinearAllocatorTest, ChildArena)
+{
+    constexpr MallocatorSettings mallocatorSettings = {.policy = MallocatorPolicy::Default};
+    auto                         baseAllocator      = std::make_shared<Mallocator<mallocatorSettings>>("Mallocator");
+
+    constexpr LinearAllocatorSettings linearSettings = {.policy = LinearAllocatorPolicy::Default};
+    constexpr StackAllocatorSettings  stackSettings  = {.policy = StackAllocatorPolicy::Default};
+
+    using RequestAllocator = StackAllocator<stackSettings, SharedBase>;
+    using StateAllocator   = PoolAllocator<poolAllocatorDefaultSettings, SharedBase>;
+
+    // A session arena, a request stack inside of it and a pool of connection states inside of the request
+    LinearAllocator<linearSettings, SharedBase> sessionAllocator{64_KB, "SessionAllocator", baseAllocator};
+    {
+        auto requestAllocator = CreateChildArena<RequestAllocator>(sessionAllocator, 16_KB, "RequestAllocator");
+        auto stateAllocator   = CreateChildArena<StateAllocator>(*requestAllocator, sizeof(TestObject), 32, "StateAllocator");
+
+        TestObject* object = stateAllocator->NewRaw<TestObject>(1, 2.1F, 'a', false, 10.6F);
+
+        EXPECT_TRUE(stateAllocator->Owns(object));
+        EXPECT_TRUE(requestAllocator->Owns(object));
+        EXPECT_TRUE(sessionAllocator.Owns(object));
+        EXPECT_GE(requestAllocator->GetUsedSize(), 32 * sizeof(TestObject));
+        EXPECT_GE(sessionAllocator.GetUsedSize(), 16_KB);
+
+        stateAllocator->Delete(object);
+    }
+
+    // The children never went to the base allocator on their own
+    EXPECT_EQ(baseAllocator->GetTotalSize(), 64_KB);
+}
+
+TEST_F(LinearAllocatorTest, ChildArenaExhaustsParent)
+{
+    constexpr StackAllocatorSettings  stackSettings = {.policy = StackAllocatorPolicy::Default, .breakOnFailureIsEnabled = false};
+    constexpr LinearAllocatorSettings settings      = {
+        .policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::Growable | LinearAllocatorPolicy::BumpDown,
+        .breakOnFailureIsEnabled = false};
+
+    StackAllocator<stackSettings> parentAllocator{1_KiB, "Parent"};
+    {
+        auto childAllocator = CreateChildArena<LinearAllocator<settings, SharedBase>>(parentAllocator, 256, "Child");
+
+        Size allocationCount = 0;
+        for (; allocationCount < 100; allocationCount++)
+        {
+            void* ptr = childAllocator->Allocate(128);
+            if (ptr == nullptr)
+            {
+                break;
+            }
+            EXPECT_TRUE(parentAllocator.Owns(ptr));
+        }
+
+        // The blocks that fit into the parent are kept and the child keeps working after a release
+        EXPECT_GT(allocationCount, 1);
+        EXPECT_LT(allocationCount, 100);
+        EXPECT_EQ(childAllocator->GetTotalSize(), childAllocator->GetBlockCount() * 256);
+
+        childAllocator->Release();
+        EXPECT_EQ(childAllocator->GetBlockCount(), 1);
+        EXPECT_NE(childAllocator->Allocate(128), nullptr);
+    }
+    EXPECT_EQ(parentAllocator.GetUsedSize(), 0);
+}
+
 ALLOCATOR_DEBUG_TEST(GetUsedSizeNew, {
     const int numObjects = 10;
     for (size_t i = 0; i < numObjects; i++)
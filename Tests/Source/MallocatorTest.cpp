@@ -427,6 +427,84 @@ TEST_F(MallocatorTest, DoubleFreeRaw)
     EXPECT_EQ(ptr, nullptr);
 }
 
+TEST_F(MallocatorTest, RawAllocationAlignment)
+{
+    constexpr MallocatorSettings settings = {.policy = MallocatorPolicy::Default};
+    Mallocator<settings>         mallocator{};
+
+    void* ptr        = mallocator.Allocate(10);
+    void* alignedPtr = mallocator.Allocate(10, 64);
+
+    EXPECT_EQ(std::bit_cast<UIntPtr>(ptr) % alignof(std::max_align_t), 0);
+    EXPECT_EQ(std::bit_cast<UIntPtr>(alignedPtr) % 64, 0);
+    EXPECT_EQ(mallocator.GetAllocationSize(alignedPtr), 10);
+    EXPECT_EQ(mallocator.GetUsedSize(), 20);
+
+    mallocator.Deallocate(ptr);
+    mallocator.Deallocate(alignedPtr);
+
+    EXPECT_EQ(mallocator.GetUsedSize(), 0);
+}
+
+TEST_F(MallocatorTest, Headerless)
+{
+    constexpr MallocatorSettings settings = {.policy = MallocatorPolicy::Default | MallocatorPolicy::Headerless};
+    Mallocator<settings>         mallocator{};
+
+    void* ptr        = mallocator.Allocate(100);
+    void* alignedPtr = mallocator.Allocate(100, 128);
+
+    EXPECT_EQ(std::bit_cast<UIntPtr>(ptr) % alignof(std::max_align_t), 0);
+    EXPECT_EQ(std::bit_cast<UIntPtr>(alignedPtr) % 128, 0);
+
+    // Headerless allocations are tracked with their usable size
+    EXPECT_GE(mallocator.GetAllocationSize(ptr), 100);
+    EXPECT_EQ(mallocator.GetUsedSize(), mallocator.GetAllocationSize(ptr) + mallocator.GetAllocationSize(alignedPtr));
+
+    mallocator.Deallocate(ptr, 100);
+    mallocator.Deallocate(alignedPtr);
+
+    EXPECT_EQ(mallocator.GetUsedSize(), 0);
+    EXPECT_EQ(ptr, nullptr);
+}
+
+TEST_F(MallocatorTest, HeaderlessNewArrayRaw)
+{
+    constexpr MallocatorSettings settings = {.policy = MallocatorPolicy::Debug | MallocatorPolicy::Headerless};
+    Mallocator<settings>         mallocator{};
+
+    TestObject* arr = mallocator.NewArrayRaw<TestObject>(10, 1, 2.1F, 'a', false, 10.6F);
+
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(arr[i], TestObject(1, 2.1F, 'a', false, 10.6F));
+    }
+
+    mallocator.DeleteArray(arr, 10);
+
+    EXPECT_EQ(mallocator.GetUsedSize(), 0);
+    EXPECT_EQ(mallocator.GetDeallocationCount(), 1);
+}
+
+TEST_F(MallocatorTest, BaseAllocationsAreHeaderless)
+{
+    constexpr MallocatorSettings settings = {.policy = MallocatorPolicy::Default};
+    Mallocator<settings>         mallocator{};
+
+    void* block = mallocator.AllocateBase(1_KB);
+
+    // Only the pointer returned by malloc has a usable size, a pointer past a header doesn't
+    EXPECT_GE(Internal::GetMallocSize(block), 1_KB);
+    EXPECT_EQ(std::bit_cast<UIntPtr>(block) % alignof(std::max_align_t), 0);
+    EXPECT_EQ(mallocator.GetUsedSize(), 1_KB);
+    EXPECT_EQ(mallocator.GetTotalSize(), 1_KB);
+
+    mallocator.DeallocateBase(block, 1_KB);
+
+    EXPECT_EQ(mallocator.GetUsedSize(), 0);
+    EXPECT_EQ(mallocator.GetTotalSize(), 0);
+}
+
 #ifdef MEMARENA_ENABLE_ASSERTS
 
 class MallocatorDeathTest : public ::testing::Test
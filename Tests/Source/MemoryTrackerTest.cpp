@@ -1,5 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 #include <Memarena/Memarena.hpp>
 
 #include "MemoryTestObjects.hpp"
@@ -11,8 +20,20 @@ using namespace Memarena;
 class MemoryTrackerTest : public ::testing::Test
 {
   protected:
-    void SetUp() override { MemoryTracker::Reset(); }
+    void SetUp() override
+    {
+        MemoryTracker::Reset();
+        MemoryTracker::ResetThreadStats();
+    }
     void TearDown() override {}
+
+    static ThreadAllocationStats GetThreadStats(const std::thread::id threadId)
+    {
+        const std::vector<ThreadAllocationStats> threadStats = MemoryTracker::GetThreadStats();
+        const auto isThread = [threadId](const ThreadAllocationStats& stats) { return stats.threadId == threadId; };
+        const auto it       = std::find_if(threadStats.begin(), threadStats.end(), isThread);
+        return it != threadStats.end() ? *it : ThreadAllocationStats{};
+    }
 };
 
 TEST_F(MemoryTrackerTest, StackAllocator)
@@ -30,4 +51,387 @@ TEST_F(MemoryTrackerTest, StackAllocator)
     EXPECT_EQ(allocators[0]->allocationCount, 1);
     EXPECT_EQ(allocators[0]->allocations[0].category, std::string("Testing/StackAllocator"));
     EXPECT_EQ(allocators[0]->allocations[0].size, sizeof(int));
-}
\ No newline at end of file
+}
+TEST_F(MemoryTrackerTest, TakeSnapshot)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default};
+
+    LinearAllocator<settings> first{1_KiB, "First"};
+    LinearAllocator<settings> second{2_KiB, "Second"};
+
+    EXPECT_NE(first.Allocate(100), nullptr);
+
+    const MemorySnapshot snapshot = MemoryTracker::TakeSnapshot();
+
+    // The snapshot is a copy, later allocations don't change it
+    EXPECT_NE(second.Allocate(200), nullptr);
+
+    ASSERT_EQ(snapshot.allocators.size(), 2);
+    EXPECT_LT(snapshot.allocators[0].id, snapshot.allocators[1].id);
+    EXPECT_EQ(snapshot.allocators[0].debugName, "First");
+    EXPECT_EQ(snapshot.allocators[0].totalSize, 1_KiB);
+    EXPECT_EQ(snapshot.allocators[0].usedSize, 100);
+    EXPECT_EQ(snapshot.allocators[1].debugName, "Second");
+    EXPECT_EQ(snapshot.allocators[1].usedSize, 0);
+}
+
+TEST_F(MemoryTrackerTest, Diff)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::AllocationTracking};
+
+    LinearAllocator<settings> kept{1_KiB, "Kept"};
+    EXPECT_NE(kept.Allocate(300), nullptr);
+
+    auto removed = std::make_unique<LinearAllocator<settings>>(1_KiB, "Removed");
+    EXPECT_NE(removed->Allocate(50), nullptr);
+
+    const MemorySnapshot before = MemoryTracker::TakeSnapshot();
+
+    kept.Release();
+    EXPECT_NE(kept.Allocate(100), nullptr);
+    removed.reset();
+    LinearAllocator<settings> added{512, "Added"};
+
+    const MemorySnapshotDiff diff = MemoryTracker::Diff(before, MemoryTracker::TakeSnapshot());
+
+    ASSERT_EQ(diff.allocators.size(), 3);
+
+    EXPECT_EQ(diff.allocators[0].debugName, "Kept");
+    EXPECT_EQ(diff.allocators[0].status, AllocatorDiffStatus::Changed);
+    EXPECT_EQ(diff.allocators[0].usedSize, -200);
+    EXPECT_EQ(diff.allocators[0].allocationCount, 1);
+
+    EXPECT_EQ(diff.allocators[1].debugName, "Removed");
+    EXPECT_EQ(diff.allocators[1].status, AllocatorDiffStatus::Removed);
+    EXPECT_EQ(diff.allocators[1].totalSize, -1024);
+    EXPECT_EQ(diff.allocators[1].usedSize, -50);
+
+    EXPECT_EQ(diff.allocators[2].debugName, "Added");
+    EXPECT_EQ(diff.allocators[2].status, AllocatorDiffStatus::Added);
+    EXPECT_EQ(diff.allocators[2].totalSize, 512);
+}
+
+TEST_F(MemoryTrackerTest, Exporters)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default};
+
+    LinearAllocator<settings> linearAllocator{1_KiB, "Say \"hi\", please"};
+    EXPECT_NE(linearAllocator.Allocate(128), nullptr);
+
+    const MemorySnapshot first = MemoryTracker::TakeSnapshot();
+    EXPECT_NE(linearAllocator.Allocate(128), nullptr);
+    const MemorySnapshot second = MemoryTracker::TakeSnapshot();
+
+    std::ostringstream json;
+    WriteJson(json, first);
+    EXPECT_NE(json.str().find(R"("name":"Say \"hi\", please","baseAllocator":false,"totalSize":1024,"usedSize":128)"), std::string::npos);
+
+    std::ostringstream csv;
+    WriteCsv(csv, MemoryTracker::Diff(first, second));
+    EXPECT_NE(csv.str().find("id,name,status,totalSize,usedSize,"), std::string::npos);
+    EXPECT_NE(csv.str().find(R"(,"Say ""hi"", please",changed,0,128,128,0,0)"), std::string::npos);
+
+    const std::vector<MemorySnapshot> snapshots = {first, second};
+    std::ostringstream                trace;
+    WriteChromeTrace(trace, snapshots);
+    EXPECT_NE(trace.str().find(R"("ph":"C")"), std::string::npos);
+    EXPECT_NE(trace.str().find(R"("args":{"usedSize":128,"totalSize":1024})"), std::string::npos);
+    EXPECT_NE(trace.str().find(R"("args":{"usedSize":256,"totalSize":1024})"), std::string::npos);
+}
+
+TEST_F(MemoryTrackerTest, AllocatorTree)
+{
+    constexpr MallocatorSettings      mallocSettings = {.policy = MallocatorPolicy::Default};
+    constexpr PoolAllocatorSettings   poolSettings   = {.policy = PoolAllocatorPolicy::Default};
+    constexpr LinearAllocatorSettings linearSettings = {.policy = LinearAllocatorPolicy::Default};
+
+    auto mallocator = std::make_shared<Mallocator<mallocSettings>>("Parent");
+
+    PoolAllocator<poolSettings, SharedBase> poolAllocator{1_KiB, 4, "Pool", mallocator};
+    auto child = CreateChildArena<LinearAllocator<linearSettings, SharedBase>>(poolAllocator, 1_KiB, "Child");
+    EXPECT_NE(child->Allocate(128), nullptr);
+
+    const std::vector<AllocatorTreeNode> roots = MemoryTracker::GetAllocatorTree();
+
+    ASSERT_EQ(roots.size(), 1);
+    EXPECT_EQ(roots[0].allocator->debugName, "Parent");
+    ASSERT_EQ(roots[0].children.size(), 1);
+    EXPECT_EQ(roots[0].children[0].allocator->debugName, "Pool");
+    EXPECT_EQ(roots[0].children[0].allocator->parentRelation, AllocatorRelation::BaseAllocator);
+    ASSERT_EQ(roots[0].children[0].children.size(), 1);
+    EXPECT_EQ(roots[0].children[0].children[0].allocator->debugName, "Child");
+
+    // The blocks of the pool and of its child are counted once, in the Mallocator
+    EXPECT_EQ(roots[0].rolledUpTotalSize, 4_KiB);
+    EXPECT_EQ(roots[0].rolledUpUsedSize, 128);
+    EXPECT_EQ(roots[0].children[0].rolledUpTotalSize, 4_KiB);
+    EXPECT_EQ(roots[0].children[0].rolledUpUsedSize, 128);
+
+    std::vector<std::pair<std::string, Size>> visited;
+    MemoryTracker::Traverse(roots, [&](const AllocatorTreeNode& node, const Size depth) {
+        visited.emplace_back(node.allocator->debugName, depth);
+    });
+
+    const std::vector<std::pair<std::string, Size>> expected = {{"Parent", 0}, {"Pool", 1}, {"Child", 2}};
+    EXPECT_EQ(visited, expected);
+}
+
+// Gets the blocks from malloc without an Allocator, so the allocators that use it have no parent in the tree
+struct UntrackedBase
+{
+    NO_DISCARD void* AllocateBase(const Size size) const { return std::malloc(size); }
+    void             DeallocateBase(void* ptr, const Size /*size*/) const { std::free(ptr); }
+};
+
+TEST_F(MemoryTrackerTest, WrappedAllocatorTree)
+{
+    constexpr StackAllocatorSettings stackSettings = {.policy = StackAllocatorPolicy::Default};
+
+    // With the default base allocator the stacks would already be the children of the default allocator
+    auto primary  = std::make_shared<StackAllocator<stackSettings, UntrackedBase>>(1_KiB, "Primary");
+    auto fallback = std::make_shared<StackAllocator<stackSettings, UntrackedBase>>(4_KiB, "Fallback");
+
+    FallbackAllocator fallbackAllocator{primary, fallback};
+    EXPECT_NE(fallbackAllocator.Allocate(256), nullptr);
+
+    const std::vector<AllocatorTreeNode> roots = MemoryTracker::GetAllocatorTree();
+
+    // A wrapper owns no memory itself, so its total is the memory of the allocators it wraps
+    ASSERT_EQ(roots.size(), 1);
+    EXPECT_EQ(roots[0].allocator->debugName, "FallbackAllocator");
+    ASSERT_EQ(roots[0].children.size(), 2);
+    EXPECT_EQ(roots[0].children[0].allocator->parentRelation, AllocatorRelation::Wrapped);
+    EXPECT_EQ(roots[0].rolledUpTotalSize, 5_KiB);
+    EXPECT_EQ(roots[0].rolledUpUsedSize, primary->GetUsedSize() + fallback->GetUsedSize());
+    EXPECT_GT(primary->GetUsedSize(), 0);
+}
+
+TEST_F(MemoryTrackerTest, ThreadStats)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::ThreadTracking};
+
+    PoolAllocator<settings> poolAllocator{64, 10};
+
+    void* first = poolAllocator.Allocate();
+    EXPECT_NE(poolAllocator.Allocate(), nullptr);
+    EXPECT_NE(poolAllocator.Allocate(), nullptr);
+    poolAllocator.Deallocate(first);
+
+    ThreadAllocationStats stats = GetThreadStats(std::this_thread::get_id());
+    EXPECT_EQ(stats.allocatedSize, 192);
+    EXPECT_EQ(stats.freedSize, 64);
+    EXPECT_EQ(stats.liveSize, 128);
+    EXPECT_EQ(stats.allocationCount, 3);
+    EXPECT_EQ(stats.deallocationCount, 1);
+
+    // A release frees the remaining objects without deallocating them one by one
+    poolAllocator.Release();
+    stats = GetThreadStats(std::this_thread::get_id());
+    EXPECT_EQ(stats.freedSize, 192);
+    EXPECT_EQ(stats.liveSize, 0);
+    EXPECT_EQ(stats.deallocationCount, 1);
+}
+
+TEST_F(MemoryTrackerTest, ThreadStatsPerThread)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::Growable |
+                                                            LinearAllocatorPolicy::Multithreaded | LinearAllocatorPolicy::ThreadTracking};
+
+    LinearAllocator<settings> linearAllocator{2_KiB};
+    EXPECT_NE(linearAllocator.Allocate(1_KiB), nullptr);
+
+    std::thread worker([&linearAllocator] {
+        MemoryTracker::SetThreadName("Worker");
+        for (int i = 0; i < 4; i++)
+        {
+            EXPECT_NE(linearAllocator.Allocate(1_KiB), nullptr);
+        }
+    });
+    const std::thread::id workerId = worker.get_id();
+    worker.join();
+
+    // The thread that grew the allocator the most comes first, its stats stay under its name after it exited
+    const std::vector<ThreadAllocationStats> threadStats = MemoryTracker::GetThreadStats();
+    ASSERT_FALSE(threadStats.empty());
+    EXPECT_EQ(threadStats[0].threadId, std::thread::id());
+    EXPECT_EQ(threadStats[0].threadName, "Worker");
+    EXPECT_EQ(threadStats[0].allocatedSize, 4_KiB);
+    EXPECT_EQ(threadStats[0].allocationCount, 4);
+    EXPECT_EQ(GetThreadStats(std::this_thread::get_id()).allocatedSize, 1_KiB);
+
+    // The releasing thread frees what the worker allocated
+    linearAllocator.Release();
+    const ThreadAllocationStats stats = GetThreadStats(std::this_thread::get_id());
+    EXPECT_EQ(stats.freedSize, 5_KiB);
+    EXPECT_EQ(stats.liveSize, -4 * Int64(1_KiB));
+    EXPECT_EQ(GetThreadStats(workerId).freedSize, 0);
+}
+
+TEST_F(MemoryTrackerTest, ThreadStatsOfExitedThreads)
+{
+    constexpr MallocatorSettings settings = {.policy = MallocatorPolicy::Default | MallocatorPolicy::ThreadTracking};
+
+    Mallocator<settings> mallocator{};
+
+    const Size threadCount = MemoryTracker::GetThreadStats().size();
+
+    for (int i = 0; i < 64; i++)
+    {
+        std::thread worker([&mallocator, i] {
+            MemoryTracker::SetThreadName(i % 2 == 0 ? "Even" : "Odd");
+            void* ptr = mallocator.Allocate(100);
+            mallocator.Deallocate(ptr);
+        });
+        worker.join();
+    }
+
+    // The exited threads are summed up per name instead of keeping an entry each
+    const std::vector<ThreadAllocationStats> threadStats = MemoryTracker::GetThreadStats();
+    EXPECT_EQ(threadStats.size(), threadCount + 2);
+
+    for (const char* threadName : {"Even", "Odd"})
+    {
+        const auto isName = [threadName](const ThreadAllocationStats& stats) { return stats.threadName == threadName; };
+        const auto it     = std::find_if(threadStats.begin(), threadStats.end(), isName);
+        ASSERT_NE(it, threadStats.end());
+        EXPECT_EQ(it->threadId, std::thread::id());
+        EXPECT_EQ(it->allocatedSize, 32 * 100);
+        EXPECT_EQ(it->allocationCount, 32);
+        EXPECT_EQ(it->deallocationCount, 32);
+        EXPECT_EQ(it->liveSize, 0);
+    }
+}
+
+TEST_F(MemoryTrackerTest, ResetThreadStatsOfRunningThread)
+{
+    constexpr MallocatorSettings settings = {.policy = MallocatorPolicy::Default | MallocatorPolicy::ThreadTracking};
+
+    Mallocator<settings> mallocator{};
+    std::atomic<int>     phase = 0;
+
+    std::thread worker([&mallocator, &phase] {
+        MemoryTracker::SetThreadName("Worker");
+        for (int i = 0; i < 10; i++)
+        {
+            void* ptr = mallocator.Allocate(100);
+            mallocator.Deallocate(ptr);
+        }
+
+        phase = 1;
+        while (phase != 2)
+        {
+            std::this_thread::yield();
+        }
+
+        void* ptr = mallocator.Allocate(100);
+        mallocator.Deallocate(ptr);
+    });
+
+    while (phase != 1)
+    {
+        std::this_thread::yield();
+    }
+
+    // The reset is reported against the counts at this point, the counters of the worker are left alone
+    MemoryTracker::ResetThreadStats();
+    phase = 2;
+    worker.join();
+
+    const std::vector<ThreadAllocationStats> threadStats = MemoryTracker::GetThreadStats();
+    const auto isWorker = [](const ThreadAllocationStats& stats) { return stats.threadName == "Worker"; };
+    const auto it       = std::find_if(threadStats.begin(), threadStats.end(), isWorker);
+    ASSERT_NE(it, threadStats.end());
+    EXPECT_EQ(it->allocatedSize, 100);
+    EXPECT_EQ(it->allocationCount, 1);
+    EXPECT_EQ(it->deallocationCount, 1);
+}
+
+TEST_F(MemoryTrackerTest, StatsSampler)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::AllocationTracking |
+                                                            LinearAllocatorPolicy::SizeTracking};
+
+    // The interval is long enough that only the explicit samples are taken
+    MemoryTracker::StartSampling(std::chrono::hours(1), 3);
+    EXPECT_TRUE(MemoryTracker::IsSampling());
+    EXPECT_TRUE(MemoryTracker::GetRates().empty());
+
+    LinearAllocator<settings> linearAllocator{10_KiB};
+    MemoryTracker::SampleStats();
+
+    for (int i = 0; i < 8; i++)
+    {
+        EXPECT_NE(linearAllocator.Allocate(128), nullptr);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    MemoryTracker::SampleStats();
+
+    const std::vector<MemorySnapshot> history = MemoryTracker::GetSampleHistory();
+    ASSERT_EQ(history.size(), 2);
+    const double seconds = std::chrono::duration<double>(history[1].time - history[0].time).count();
+
+    const std::vector<AllocatorRates> rates = MemoryTracker::GetRates();
+    ASSERT_EQ(rates.size(), 1);
+    EXPECT_NEAR(rates[0].allocationsPerSecond * seconds, 8.0, 1e-6);
+    EXPECT_NEAR(rates[0].usedBytesPerSecond * seconds, 1024.0, 1e-6);
+    EXPECT_EQ(rates[0].totalBytesPerSecond, 0.0);
+
+    // The ring keeps the newest samples
+    MemoryTracker::SampleStats();
+    MemoryTracker::SampleStats();
+    const std::vector<MemorySnapshot> fullHistory = MemoryTracker::GetSampleHistory();
+    ASSERT_EQ(fullHistory.size(), 3);
+    EXPECT_EQ(fullHistory[0].time, history[1].time);
+    EXPECT_LE(fullHistory[1].time, fullHistory[2].time);
+
+    MemoryTracker::StopSampling();
+    EXPECT_FALSE(MemoryTracker::IsSampling());
+    EXPECT_TRUE(MemoryTracker::GetSampleHistory().empty());
+}
+
+TEST_F(MemoryTrackerTest, StatsSamplerThread)
+{
+    MemoryTracker::StartSampling(std::chrono::milliseconds(1), 4);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (MemoryTracker::GetSampleHistory().size() < 4 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(MemoryTracker::GetSampleHistory().size(), 4);
+    MemoryTracker::StopSampling();
+}
+
+// Run under ThreadSanitizer in CI, the sampler reads the counters while the allocator updates them
+TEST_F(MemoryTrackerTest, StatsSamplerWhileAllocating)
+{
+    constexpr LinearAllocatorSettings settings = {.policy = LinearAllocatorPolicy::Default | LinearAllocatorPolicy::SizeTracking |
+                                                            LinearAllocatorPolicy::Multithreaded};
+
+    LinearAllocator<settings> linearAllocator{64_KiB};
+    MemoryTracker::StartSampling(std::chrono::microseconds(100), 8);
+
+    std::thread worker(
+        [&linearAllocator]()
+        {
+            for (int round = 0; round < 200; round++)
+            {
+                for (Size i = 0; i < 64_KiB / 64; i++)
+                {
+                    EXPECT_NE(linearAllocator.Allocate(64), nullptr);
+                }
+                linearAllocator.Release();
+            }
+        });
+
+    while (MemoryTracker::GetSampleHistory().size() < 8)
+    {
+        MemoryTracker::SampleStats();
+    }
+    worker.join();
+    MemoryTracker::StopSampling();
+
+    EXPECT_EQ(linearAllocator.GetUsedSize(), 0);
+    EXPECT_EQ(linearAllocator.GetPeakUsedSize(), 64_KiB);
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+using namespace Memarena;
+
+class ObjectCacheTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override { MemoryTracker::ResetAllocators(); }
+    void TearDown() override {}
+};
+
+struct ExpensiveObject
+{
+    static inline int constructions = 0;
+    static inline int destructions  = 0;
+
+    std::vector<int> buffer;
+    int              uses = 0;
+
+    explicit ExpensiveObject(const Size bufferSize) : buffer(bufferSize) { constructions++; }
+    ~ExpensiveObject() { destructions++; }
+
+    void Reset() { uses = 0; }
+};
+
+struct ObjectCounterReset
+{
+    int* resetCount;
+
+    void operator()(ExpensiveObject& object) const
+    {
+        object.uses = -1;
+        (*resetCount)++;
+    }
+};
+
+TEST_F(ObjectCacheTest, ReleasedObjectsStayConstructed)
+{
+    ExpensiveObject::constructions = 0;
+    ExpensiveObject::destructions  = 0;
+
+    ObjectCache<ExpensiveObject> objectCache{16};
+
+    ExpensiveObject* object = objectCache.Acquire(1024);
+    object->uses            = 5;
+    ExpensiveObject* cached = object;
+
+    objectCache.Release(object);
+
+    EXPECT_EQ(object, nullptr);
+    EXPECT_EQ(objectCache.GetCachedCount(), 1);
+    EXPECT_EQ(ExpensiveObject::destructions, 0);
+
+    // The released object is handed out again without running the constructor, only reset
+    ExpensiveObject* reused = objectCache.Acquire(1024);
+
+    EXPECT_EQ(reused, cached);
+    EXPECT_EQ(reused->uses, 0);
+    EXPECT_EQ(reused->buffer.size(), 1024);
+    EXPECT_EQ(ExpensiveObject::constructions, 1);
+    EXPECT_EQ(objectCache.GetAcquiredCount(), 1);
+    EXPECT_EQ(objectCache.GetCachedCount(), 0);
+
+    objectCache.Release(reused);
+}
+
+TEST_F(ObjectCacheTest, Trim)
+{
+    ExpensiveObject::constructions = 0;
+    ExpensiveObject::destructions  = 0;
+
+    constexpr PoolAllocatorSettings        settings = {.policy = PoolAllocatorPolicy::Default};
+    ObjectCache<ExpensiveObject, settings> objectCache{16};
+    std::vector<ExpensiveObject*>          objects;
+
+    for (int i = 0; i < 10; i++)
+    {
+        objects.push_back(objectCache.Acquire(64));
+    }
+
+    for (ExpensiveObject*& object : objects)
+    {
+        objectCache.Release(object);
+    }
+
+    EXPECT_EQ(objectCache.GetConstructedCount(), 10);
+    EXPECT_EQ(objectCache.GetUsedSize(), 10 * sizeof(ExpensiveObject));
+
+    objectCache.Trim(4);
+
+    EXPECT_EQ(objectCache.GetCachedCount(), 4);
+    EXPECT_EQ(objectCache.GetConstructedCount(), 4);
+    EXPECT_EQ(ExpensiveObject::destructions, 6);
+    EXPECT_EQ(objectCache.GetUsedSize(), 4 * sizeof(ExpensiveObject));
+
+    objectCache.Trim();
+
+    EXPECT_EQ(ExpensiveObject::destructions, 10);
+    EXPECT_EQ(objectCache.GetUsedSize(), 0);
+}
+
+TEST_F(ObjectCacheTest, DestructorDestroysCachedObjects)
+{
+    ExpensiveObject::constructions = 0;
+    ExpensiveObject::destructions  = 0;
+
+    {
+        ObjectCache<ExpensiveObject> objectCache{16};
+        ExpensiveObject*             object = objectCache.Acquire(64);
+        objectCache.Release(object);
+    }
+
+    EXPECT_EQ(ExpensiveObject::constructions, 1);
+    EXPECT_EQ(ExpensiveObject::destructions, 1);
+}
+
+TEST_F(ObjectCacheTest, CustomResetter)
+{
+    int resetCount = 0;
+
+    ObjectCache<ExpensiveObject, poolAllocatorDefaultSettings, ObjectCounterReset> objectCache{16, "ObjectCache",
+                                                                                             ObjectCounterReset{&resetCount}};
+
+    ExpensiveObject* object = objectCache.Acquire(64);
+    objectCache.Release(object);
+    object = objectCache.Acquire(64);
+
+    EXPECT_EQ(resetCount, 1);
+    EXPECT_EQ(object->uses, -1);
+
+    objectCache.Release(object);
+}
+
+TEST_F(ObjectCacheTest, TrimReleasesEmptyBlocks)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::Growable |
+                                                          PoolAllocatorPolicy::BlockLocalFreeLists};
+
+    ObjectCache<ExpensiveObject, settings> objectCache{4};
+    std::vector<ExpensiveObject*>          objects;
+
+    for (int i = 0; i < 12; i++)
+    {
+        objects.push_back(objectCache.Acquire(8));
+    }
+
+    EXPECT_EQ(objectCache.GetTotalSize(), 12 * sizeof(ExpensiveObject));
+
+    for (ExpensiveObject*& object : objects)
+    {
+        objectCache.Release(object);
+    }
+
+    objectCache.Trim();
+
+    EXPECT_EQ(objectCache.GetTotalSize(), 4 * sizeof(ExpensiveObject));
+}
+
+TEST_F(ObjectCacheTest, ObjectSmallerThanPointer)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default};
+
+    ObjectCache<int, settings> objectCache{4};
+
+    int* first  = objectCache.Acquire(1);
+    int* second = objectCache.Acquire(2);
+
+    EXPECT_EQ(*first, 1);
+    EXPECT_EQ(*second, 2);
+    EXPECT_EQ(objectCache.GetTotalSize(), 4 * sizeof(void*));
+
+    objectCache.Release(first);
+    int* reused = objectCache.Acquire(3);
+
+    // The cached object keeps its value, the arguments are only used for new objects
+    EXPECT_EQ(*reused, 1);
+
+    objectCache.Release(reused);
+    objectCache.Release(second);
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <iostream>
 #include <memory>
 #include <memory_resource>
@@ -355,6 +356,332 @@ TEST_F(PoolAllocatorTest, DoubleFreePrevention)
     EXPECT_EQ(ptr3, nullptr);
 }
 
+ALLOCATOR_TEST(NewDeleteArrayReuse, {
+    PoolArrayPtr<TestObject> arr = CheckNewArray<TestObject>(poolAllocator, 1000, 1, 2.1F, 'a', false, 10.6F);
+    poolAllocator.DeleteArray(arr);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        CheckNewRaw<TestObject>(poolAllocator, i, static_cast<float>(i) + 1.5F, 'a', i % 2, static_cast<float>(i) + 2.5F);
+    }
+})
+
+ALLOCATOR_TEST(SortFreeList, {
+    std::vector<TestObject*> objects;
+
+    for (int i = 0; i < 10; i++)
+    {
+        objects.push_back(CheckNewRaw<TestObject>(poolAllocator, i, 1.5F, 'a', false, 2.5F));
+    }
+
+    // Free the objects out of order so the free list gets scattered
+    for (int i : {7, 2, 9, 0, 4, 1, 8, 3, 6, 5})
+    {
+        TestObject* object = objects[i];
+        poolAllocator.Delete(object);
+    }
+
+    poolAllocator.SortFreeList();
+
+    std::vector<TestObject*> sortedObjects;
+
+    for (int i = 0; i < 10; i++)
+    {
+        sortedObjects.push_back(CheckNewRaw<TestObject>(poolAllocator, i, 1.5F, 'a', false, 2.5F));
+    }
+
+    EXPECT_TRUE(std::ranges::is_sorted(sortedObjects));
+    EXPECT_EQ(sortedObjects[0], objects[0]);
+})
+
+TEST_F(PoolAllocatorTest, SortFreeListMultipleBlocks)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::Growable};
+
+    PoolAllocator<settings>  poolAllocator{sizeof(TestObject), 4};
+    std::vector<TestObject*> objects;
+
+    for (int i = 0; i < 16; i++)
+    {
+        objects.push_back(poolAllocator.NewRaw<TestObject>(i, 1.5F, 'a', false, 2.5F));
+    }
+
+    for (int i : {13, 0, 6, 9, 3, 15, 4, 10})
+    {
+        TestObject* object = objects[i];
+        poolAllocator.Delete(object);
+    }
+
+    poolAllocator.SortFreeList();
+
+    std::vector<TestObject*> sortedObjects;
+
+    for (int i = 0; i < 8; i++)
+    {
+        sortedObjects.push_back(poolAllocator.NewRaw<TestObject>(i, 1.5F, 'a', false, 2.5F));
+    }
+
+    EXPECT_TRUE(std::ranges::is_sorted(sortedObjects));
+    EXPECT_EQ(poolAllocator.GetUsedSize(), 16 * sizeof(TestObject));
+    EXPECT_EQ(poolAllocator.GetTotalSize(), 16 * sizeof(TestObject));
+}
+
+TEST_F(PoolAllocatorTest, AddressOrderedNewArray)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::AddressOrdered};
+
+    PoolAllocator<settings>  poolAllocator{sizeof(TestObject), 10};
+    std::vector<TestObject*> objects;
+
+    for (int i = 0; i < 10; i++)
+    {
+        objects.push_back(poolAllocator.NewRaw<TestObject>(i, 1.5F, 'a', false, 2.5F));
+    }
+
+    for (int i : {0, 2, 4, 6, 8, 1, 3, 5, 7, 9})
+    {
+        TestObject* object = objects[i];
+        poolAllocator.Delete(object);
+    }
+
+    // The free list is not in address order anymore, so the array can only be found after sorting it
+    PoolArrayPtr<TestObject> arr = poolAllocator.NewArray<TestObject>(10, 1, 2.1F, 'a', false, 10.6F);
+
+    ASSERT_FALSE(arr.IsNullPtr());
+    EXPECT_EQ(arr.GetPtr(), objects[0]);
+    EXPECT_EQ(poolAllocator.GetUsedSize(), 10 * sizeof(TestObject));
+}
+
+TEST_F(PoolAllocatorTest, BlockLocalFreeListsFullestBlockFirst)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::Growable |
+                                                          PoolAllocatorPolicy::BlockLocalFreeLists};
+
+    PoolAllocator<settings>  poolAllocator{sizeof(TestObject), 4};
+    std::vector<TestObject*> objects;
+
+    for (int i = 0; i < 12; i++)
+    {
+        objects.push_back(poolAllocator.NewRaw<TestObject>(i, 1.5F, 'a', false, 2.5F));
+    }
+
+    EXPECT_EQ(poolAllocator.GetBlockCount(), 3);
+
+    // Leave one object in the first block, three in the second and two in the third
+    for (int i : {0, 1, 2, 4, 8, 9})
+    {
+        TestObject* object = objects[i];
+        poolAllocator.Delete(object);
+    }
+
+    // The second block is the fullest one that is not full, after it is filled the third block follows
+    TestObject* first  = poolAllocator.NewRaw<TestObject>(1, 1.5F, 'a', false, 2.5F);
+    TestObject* second = poolAllocator.NewRaw<TestObject>(2, 1.5F, 'a', false, 2.5F);
+    TestObject* third  = poolAllocator.NewRaw<TestObject>(3, 1.5F, 'a', false, 2.5F);
+
+    EXPECT_EQ(first, objects[4]);
+    EXPECT_TRUE(second == objects[8] || second == objects[9]);
+    EXPECT_TRUE(third == objects[8] || third == objects[9]);
+    EXPECT_NE(second, third);
+    EXPECT_EQ(poolAllocator.GetUsedSize(), 9 * sizeof(TestObject));
+}
+
+TEST_F(PoolAllocatorTest, BlockLocalFreeListsReleaseEmptyBlocks)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::Growable |
+                                                          PoolAllocatorPolicy::BlockLocalFreeLists};
+
+    PoolAllocator<settings>  poolAllocator{sizeof(TestObject), 4};
+    std::vector<TestObject*> objects;
+
+    for (int i = 0; i < 12; i++)
+    {
+        objects.push_back(poolAllocator.NewRaw<TestObject>(i, 1.5F, 'a', false, 2.5F));
+    }
+
+    // Drain the first and the third block completely
+    for (int i : {3, 0, 9, 1, 11, 2, 8, 10})
+    {
+        TestObject* object = objects[i];
+        poolAllocator.Delete(object);
+    }
+
+    poolAllocator.ReleaseEmptyBlocks();
+
+    EXPECT_EQ(poolAllocator.GetBlockCount(), 1);
+    EXPECT_EQ(poolAllocator.GetTotalSize(), 4 * sizeof(TestObject));
+    EXPECT_EQ(poolAllocator.GetUsedSize(), 4 * sizeof(TestObject));
+    EXPECT_TRUE(poolAllocator.Owns(objects[5]));
+    EXPECT_FALSE(poolAllocator.Owns(objects[0]));
+
+    // The pool grows again once the remaining block is full
+    TestObject*              object = poolAllocator.NewRaw<TestObject>(1, 1.5F, 'a', false, 2.5F);
+    PoolArrayPtr<TestObject> arr    = poolAllocator.NewArray<TestObject>(3, 1, 2.1F, 'a', false, 10.6F);
+
+    ASSERT_FALSE(arr.IsNullPtr());
+    EXPECT_EQ(poolAllocator.GetBlockCount(), 2);
+    EXPECT_EQ(poolAllocator.GetUsedSize(), 8 * sizeof(TestObject));
+
+    poolAllocator.Delete(object);
+    poolAllocator.DeleteArray(arr);
+}
+
+TEST_F(PoolAllocatorTest, ReleaseEmptyBlocksWithStackParent)
+{
+    constexpr PoolAllocatorSettings  settings      = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::Growable |
+                                                                PoolAllocatorPolicy::BlockLocalFreeLists};
+    constexpr StackAllocatorSettings stackSettings = {.policy = StackAllocatorPolicy::Default, .breakOnFailureIsEnabled = false};
+
+    StackAllocator<stackSettings> stackAllocator{16_KB, "StackParent"};
+    {
+        auto poolAllocator = CreateChildArena<PoolAllocator<settings, SharedBase>>(stackAllocator, sizeof(TestObject), 4, "PoolChild");
+
+        const Size oneBlockSize = stackAllocator.GetUsedSize();
+
+        std::vector<TestObject*> objects;
+        for (int i = 0; i < 12; i++)
+        {
+            objects.push_back(poolAllocator->NewRaw<TestObject>(i, 1.5F, 'a', false, 2.5F));
+        }
+        const Size threeBlockSize = stackAllocator.GetUsedSize();
+
+        // Drain the first and the third block, the first one stays until the second one is empty too
+        for (int i : {0, 1, 2, 3, 8, 9, 10, 11})
+        {
+            TestObject* object = objects[i];
+            poolAllocator->Delete(object);
+        }
+
+        poolAllocator->ReleaseEmptyBlocks();
+
+        EXPECT_EQ(poolAllocator->GetBlockCount(), 2);
+        EXPECT_LT(stackAllocator.GetUsedSize(), threeBlockSize);
+        EXPECT_TRUE(poolAllocator->Owns(objects[0]));
+        EXPECT_FALSE(poolAllocator->Owns(objects[8]));
+
+        for (int i : {4, 5, 6, 7})
+        {
+            TestObject* object = objects[i];
+            poolAllocator->Delete(object);
+        }
+
+        poolAllocator->ReleaseEmptyBlocks();
+
+        EXPECT_EQ(poolAllocator->GetBlockCount(), 1);
+        EXPECT_EQ(stackAllocator.GetUsedSize(), oneBlockSize);
+    }
+    EXPECT_EQ(stackAllocator.GetUsedSize(), 0);
+}
+
+ALLOCATOR_TEST(Release, {
+    for (int i = 0; i < 10; i++)
+    {
+        CheckNewRaw<TestObject>(poolAllocator, i, 1.5F, 'a', false, 2.5F);
+    }
+
+    poolAllocator.Release();
+
+    EXPECT_EQ(poolAllocator.GetBlockCount(), 1);
+
+    PoolArrayPtr<TestObject> arr = CheckNewArray<TestObject>(poolAllocator, 1000, 1, 2.1F, 'a', false, 10.6F);
+    EXPECT_FALSE(arr.IsNullPtr());
+})
+
+TEST_F(PoolAllocatorTest, ChildArena)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default};
+    PoolAllocator<settings>         pageAllocator{1_KB, 16, "PageAllocator"};
+    {
+        // Blocks larger than a chunk take consecutive chunks
+        auto smallChild = CreateChildArena<LinearAllocator<linearAllocatorDefaultSettings, SharedBase>>(pageAllocator, 1_KB, "SmallChild");
+        auto largeChild = CreateChildArena<LinearAllocator<linearAllocatorDefaultSettings, SharedBase>>(pageAllocator, 3_KB, "LargeChild");
+
+        int* num = static_cast<int*>(largeChild->Allocate<int>("Testing/PoolAllocator"));
+        EXPECT_TRUE(pageAllocator.Owns(num));
+        EXPECT_EQ(pageAllocator.GetUsedSize(), 4_KB);
+    }
+    EXPECT_EQ(pageAllocator.GetUsedSize(), 0);
+}
+
+TEST_F(PoolAllocatorTest, ChildArenaExhaustsParent)
+{
+    constexpr StackAllocatorSettings stackSettings = {.policy = StackAllocatorPolicy::Default, .breakOnFailureIsEnabled = false};
+    constexpr PoolAllocatorSettings  settings      = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::Growable,
+                                                      .breakOnFailureIsEnabled = false};
+
+    StackAllocator<stackSettings> parentAllocator{1_KiB, "Parent"};
+    {
+        auto childAllocator = CreateChildArena<PoolAllocator<settings, SharedBase>>(parentAllocator, sizeof(TestObject), 4, "Child");
+
+        std::vector<TestObject*> objects;
+        for (int i = 0; i < 100; i++)
+        {
+            TestObject* object = childAllocator->NewRaw<TestObject>(i, 1.5F, 'a', false, 2.5F);
+            if (object == nullptr)
+            {
+                break;
+            }
+            objects.push_back(object);
+        }
+
+        EXPECT_GT(objects.size(), 4);
+        EXPECT_LT(objects.size(), 100);
+        EXPECT_EQ(objects.size(), childAllocator->GetBlockCount() * 4);
+        EXPECT_TRUE(childAllocator->NewArray<TestObject>(2, 1, 2.1F, 'a', false, 10.6F).IsNullPtr());
+
+        // Freed objects are handed out again without a new block
+        childAllocator->Delete(objects.back());
+        objects.pop_back();
+        objects.push_back(childAllocator->NewRaw<TestObject>(1, 1.5F, 'a', false, 2.5F));
+        EXPECT_NE(objects.back(), nullptr);
+
+        for (TestObject* object : objects)
+        {
+            childAllocator->Delete(object);
+        }
+    }
+    EXPECT_EQ(parentAllocator.GetUsedSize(), 0);
+}
+
+TEST_F(PoolAllocatorTest, AdaptiveBlockSize)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = PoolAllocatorPolicy::Default | PoolAllocatorPolicy::Growable |
+                                                          PoolAllocatorPolicy::AdaptiveBlockSize};
+
+    PoolAllocator<settings> poolAllocator{sizeof(TestObject), 8, BlockSizeBounds{.minSize = 4, .maxSize = 4096}};
+
+    for (int i = 0; i < 1000; i++)
+    {
+        EXPECT_NE(poolAllocator.NewRaw<TestObject>(i, 1.5F, 'a', false, 2.5F), nullptr);
+    }
+
+    // How far the blocks grow depends on the timing, the kept block only on the peak number of objects
+    EXPECT_EQ(poolAllocator.GetUsedSize(), 1000 * sizeof(TestObject));
+
+    // The kept block fits the peak number of objects of the last cycle
+    poolAllocator.Release();
+
+    EXPECT_EQ(poolAllocator.GetBlockCount(), 1);
+    EXPECT_EQ(poolAllocator.GetObjectsPerBlock(0), 1024);
+    EXPECT_EQ(poolAllocator.GetTotalSize(), 1024 * sizeof(TestObject));
+    EXPECT_EQ(poolAllocator.GetUsedSize(), 0);
+
+    // Arrays larger than the current block size get a block that fits them
+    PoolArrayPtr<TestObject> arr = poolAllocator.NewArray<TestObject>(2000, 1, 2.1F, 'a', false, 10.6F);
+    ASSERT_FALSE(arr.IsNullPtr());
+    EXPECT_EQ(poolAllocator.GetBlockCount(), 2);
+    EXPECT_GE(poolAllocator.GetObjectsPerBlock(1), 2000);
+    poolAllocator.DeleteArray(arr);
+
+    // A quiet cycle shrinks the block again
+    poolAllocator.Release();
+    TestObject* object = poolAllocator.NewRaw<TestObject>(1, 1.5F, 'a', false, 2.5F);
+    poolAllocator.Delete(object);
+    poolAllocator.Release();
+
+    EXPECT_EQ(poolAllocator.GetObjectsPerBlock(0), 4);
+}
+
 #ifdef MEMARENA_ENABLE_ASSERTS
 
 class PoolAllocatorDeathTest : public ::testing::Test
@@ -398,6 +398,71 @@ TEST_F(StackAllocatorTest, Release)
     }
 }
 
+TEST_F(StackAllocatorTest, BumpDown)
+{
+    constexpr StackAllocatorSettings settings = {.policy = StackAllocatorPolicy::Default | StackAllocatorPolicy::BumpDown};
+    StackAllocator<settings>         stackAllocator{1_KiB};
+
+    StackPtr<TestObject>      first  = stackAllocator.New<TestObject>(1, 1.5F, 'a', false, 2.5F);
+    StackArrayPtr<TestObject> second = stackAllocator.NewArray<TestObject>(3, 2, 1.5F, 'b', false, 2.5F);
+    TestObject*               third  = stackAllocator.NewRaw<TestObject>(3, 1.5F, 'c', false, 2.5F);
+    TestObject*               fourth = stackAllocator.NewArrayRaw<TestObject>(2, 4, 1.5F, 'd', false, 2.5F);
+
+    // The stack grows downwards
+    EXPECT_LT(std::bit_cast<UIntPtr>(second.GetPtr()), std::bit_cast<UIntPtr>(first.GetPtr()));
+    EXPECT_LT(std::bit_cast<UIntPtr>(third), std::bit_cast<UIntPtr>(second.GetPtr()));
+    EXPECT_LT(std::bit_cast<UIntPtr>(fourth), std::bit_cast<UIntPtr>(third));
+    EXPECT_EQ(std::bit_cast<UIntPtr>(fourth) % alignof(TestObject), 0);
+
+    EXPECT_EQ(*first, TestObject(1, 1.5F, 'a', false, 2.5F));
+    EXPECT_EQ(second[2], TestObject(2, 1.5F, 'b', false, 2.5F));
+    EXPECT_EQ(*third, TestObject(3, 1.5F, 'c', false, 2.5F));
+    EXPECT_EQ(fourth[1], TestObject(4, 1.5F, 'd', false, 2.5F));
+
+    const TestObject* top = first.GetPtr();
+
+    // Deallocating in reverse order passes the stack check and frees everything
+    stackAllocator.DeleteArray(fourth);
+    stackAllocator.Delete(third);
+    stackAllocator.DeleteArray(second);
+    stackAllocator.Delete(first);
+    EXPECT_EQ(stackAllocator.GetUsedSize(), 0);
+
+    // The header of a raw allocation goes below it, so it starts at the top like the first allocation did
+    TestObject* reused = stackAllocator.NewRaw<TestObject>(5, 1.5F, 'e', false, 2.5F);
+    EXPECT_EQ(reused, top);
+}
+
+TEST_F(StackAllocatorTest, OffsetWidths)
+{
+    constexpr StackAllocatorSettings compactSettings = {.policy = StackAllocatorPolicy::Default | StackAllocatorPolicy::CompactOffsets};
+    constexpr StackAllocatorSettings defaultSettings = {.policy = StackAllocatorPolicy::Default};
+    constexpr StackAllocatorSettings wideSettings    = {.policy = StackAllocatorPolicy::Default | StackAllocatorPolicy::WideOffsets};
+
+    StackAllocator<compactSettings> compactAllocator{60_KiB};
+    StackAllocator<defaultSettings> defaultAllocator{60_KiB};
+    StackAllocator<wideSettings>    wideAllocator{60_KiB};
+
+    // The in-place headers hold a start and an end offset
+    void* compactPtr = compactAllocator.Allocate(16, 1);
+    void* defaultPtr = defaultAllocator.Allocate(16, 1);
+    void* widePtr    = wideAllocator.Allocate(16, 1);
+    EXPECT_EQ(compactAllocator.GetUsedSize(), 16 + 2 * sizeof(UInt16));
+    EXPECT_EQ(defaultAllocator.GetUsedSize(), 16 + 2 * sizeof(UInt32));
+    EXPECT_EQ(wideAllocator.GetUsedSize(), 16 + 2 * sizeof(UInt64));
+
+    StackAllocator<compactSettings>::PtrType<TestObject> object = compactAllocator.New<TestObject>(1, 1.5F, 'a', false, 2.5F);
+    EXPECT_EQ(*object, TestObject(1, 1.5F, 'a', false, 2.5F));
+
+    compactAllocator.Delete(object);
+    compactAllocator.Deallocate(compactPtr);
+    defaultAllocator.Deallocate(defaultPtr);
+    wideAllocator.Deallocate(widePtr);
+    EXPECT_EQ(compactAllocator.GetUsedSize(), 0);
+    EXPECT_EQ(defaultAllocator.GetUsedSize(), 0);
+    EXPECT_EQ(wideAllocator.GetUsedSize(), 0);
+}
+
 TEST_F(StackAllocatorTest, GetUsedSizeNew)
 {
     constexpr StackAllocatorSettings settings = {.policy = StackAllocatorPolicy::Default};
@@ -459,7 +524,7 @@ TEST_F(StackAllocatorTest, MemoryTracker)
 
     const AllocatorVector allocators = MemoryTracker::GetAllocators();
 
-    const Size size = sizeof(int) + sizeof(Internal::StackHeader) + sizeof(BoundGuardFront) + sizeof(BoundGuardBack);
+    const Size size = sizeof(int) + sizeof(Internal::StackHeader<>) + sizeof(BoundGuardFront) + sizeof(BoundGuardBack);
 
     EXPECT_EQ(allocators.size(), 1);
     if (allocators.size() > 0)
@@ -478,18 +543,69 @@ ALLOCATOR_DEBUG_TEST(DefaultBaseAllocator, {
     EXPECT_EQ(Allocator::GetDefaultAllocator()->GetTotalSize(), 1_MB);
 })
 
+TEST_F(StackAllocatorTest, SharedBaseAllocator)
+{
+    constexpr StackAllocatorSettings     settings = {.policy = StackAllocatorPolicy::Default};
+    StackAllocator<settings, SharedBase> stackAllocator{1_MB};
+
+    int* num = static_cast<int*>(stackAllocator.Allocate<int>("Testing/StackAllocator"));
+    EXPECT_NE(num, nullptr);
+    EXPECT_EQ(Allocator::GetDefaultAllocator()->GetTotalSize(), 1_MB);
+
+    // The stateless default base allocator takes up no space
+    static_assert(sizeof(StackAllocator<settings>) < sizeof(StackAllocator<settings, SharedBase>));
+}
+
 TEST_F(StackAllocatorTest, CustomBaseAllocator)
 {
     constexpr MallocatorSettings mallocatorSettings = {.policy = MallocatorPolicy::Default};
     auto                         baseAllocator      = std::make_shared<Mallocator<mallocatorSettings>>("Mallocator");
 
-    constexpr StackAllocatorSettings settings = {.policy = StackAllocatorPolicy::Default};
-    StackAllocator<settings>         stackAllocator{1_MB, "TestAllocator", baseAllocator};
+    constexpr StackAllocatorSettings     settings = {.policy = StackAllocatorPolicy::Default};
+    StackAllocator<settings, SharedBase> stackAllocator{1_MB, "TestAllocator", baseAllocator};
 
     int* num = static_cast<int*>(stackAllocator.Allocate<int>("Testing/StackAllocator"));
     EXPECT_EQ(baseAllocator->GetTotalSize(), 1_MB);
 }
 
+TEST_F(StackAllocatorTest, ChildArena)
+{
+    constexpr StackAllocatorSettings settings = {.policy = StackAllocatorPolicy::Default};
+    StackAllocator<settings>         parentAllocator{64_KB, "ParentAllocator"};
+    {
+        using ChildAllocator = StackAllocator<stackAllocatorDefaultSettings, SharedBase>;
+
+        auto firstChild  = CreateChildArena<ChildAllocator>(parentAllocator, 4_KB, "FirstChild");
+        auto secondChild = CreateChildArena<ChildAllocator>(parentAllocator, 4_KB, "SecondChild");
+
+        int* num = static_cast<int*>(secondChild->Allocate<int>("Testing/StackAllocator"));
+        EXPECT_TRUE(parentAllocator.Owns(num));
+        EXPECT_GE(parentAllocator.GetUsedSize(), 8_KB);
+
+        // Resetting in reverse order of creation keeps the parent's deallocations in LIFO order
+        secondChild.reset();
+        firstChild.reset();
+    }
+    EXPECT_EQ(parentAllocator.GetUsedSize(), 0);
+}
+
+TEST_F(StackAllocatorTest, ChildArenaExhaustsParent)
+{
+    constexpr StackAllocatorSettings settings = {.policy = StackAllocatorPolicy::Default, .breakOnFailureIsEnabled = false};
+
+    StackAllocator<settings> parentAllocator{1_KiB, "Parent"};
+    {
+        auto firstChild  = CreateChildArena<StackAllocator<settings, SharedBase>>(parentAllocator, 768, "FirstChild");
+        auto secondChild = CreateChildArena<StackAllocator<settings, SharedBase>>(parentAllocator, 768, "SecondChild");
+
+        // The second child got no memory, so it has no room instead of handing out addresses it doesn't own
+        EXPECT_NE(firstChild->Allocate(16), nullptr);
+        EXPECT_EQ(secondChild->GetTotalSize(), 0);
+        EXPECT_EQ(secondChild->Allocate(16), nullptr);
+    }
+    EXPECT_EQ(parentAllocator.GetUsedSize(), 0);
+}
+
 TEST_F(StackAllocatorTest, DoubleFreePreventionDisabled)
 {
     constexpr StackAllocatorSettings settings = {.policy = StackAllocatorPolicy::Default & ~StackAllocatorPolicy::DoubleFreePrevention};
@@ -539,6 +655,13 @@ TEST_F(StackAllocatorDeathTest, MaxSizeAllocation)
     ASSERT_DEATH({ StackAllocator stackAllocator{Size(std::numeric_limits<Offset>::max()) + 1}; }, ".*");
 }
 
+TEST_F(StackAllocatorDeathTest, CompactOffsetsMaxSize)
+{
+    constexpr StackAllocatorSettings settings = {.policy = StackAllocatorPolicy::Default | StackAllocatorPolicy::CompactOffsets};
+
+    ASSERT_DEATH({ StackAllocator<settings> stackAllocator{64_KiB}; }, ".*");
+}
+
 TEST_F(StackAllocatorDeathTest, NewOutOfMemory)
 {
     StackAllocator stackAllocator2{10};
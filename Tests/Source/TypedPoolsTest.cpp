@@ -0,0 +1,249 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+#include "MemoryTestObjects.hpp"
+
+using namespace Memarena;
+
+class TypedPoolsTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override { MemoryTracker::ResetAllocators(); }
+    void TearDown() override {}
+};
+
+struct SmallNode
+{
+    char value;
+};
+
+struct TreeNode
+{
+    TreeNode* left;
+    TreeNode* right;
+    int       key;
+};
+
+TEST_F(TypedPoolsTest, PoolsAreCreatedOnFirstUse)
+{
+    TypedPools<> typedPools{64};
+
+    EXPECT_EQ(typedPools.GetPoolCount(), 0);
+    EXPECT_FALSE(typedPools.HasPool<TestObject>());
+
+    TestObject* object = typedPools.New<TestObject>(1, 1.5F, 'a', false, 2.5F);
+    TreeNode*   node   = typedPools.New<TreeNode>(nullptr, nullptr, 5);
+
+    EXPECT_EQ(*object, TestObject(1, 1.5F, 'a', false, 2.5F));
+    EXPECT_EQ(node->key, 5);
+    EXPECT_EQ(typedPools.GetPoolCount(), 2);
+    EXPECT_TRUE(typedPools.GetPool<TestObject>().Owns(object));
+    EXPECT_FALSE(typedPools.GetPool<TestObject>().Owns(node));
+    EXPECT_EQ(typedPools.GetPool<TreeNode>().GetDebugName(), "TypedPools/TreeNode");
+
+    typedPools.Delete(object);
+    typedPools.Delete(node);
+
+    EXPECT_EQ(object, nullptr);
+    EXPECT_EQ(typedPools.GetUsedSize(), 0);
+}
+
+TEST_F(TypedPoolsTest, SmallTypes)
+{
+    TypedPools<> typedPools{64};
+
+    SmallNode* first  = typedPools.New<SmallNode>('a');
+    SmallNode* second = typedPools.New<SmallNode>('b');
+
+    EXPECT_EQ(first->value, 'a');
+    EXPECT_EQ(second->value, 'b');
+    EXPECT_EQ(typedPools.GetStats<SmallNode>().objectSize, sizeof(void*));
+}
+
+TEST_F(TypedPoolsTest, Stats)
+{
+    TypedPools<> typedPools{4};
+
+    typedPools.CreatePool<TreeNode>(16);
+
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_NE(typedPools.New<TreeNode>(nullptr, nullptr, i), nullptr);
+        EXPECT_NE(typedPools.New<TestObject>(i, 1.5F, 'a', false, 2.5F), nullptr);
+    }
+
+    const TypedPoolStats treeNodeStats   = typedPools.GetStats<TreeNode>();
+    const TypedPoolStats testObjectStats = typedPools.GetStats<TestObject>();
+
+    EXPECT_EQ(treeNodeStats.objectSize, sizeof(TreeNode));
+    EXPECT_EQ(treeNodeStats.blockCount, 1);
+    EXPECT_EQ(treeNodeStats.usedSize, 10 * sizeof(TreeNode));
+    EXPECT_EQ(treeNodeStats.totalSize, 16 * sizeof(TreeNode));
+    EXPECT_GT(testObjectStats.blockCount, 1);
+    EXPECT_EQ(testObjectStats.usedSize, 10 * sizeof(TestObject));
+    EXPECT_EQ(typedPools.GetStats<SmallNode>().blockCount, 0);
+}
+
+TEST_F(TypedPoolsTest, CreateExistingPool)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = typedPoolsDefaultSettings.policy, .breakOnFailureIsEnabled = false};
+
+    TypedPools<settings> typedPools{4};
+
+    TreeNode* node = typedPools.New<TreeNode>(nullptr, nullptr, 1);
+
+    // The existing pool is kept with its objects
+    auto& pool = typedPools.CreatePool<TreeNode>(16);
+
+    EXPECT_EQ(&pool, &typedPools.GetPool<TreeNode>());
+    EXPECT_TRUE(pool.Owns(node));
+    EXPECT_EQ(typedPools.GetStats<TreeNode>().usedSize, sizeof(TreeNode));
+    EXPECT_EQ(typedPools.GetStats<TreeNode>().totalSize, 4 * sizeof(TreeNode));
+
+    typedPools.Delete(node);
+}
+
+TEST_F(TypedPoolsTest, ReleaseAll)
+{
+    TypedPools<> typedPools{4};
+
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_NE(typedPools.New<TreeNode>(nullptr, nullptr, i), nullptr);
+        EXPECT_NE(typedPools.New<TestObject>(i, 1.5F, 'a', false, 2.5F), nullptr);
+    }
+
+    typedPools.ReleaseAll();
+
+    EXPECT_EQ(typedPools.GetUsedSize(), 0);
+    EXPECT_EQ(typedPools.GetStats<TreeNode>().blockCount, 1);
+    EXPECT_EQ(typedPools.GetStats<TestObject>().blockCount, 1);
+
+    TreeNode* node = typedPools.New<TreeNode>(nullptr, nullptr, 1);
+    EXPECT_EQ(node->key, 1);
+}
+
+TEST_F(TypedPoolsTest, RegistriesAreIndependent)
+{
+    TypedPools<> first{4};
+    TypedPools<> second{4};
+
+    TreeNode* node = first.New<TreeNode>(nullptr, nullptr, 1);
+
+    EXPECT_TRUE(first.HasPool<TreeNode>());
+    EXPECT_FALSE(second.HasPool<TreeNode>());
+    EXPECT_FALSE(second.GetPool<TreeNode>().Owns(node));
+}
+
+TEST_F(TypedPoolsTest, DeleteWithoutPool)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = typedPoolsDefaultSettings.policy, .breakOnFailureIsEnabled = false};
+
+    TypedPools<settings> first{4};
+    TypedPools<settings> second{4};
+
+    TreeNode* node = first.New<TreeNode>(nullptr, nullptr, 1);
+
+    // The object doesn't come from the second registry, which doesn't create a pool for it
+    second.Delete(node);
+
+    EXPECT_NE(node, nullptr);
+    EXPECT_FALSE(second.HasPool<TreeNode>());
+    EXPECT_EQ(first.GetUsedSize(), sizeof(TreeNode));
+
+    first.Delete(node);
+    EXPECT_EQ(node, nullptr);
+}
+
+TEST_F(TypedPoolsTest, DeleteNullPointer)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = typedPoolsDefaultSettings.policy, .breakOnFailureIsEnabled = false};
+
+    TypedPools<settings> typedPools{4};
+
+    TreeNode* node  = typedPools.New<TreeNode>(nullptr, nullptr, 1);
+    TreeNode* empty = nullptr;
+
+    typedPools.Delete(empty);
+
+    EXPECT_EQ(typedPools.GetUsedSize(), sizeof(TreeNode));
+
+    typedPools.Delete(node);
+}
+
+template <Size Index>
+struct TaggedNode
+{
+    Size value;
+};
+
+TEST_F(TypedPoolsTest, StatsWhileCreatingPools)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = typedPoolsDefaultSettings.policy | PoolAllocatorPolicy::Multithreaded};
+    constexpr Size                  typeCount = 64;
+
+    TypedPools<settings> typedPools{4};
+    std::atomic<bool>    isDone = false;
+
+    // Every new type grows the pool table while the stats are read
+    std::thread creator([&] {
+        const bool allocated = [&]<Size... Indices>(std::index_sequence<Indices...>) {
+            return ((typedPools.New<TaggedNode<Indices>>(Indices) != nullptr) && ...);
+        }(std::make_index_sequence<typeCount>());
+        EXPECT_TRUE(allocated);
+        isDone = true;
+    });
+
+    while (!isDone)
+    {
+        EXPECT_LE(typedPools.GetPoolCount(), typeCount);
+        // The total only grows, so it is read after the used size
+        const Size usedSize = typedPools.GetUsedSize();
+        EXPECT_LE(usedSize, typedPools.GetTotalSize());
+        EXPECT_LE(typedPools.GetStats<TaggedNode<typeCount - 1>>().usedSize, sizeof(TaggedNode<0>));
+    }
+    creator.join();
+
+    EXPECT_EQ(typedPools.GetPoolCount(), typeCount);
+    EXPECT_EQ(typedPools.GetUsedSize(), typeCount * sizeof(TaggedNode<0>));
+}
+
+TEST_F(TypedPoolsTest, ConcurrentFirstUse)
+{
+    constexpr PoolAllocatorSettings settings = {.policy = typedPoolsDefaultSettings.policy | PoolAllocatorPolicy::Multithreaded};
+    constexpr Size                  typeCount   = 32;
+    constexpr Size                  threadCount = 4;
+
+    TypedPools<settings> typedPools{4};
+
+    // Every thread races the others to create the same pools, then finds them without the lock
+    std::vector<std::thread> threads;
+    for (Size thread = 0; thread < threadCount; thread++)
+    {
+        threads.emplace_back([&] {
+            [&]<Size... Indices>(std::index_sequence<Indices...>) {
+                (
+                    [&] {
+                        auto* node = typedPools.New<TaggedNode<Indices>>(Indices);
+                        ASSERT_NE(node, nullptr);
+                        EXPECT_EQ(node->value, Indices);
+                        typedPools.Delete(node);
+                    }(),
+                    ...);
+            }(std::make_index_sequence<typeCount>());
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    EXPECT_EQ(typedPools.GetPoolCount(), typeCount);
+    EXPECT_EQ(typedPools.GetUsedSize(), 0);
+}
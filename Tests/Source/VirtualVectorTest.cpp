@@ -0,0 +1,143 @@
+#include <gtest/gtest.h>
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Memarena/Memarena.hpp>
+
+using namespace Memarena;
+using namespace Memarena::SizeLiterals;
+
+class VirtualVectorTest : public ::testing::Test
+{
+  protected:
+    void SetUp() override { MemoryTracker::ResetAllocators(); }
+    void TearDown() override {}
+};
+
+constexpr VirtualVectorSettings checkedSettings = {.policy = VirtualVectorPolicy::BoundsCheck, .breakOnFailureIsEnabled = false};
+
+TEST_F(VirtualVectorTest, AddressesStayStable)
+{
+    VirtualVector<UInt64> vector{1'000'000, 4_KiB};
+
+    const UInt64* first = vector.PushBack(0);
+    ASSERT_NE(first, nullptr);
+
+    std::vector<const UInt64*> addresses = {first};
+    for (UInt64 i = 1; i < 100'000; i++)
+    {
+        addresses.push_back(vector.PushBack(i));
+    }
+
+    ASSERT_EQ(vector.GetCount(), 100'000);
+    for (Size i = 0; i < addresses.size(); i++)
+    {
+        EXPECT_EQ(addresses[i], &vector[i]);
+        EXPECT_EQ(vector[i], i);
+    }
+    EXPECT_EQ(vector.GetData(), first);
+}
+
+TEST_F(VirtualVectorTest, CommitsInSteps)
+{
+    VirtualVector<UInt64> vector{1'000'000, 64_KiB};
+
+    EXPECT_GE(vector.GetReservedSize(), 1'000'000 * sizeof(UInt64));
+    EXPECT_EQ(vector.GetCommittedSize(), 0);
+
+    vector.PushBack(1);
+    EXPECT_EQ(vector.GetCommittedSize(), 64_KiB);
+
+    ASSERT_TRUE(vector.Resize(64_KiB / sizeof(UInt64) + 1));
+    EXPECT_EQ(vector.GetCommittedSize(), 128_KiB);
+
+    ASSERT_TRUE(vector.Reserve(300_KiB / sizeof(UInt64)));
+    EXPECT_EQ(vector.GetCommittedSize(), 320_KiB);
+    EXPECT_EQ(vector.GetCount(), 64_KiB / sizeof(UInt64) + 1);
+
+    // The pages of the commit step the last element is in are kept
+    vector.ShrinkToFit();
+    EXPECT_EQ(vector.GetCommittedSize(), 128_KiB);
+
+    vector.Clear();
+    EXPECT_TRUE(vector.IsEmpty());
+    EXPECT_EQ(vector.GetCommittedSize(), 128_KiB);
+
+    vector.ShrinkToFit();
+    EXPECT_EQ(vector.GetCommittedSize(), 0);
+
+    // Decommitted pages are committed again on growth
+    ASSERT_NE(vector.PushBack(2), nullptr);
+    EXPECT_EQ(vector.Front(), 2);
+}
+
+TEST_F(VirtualVectorTest, FullVector)
+{
+    VirtualVector<UInt32, checkedSettings> vector{3};
+
+    for (UInt32 i = 0; i < 3; i++)
+    {
+        EXPECT_NE(vector.PushBack(i), nullptr);
+    }
+    EXPECT_EQ(vector.GetCount(), vector.GetMaxCount());
+
+    EXPECT_EQ(vector.PushBack(3), nullptr);
+    EXPECT_FALSE(vector.Resize(4));
+    EXPECT_EQ(vector.GetCount(), 3);
+    EXPECT_EQ(vector.Back(), 2);
+}
+
+TEST_F(VirtualVectorTest, MaxCountPastTheAddressSpace)
+{
+    VirtualVector<UInt64, checkedSettings> vector{std::numeric_limits<Size>::max() / 4};
+
+    // Nothing is reserved instead of a size that wrapped around
+    EXPECT_EQ(vector.GetReservedSize(), 0);
+    EXPECT_EQ(vector.GetMaxCount(), 0);
+    EXPECT_EQ(vector.PushBack(1), nullptr);
+    EXPECT_TRUE(vector.IsEmpty());
+}
+
+TEST_F(VirtualVectorTest, ConstructsAndDestroysElements)
+{
+    const auto counter = std::make_shared<int>(0);
+
+    {
+        VirtualVector<std::shared_ptr<int>> vector{1000};
+        for (int i = 0; i < 10; i++)
+        {
+            vector.PushBack(counter);
+        }
+        EXPECT_EQ(counter.use_count(), 11);
+
+        vector.PopBack();
+        EXPECT_EQ(counter.use_count(), 10);
+
+        ASSERT_TRUE(vector.Resize(20));
+        EXPECT_EQ(vector.Back(), nullptr);
+
+        ASSERT_TRUE(vector.Resize(5));
+        EXPECT_EQ(counter.use_count(), 6);
+    }
+
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST_F(VirtualVectorTest, Iteration)
+{
+    VirtualVector<std::string> vector{16};
+
+    vector.EmplaceBack(3, 'a');
+    vector.EmplaceBack("b");
+    vector.PushBack(std::string("c"));
+
+    std::string joined;
+    for (const std::string& text : vector)
+    {
+        joined += text;
+    }
+    EXPECT_EQ(joined, "aaabc");
+}